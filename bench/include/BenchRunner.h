@@ -0,0 +1,199 @@
+//
+//  BenchRunner.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef BENCH_INCLUDE_BENCHRUNNER_H_
+#define BENCH_INCLUDE_BENCHRUNNER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "datastructure/perf/perfcounters.h"
+
+/** Minimum number of items visited per measurement */
+#define BENCH_MIN_ITEMS (1 << 24)
+
+/** Written by benchmarks so that measured work is not optimized away */
+static volatile uintptr_t bench_sink;
+
+/**
+ *  Monotonic clock
+ *
+ *  \return Time in nanoseconds
+ */
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ *  Number of times a workload over "items" items must be repeated to visit
+ *  at least BENCH_MIN_ITEMS items.
+ */
+static inline uint64_t bench_rounds(uint64_t items) {
+    return items >= BENCH_MIN_ITEMS ? 1 : (BENCH_MIN_ITEMS + items - 1) / items;
+}
+
+/**
+ *  Shuffles an array of pointers (Fisher-Yates, xorshift64 generator)
+ *
+ *  \param items Array
+ *  \param count Number of items
+ *  \param seed Non zero seed
+ */
+static inline void bench_shuffle(void** items, size_t count, uint64_t seed) {
+    for (size_t i = count; i > 1; i--) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        size_t j = (size_t) (seed % i);
+        void* tmp = items[i - 1];
+        items[i - 1] = items[j];
+        items[j] = tmp;
+    }
+}
+
+/**
+ *  Prints a measurement
+ *
+ *  \param name Measurement name
+ *  \param size Size of the datastructure
+ *  \param items Number of items processed
+ *  \param ns Time taken in nanoseconds
+ */
+static inline void bench_report(const char* name, uint64_t size,
+                                uint64_t items, uint64_t ns) {
+    printf("%-48s size=%-10llu %10.3f ns/item\n", name,
+           (unsigned long long) size,
+           items == 0 ? 0.0 : (double) ns / (double) items);
+}
+
+/**
+ *  Largest list size to benchmark: argv[1] if any, otherwise defaultmax.
+ */
+static inline uint64_t bench_max_size(int argc, char** argv,
+                                      uint64_t defaultmax) {
+    if (argc > 1) {
+        return strtoull(argv[1], NULL, 10);
+    }
+    return defaultmax;
+}
+
+/**
+ *  Next list size to benchmark after size: 4 times size, clamped to max so
+ *  that max itself is benchmarked. Returns a value above max once size
+ *  reached max.
+ */
+static inline uint64_t bench_next_size(uint64_t size, uint64_t max) {
+    if (size < max && (size << 2) > max) {
+        return max;
+    }
+    return size << 2;
+}
+
+/** Hardware counters shared by measurements (see bench_counters_open) */
+static struct perfcounters bench_counters;
+
+/**
+ *  Opens hardware counters. Without calling it (or when counters are
+ *  unavailable), bench_counters_* functions do nothing.
+ */
+static inline void bench_counters_open(void) {
+    perfcounters_open(&bench_counters);
+}
+
+/**
+ *  Starts counting from zero
+ */
+static inline void bench_counters_start(void) {
+    perfcounters_reset(&bench_counters);
+    perfcounters_start(&bench_counters);
+}
+
+/**
+ *  Stops counting and prints available counters, per item
+ *
+ *  \param items Number of items processed since bench_counters_start
+ */
+static inline void bench_counters_report(uint64_t items) {
+    int printed = 0;
+    perfcounters_stop(&bench_counters);
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        uint64_t value = perfcounters_value(&bench_counters, i);
+        if (value == PERFCOUNTERS_UNAVAILABLE || items == 0) {continue;}
+        printf("%s %s=%.3f", printed ? "" : "    per item:",
+               perfcounters_name(i), (double) value / (double) items);
+        printed = 1;
+    }
+    if (printed) {printf("\n");}
+}
+
+/** Objects laid out in an array, visited in address order */
+#define BENCH_PLACEMENT_CONTIGUOUS 0
+/** Objects allocated one by one, visited in a random order */
+#define BENCH_PLACEMENT_SHUFFLED 1
+/** Number of placements */
+#define BENCH_PLACEMENTS 2
+
+/**
+ *  Placement name
+ */
+static inline const char* bench_placement_name(int placement) {
+    return placement == BENCH_PLACEMENT_CONTIGUOUS ? "contiguous" : "shuffled";
+}
+
+/**
+ *  Allocates objects following a placement pattern
+ *
+ *  \param count Number of objects
+ *  \param objsize Object size
+ *  \param placement BENCH_PLACEMENT_*
+ *  \return Objects, in visit order. Exits iff no memory is available. Free
+ *          with bench_free_objects
+ */
+static inline void** bench_alloc_objects(size_t count, size_t objsize,
+                                         int placement) {
+    void** objects = (void**) malloc((count == 0 ? 1 : count) * sizeof(void*));
+    char* block = NULL;
+    size_t i = 0;
+    if (objects != NULL && placement == BENCH_PLACEMENT_CONTIGUOUS) {
+        block = (char*) malloc((count == 0 ? 1 : count) * objsize);
+    }
+    if (objects != NULL && (block != NULL
+                            || placement != BENCH_PLACEMENT_CONTIGUOUS)) {
+        for (; i < count; i++) {
+            objects[i] = block != NULL ? block + i * objsize : malloc(objsize);
+            if (objects[i] == NULL) {break;}
+        }
+    }
+    if (i < count || objects == NULL) {
+        fprintf(stderr, "bench: out of memory (%llu objects)\n",
+                (unsigned long long) count);
+        exit(1);
+    }
+    if (placement == BENCH_PLACEMENT_SHUFFLED) {
+        bench_shuffle(objects, count, 0x9E3779B97F4A7C15ULL);
+    }
+    return objects;
+}
+
+/**
+ *  Frees objects allocated by bench_alloc_objects
+ */
+static inline void bench_free_objects(void** objects, size_t count,
+                                      int placement) {
+    if (placement == BENCH_PLACEMENT_CONTIGUOUS) {
+        // objects[0] is the lowest address: the block itself
+        if (count > 0) {free(objects[0]);}
+    } else {
+        for (size_t i = 0; i < count; i++) {free(objects[i]);}
+    }
+    free(objects);
+}
+
+#endif  // BENCH_INCLUDE_BENCHRUNNER_H_
@@ -0,0 +1,112 @@
+//
+//  shardedlrucacheBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Measures cache throughput (wall time per operation, all threads
+//  included) with 1 to 8 threads for a single locked LRU cache (1 shard), a
+//  sharded one and a sharded one with lazy promotion. 90% of lookups hit
+//  10% of the keys; misses put the key's entry.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/cache/shardedlrucache.h"
+#include "datastructure/hash/hashtable.h"
+#include <pthread.h>
+
+#define BENCH_OPS (1 << 22)     /** Operations per run, all threads */
+
+/** Benchmarked data structure */
+struct foo {
+    uint64_t key;
+    int cached;                 /** Guarded by key's shard lock */
+    struct lrucache_node cache;
+};
+
+struct worker {
+    struct shardedlrucache* cache;
+    struct foo* foos;
+    uint64_t keys;
+    uint64_t ops;
+    uint64_t seed;
+    pthread_t thread;
+};
+
+static int foo_match(const struct lrucache_node* node, const void* key) {
+    return lrucache_entry(node, struct foo, cache)->key == *(const uint64_t*) key;
+}
+
+static void foo_evict(struct lrucache_node* node, void* ctx) {
+    (void) ctx;
+    lrucache_entry(node, struct foo, cache)->cached = 0;
+}
+
+static void* worker_run(void* arg) {
+    struct worker* w = (struct worker*) arg;
+    uint64_t seed = w->seed;
+    uintptr_t sum = 0;
+    for (uint64_t i = 0; i < w->ops; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        uint64_t key = (seed % 10) != 0
+            ? (seed >> 8) % (w->keys / 10 + 1)
+            : (seed >> 8) % w->keys;
+        uint64_t hash = hashtable_hash_u64(key);
+        struct lrucache* shard = shardedlrucache_lock(w->cache, hash);
+        struct lrucache_node* node = lrucache_get(shard, hash, &key);
+        if (node == NULL && !w->foos[key].cached) {
+            w->foos[key].cached = 1;
+            lrucache_put(shard, &(w->foos[key].cache), hash, &key, 1);
+        } else if (node != NULL) {
+            sum += (uintptr_t) lrucache_entry(node, struct foo, cache)->key;
+        }
+        shardedlrucache_unlock(w->cache, hash);
+    }
+    bench_sink += sum;
+    return NULL;
+}
+
+static void run(const char* name, uint64_t keys, size_t shards,
+                int lazy, int threads) {
+    struct foo* foos = (struct foo*) malloc(keys * sizeof(struct foo));
+    for (uint64_t i = 0; i < keys; i++) {
+        foos[i].key = i;
+        foos[i].cached = 0;
+    }
+    struct shardedlrucache cache;
+    shardedlrucache_init(&cache, shards, keys / 2, 0, foo_match, foo_evict,
+                         NULL);
+    if (lazy) {shardedlrucache_set_promotion(&cache, keys / 8);}
+    struct worker workers[8];
+    uint64_t start = bench_now_ns();
+    for (int t = 0; t < threads; t++) {
+        workers[t].cache = &cache;
+        workers[t].foos = foos;
+        workers[t].keys = keys;
+        workers[t].ops = BENCH_OPS / threads;
+        workers[t].seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+        pthread_create(&(workers[t].thread), NULL, worker_run, &(workers[t]));
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "%s threads=%d", name, threads);
+    bench_report(label, keys, BENCH_OPS, bench_now_ns() - start);
+    shardedlrucache_free(&cache);
+    free(foos);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 20);
+    for (uint64_t keys = 1 << 12; keys <= max; keys <<= 4) {
+        for (int threads = 1; threads <= 8; threads <<= 1) {
+            run("lrucache 1 shard", keys, 1, 0, threads);
+            run("shardedlrucache 64 shards", keys, 64, 0, threads);
+            run("shardedlrucache 64 shards lazy", keys, 64, 1, threads);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+//
+//  hashmapBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Compares insert latency of the incrementally growing hash map with a
+//  hash table rehashed all at once when full. Mean and worst insert times
+//  are reported.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/hash/hashmap.h"
+#include "datastructure/hash/hashtable.h"
+
+/** Benchmarked data structure for the incrementally growing map */
+struct foo {
+    uint64_t key;
+    struct hashmap_node hash;
+};
+
+/** Benchmarked data structure for the stop the world rehashed table */
+struct bar {
+    uint64_t key;
+    struct hlinkedlist_node hash;
+};
+
+/** Rehashes every container of table into a table twice as large */
+static void rehash(struct hashtable* table) {
+    struct hashtable larger;
+    if (!hashtable_init(&larger, hashtable_bucket_count(table) << 1)) {return;}
+    for (size_t b = 0; b < hashtable_bucket_count(table); b++) {
+        struct hlinkedlist_head* bucket = &(table->_buckets[b]);
+        while (!hlinkedlist_empty(bucket)) {
+            struct hlinkedlist_node* node = bucket->first;
+            hashtable_remove(table, node);
+            hashtable_add(&larger, node, hashtable_hash_u64(
+                            hlinkedlist_entry(node, struct bar, hash)->key));
+        }
+    }
+    hashtable_free(table);
+    *table = larger;
+}
+
+static void report_max(const char* name, uint64_t size, uint64_t ns) {
+    printf("%-48s size=%-10llu %10.3f us max\n", name,
+           (unsigned long long) size, (double) ns / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    for (uint64_t size = 1 << 12; size <= max; size <<= 2) {
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        struct bar* bars = (struct bar*) malloc(size * sizeof(struct bar));
+        for (uint64_t i = 0; i < size; i++) {
+            foos[i].key = i;
+            bars[i].key = i;
+        }
+
+        struct hashmap map;
+        hashmap_init(&map, 16);
+        uint64_t worst = 0;
+        uint64_t start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            uint64_t t = bench_now_ns();
+            hashmap_add(&map, &(foos[i].hash), hashtable_hash_u64(i));
+            t = bench_now_ns() - t;
+            if (t > worst) {worst = t;}
+        }
+        bench_report("hashmap_add (incremental growth)", size, size,
+                     bench_now_ns() - start);
+        report_max("hashmap_add (incremental growth)", size, worst);
+        hashmap_free(&map);
+
+        struct hashtable table;
+        hashtable_init(&table, 16);
+        worst = 0;
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            uint64_t t = bench_now_ns();
+            hashtable_add(&table, &(bars[i].hash), hashtable_hash_u64(i));
+            if (hashtable_size(&table) >= hashtable_bucket_count(&table)) {
+                rehash(&table);
+            }
+            t = bench_now_ns() - t;
+            if (t > worst) {worst = t;}
+        }
+        bench_report("hashtable_add (full rehash)", size, size,
+                     bench_now_ns() - start);
+        report_max("hashtable_add (full rehash)", size, worst);
+        hashtable_free(&table);
+
+        free(bars);
+        free(foos);
+    }
+    return 0;
+}
@@ -0,0 +1,288 @@
+//
+//  dlinkedlistContainersBench.cpp
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  C++ counterpart of dlinkedlistPrimitivesBench.c: times the same
+//  operations on
+//  - std::list (node allocation/deallocation included in add/remove)
+//  - boost::intrusive::list (non constant time size, as dlinkedlist), iff
+//    Boost headers are available
+//
+//  Placements:
+//  - contiguous: nodes are linked in allocation order
+//  - shuffled: nodes are linked in random order (std::list nodes are
+//    relinked through splice, intrusive nodes are allocated one by one)
+//
+//  Traversals (and size) also report hardware counters per node when
+//  available (see datastructure/perf/perfcounters.h).
+//
+
+#include <list>
+#include <new>
+#include <vector>
+#include "BenchRunner.h"
+
+#if defined(__has_include)
+    #if __has_include(<boost/intrusive/list.hpp>)
+        #define BENCH_HAS_BOOST_INTRUSIVE 1
+        #include <boost/intrusive/list.hpp>
+    #endif
+#endif
+
+/** Number of O(1) operations timed per measurement */
+#define SPLICE_OPS (1 << 20)
+
+static void report(const char* op, const char* placement, uint64_t size,
+                   uint64_t items, uint64_t ns) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%s", op, placement);
+    bench_report(name, size, items, ns);
+}
+
+/** Benchmarked data structure */
+struct foo {
+    uintptr_t bar;
+};
+
+typedef std::list<foo> foo_list;
+
+/**
+ *  Relinks list's nodes following a random permutation. Nodes are not moved
+ *  in memory.
+ */
+static void shuffle_links(foo_list& list) {
+    std::vector<foo_list::iterator> nodes;
+    std::vector<void*> order;
+    nodes.reserve(list.size());
+    order.reserve(list.size());
+    for (foo_list::iterator i = list.begin(); i != list.end(); ++i) {
+        nodes.push_back(i);
+    }
+    for (size_t i = 0; i < nodes.size(); i++) {
+        order.push_back(&nodes[i]);
+    }
+    bench_shuffle(&order[0], order.size(), 0x9E3779B97F4A7C15ULL);
+    foo_list shuffled;
+    for (size_t i = 0; i < order.size(); i++) {
+        shuffled.splice(shuffled.end(), list,
+                        *static_cast<foo_list::iterator*>(order[i]));
+    }
+    list.swap(shuffled);
+}
+
+static void bench_std_list(uint64_t size, int placement) {
+    const char* pname = bench_placement_name(placement);
+    uint64_t rounds = bench_rounds(size);
+    uint64_t addhead = 0, addtail = 0, remove = 0;
+    uint64_t start;
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        foo_list list;
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            foo f = {static_cast<uintptr_t>(i)};
+            list.push_front(f);
+        }
+        addhead += bench_now_ns() - start;
+        list.clear();
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            foo f = {static_cast<uintptr_t>(i)};
+            list.push_back(f);
+        }
+        addtail += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        while (!list.empty()) {
+            list.pop_front();
+        }
+        remove += bench_now_ns() - start;
+    }
+    report("std::list::push_front", pname, size, rounds * size, addhead);
+    report("std::list::push_back", pname, size, rounds * size, addtail);
+    report("std::list::pop_front", pname, size, rounds * size, remove);
+
+    foo_list list;
+    for (uint64_t i = 0; i < size; i++) {
+        foo f = {static_cast<uintptr_t>(i)};
+        list.push_back(f);
+    }
+    if (placement == BENCH_PLACEMENT_SHUFFLED) {
+        shuffle_links(list);
+    }
+
+    // Splitting a std::list in O(1) is not possible: whole lists are moved
+    {
+        foo_list lists[2];
+        int h = 0;
+        lists[0].swap(list);
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < SPLICE_OPS; r++) {
+            lists[1 - h].splice(lists[1 - h].begin(), lists[h]);
+            h = 1 - h;
+        }
+        report("std::list::splice", pname, size, SPLICE_OPS,
+               bench_now_ns() - start);
+        list.swap(lists[h]);
+    }
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        bench_sink += static_cast<uintptr_t>(list.size());
+    }
+    report("std::list::size", pname, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        uintptr_t sum = 0;
+        for (foo_list::const_iterator i = list.begin(); i != list.end(); ++i) {
+            sum += i->bar;
+        }
+        bench_sink += sum;
+    }
+    report("std::list::const_iterator", pname, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+}
+
+#ifdef BENCH_HAS_BOOST_INTRUSIVE
+
+/** Benchmarked data structure */
+struct ifoo {
+    uintptr_t bar;
+    boost::intrusive::list_member_hook<> hook;
+};
+
+typedef boost::intrusive::list<ifoo,
+            boost::intrusive::member_hook<ifoo,
+                boost::intrusive::list_member_hook<>, &ifoo::hook>,
+            boost::intrusive::constant_time_size<false> > ifoo_list;
+
+#define IFOO(objects, i) (*static_cast<ifoo*>((objects)[i]))
+
+static void bench_boost_intrusive(uint64_t size, int placement) {
+    const char* pname = bench_placement_name(placement);
+    void** objects = bench_alloc_objects(static_cast<size_t>(size),
+                                         sizeof(ifoo), placement);
+    uint64_t rounds = bench_rounds(size);
+    uint64_t addhead = 0, addtail = 0, addbefore = 0, remove = 0;
+    uint64_t start;
+
+    for (uint64_t i = 0; i < size; i++) {
+        new (objects[i]) ifoo();
+        IFOO(objects, i).bar = static_cast<uintptr_t>(i);
+    }
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        ifoo_list list;
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            list.push_front(IFOO(objects, i));
+        }
+        addhead += bench_now_ns() - start;
+        list.clear();
+
+        // Each node is linked next to an already linked node
+        list.push_back(IFOO(objects, 0));
+        start = bench_now_ns();
+        for (uint64_t i = 1; i < size; i++) {
+            list.insert(ifoo_list::s_iterator_to(IFOO(objects, i / 2)),
+                        IFOO(objects, i));
+        }
+        addbefore += bench_now_ns() - start;
+        list.clear();
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            list.push_back(IFOO(objects, i));
+        }
+        addtail += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            list.erase(ifoo_list::s_iterator_to(IFOO(objects, i)));
+        }
+        remove += bench_now_ns() - start;
+    }
+    report("intrusive::list::push_front", pname, size, rounds * size, addhead);
+    report("intrusive::list::push_back", pname, size, rounds * size, addtail);
+    report("intrusive::list::insert", pname, size, rounds * size, addbefore);
+    report("intrusive::list::erase", pname, size, rounds * size, remove);
+
+    ifoo_list list;
+    for (uint64_t i = 0; i < size; i++) {
+        list.push_back(IFOO(objects, i));
+    }
+
+    // Split in the middle then splice back, alternating lists so that
+    // node order is kept
+    {
+        ifoo_list lists[2];
+        ifoo_list::iterator middle = ifoo_list::s_iterator_to(
+                                                IFOO(objects, size / 2));
+        int h = 0;
+        lists[0].swap(list);
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < SPLICE_OPS; r++) {
+            lists[1 - h].splice(lists[1 - h].end(), lists[h], middle,
+                                lists[h].end());
+            lists[1 - h].splice(lists[1 - h].begin(), lists[h]);
+            h = 1 - h;
+        }
+        report("intrusive::list::split+splice", pname, size,
+               SPLICE_OPS, bench_now_ns() - start);
+        list.swap(lists[h]);
+    }
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        bench_sink += static_cast<uintptr_t>(list.size());
+    }
+    report("intrusive::list::size", pname, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        uintptr_t sum = 0;
+        for (ifoo_list::const_iterator i = list.begin(); i != list.end(); ++i) {
+            sum += i->bar;
+        }
+        bench_sink += sum;
+    }
+    report("intrusive::list::const_iterator", pname, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    list.clear();
+    for (uint64_t i = 0; i < size; i++) {
+        IFOO(objects, i).~ifoo();
+    }
+    bench_free_objects(objects, static_cast<size_t>(size), placement);
+}
+
+#endif  // BENCH_HAS_BOOST_INTRUSIVE
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    bench_counters_open();
+    for (uint64_t size = 1 << 10; size <= max;
+         size = bench_next_size(size, max)) {
+        for (int p = 0; p < BENCH_PLACEMENTS; p++) {
+            bench_std_list(size, p);
+#ifdef BENCH_HAS_BOOST_INTRUSIVE
+            bench_boost_intrusive(size, p);
+#endif
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+//
+//  dlinkedlistInterleaveBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Walks many short lists (eg: hash buckets) whose nodes are scattered
+//  across the heap, one list after the other vs interleaved.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_interleave.h"
+
+#define NODES_PER_LIST 8
+
+/** Benchmarked data structure */
+struct foo {
+    uint64_t bar;
+    struct dlinkedlist_node list;
+};
+
+static void visit(struct dlinkedlist_node* node, size_t list, void* ctx) {
+    *(uint64_t*) ctx += dlinkedlist_entry(node, struct foo, list)->bar + list;
+}
+
+static uint64_t walk_sequential(struct dlinkedlist_node** heads, size_t count) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        struct dlinkedlist_node* n;
+        struct dlinkedlist_node* next;
+        for (n = heads[i]->next; n != heads[i]; n = next) {
+            next = n->next;
+            visit(n, i, &sum);
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    unsigned int widths[6] = {1, 2, 4, 8, 16, 32};
+    for (uint64_t size = 1 << 14; size <= max; size <<= 2) {
+        size_t count = (size_t) (size / NODES_PER_LIST);
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        void** order = (void**) malloc(size * sizeof(void*));
+        struct dlinkedlist_node* heads = (struct dlinkedlist_node*)
+                            malloc(count * sizeof(struct dlinkedlist_node));
+        struct dlinkedlist_node** headptrs = (struct dlinkedlist_node**)
+                            malloc(count * sizeof(struct dlinkedlist_node*));
+        for (size_t i = 0; i < count; i++) {
+            dlinkedlist_init_head(&(heads[i]), NULL);
+            headptrs[i] = &(heads[i]);
+        }
+        for (uint64_t i = 0; i < size; i++) {
+            foos[i].bar = i;
+            order[i] = &(foos[i]);
+        }
+        bench_shuffle(order, (size_t) size, 0x9E3779B97F4A7C15ULL);
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&(heads[i % count]),
+                                 &(((struct foo*) order[i])->list), NULL);
+        }
+
+        uint64_t rounds = bench_rounds(size);
+        uint64_t start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            bench_sink += (uintptr_t) walk_sequential(headptrs, count);
+        }
+        bench_report("sequential", size, rounds * size, bench_now_ns() - start);
+
+        for (int w = 0; w < 6; w++) {
+            char name[64];
+            start = bench_now_ns();
+            for (uint64_t r = 0; r < rounds; r++) {
+                uint64_t sum = 0;
+                dlinkedlist_interleave_for_each(headptrs, count, widths[w],
+                                                offsetof(struct foo, list),
+                                                visit, &sum);
+                bench_sink += (uintptr_t) sum;
+            }
+            snprintf(name, sizeof(name), "dlinkedlist_interleave_for_each width=%u",
+                     widths[w]);
+            bench_report(name, size, rounds * size, bench_now_ns() - start);
+        }
+
+        free(headptrs);
+        free(heads);
+        free(order);
+        free(foos);
+    }
+    return 0;
+}
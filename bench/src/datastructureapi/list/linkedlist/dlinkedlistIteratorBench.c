@@ -0,0 +1,92 @@
+//
+//  dlinkedlistIteratorBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Compares list traversal through:
+//  - dlinkedlist_for_each
+//  - a typed iterator (DLINKEDLIST_DEFINE_TYPED_ITERATOR)
+//  - struct iterator (function pointer dispatch)
+//
+
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_typed_iterator.h"
+
+/** Benchmarked data structure */
+struct foo {
+    uintptr_t bar;
+    struct dlinkedlist_node list;
+};
+
+DLINKEDLIST_DEFINE_TYPED_ITERATOR(foo_iterator, struct foo, list)
+
+static uintptr_t sum_for_each(struct dlinkedlist_node* head) {
+    struct dlinkedlist_node* n;
+    uintptr_t sum = 0;
+    dlinkedlist_for_each(head, n) {
+        sum += dlinkedlist_entry(n, struct foo, list)->bar;
+    }
+    return sum;
+}
+
+static uintptr_t sum_typed_iterator(struct dlinkedlist_node* head) {
+    struct foo_iterator it;
+    struct foo* e;
+    uintptr_t sum = 0;
+    foo_iterator_init(&it, head);
+    while ((e = foo_iterator_next(&it)) != NULL) {
+        sum += e->bar;
+    }
+    return sum;
+}
+
+static uintptr_t sum_iterator(struct dlinkedlist_node* head) {
+    struct iterator_dlinkedlist storage;
+    struct iterator* it = dlinkedlist_iterator_init(&storage, head, NULL);
+    struct dlinkedlist_node* n;
+    uintptr_t sum = 0;
+    for (n = (struct dlinkedlist_node*) iterator_item_next(it); n != head;
+         n = (struct dlinkedlist_node*) iterator_item_next(it)) {
+        sum += dlinkedlist_entry(n, struct foo, list)->bar;
+    }
+    dlinkedlist_iterator_deinit(it);
+    return sum;
+}
+
+static void run(const char* name, uintptr_t (*fn)(struct dlinkedlist_node*),
+                struct dlinkedlist_node* head, uint64_t size) {
+    uint64_t rounds = bench_rounds(size);
+    uint64_t start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        bench_sink += fn(head);
+    }
+    bench_report(name, size, rounds * size, bench_now_ns() - start);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    for (uint64_t size = 1 << 10; size <= max; size <<= 2) {
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        void** order = (void**) malloc(size * sizeof(void*));
+        struct dlinkedlist_node head;
+        dlinkedlist_init_head(&head, NULL);
+        for (uint64_t i = 0; i < size; i++) {
+            foos[i].bar = (uintptr_t) i;
+            order[i] = &(foos[i]);
+        }
+        bench_shuffle(order, (size_t) size, 0x9E3779B97F4A7C15ULL);
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&head, &(((struct foo*) order[i])->list), NULL);
+        }
+
+        run("dlinkedlist_for_each", sum_for_each, &head, size);
+        run("DLINKEDLIST_DEFINE_TYPED_ITERATOR", sum_typed_iterator, &head, size);
+        run("struct iterator", sum_iterator, &head, size);
+
+        free(order);
+        free(foos);
+    }
+    return 0;
+}
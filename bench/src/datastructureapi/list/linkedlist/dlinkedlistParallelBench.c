@@ -0,0 +1,167 @@
+//
+//  dlinkedlistParallelBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Scaling of dlinkedlist_parallel_reduce with the number of threads
+//  (calling thread included), against a sequential dlinkedlist_for_each:
+//  - checksum: one addition per node (memory bound)
+//  - hash: a few multiplications per node (compute bound)
+//
+//  Parallel traversals are timed with a prebuilt segment index (segments)
+//  and with partitioning on the fly (one sequential walk per traversal).
+//  Speedups are relative to dlinkedlist_for_each on the same nodes.
+//
+//  Thread counts go from 2 to the number of online processors.
+//
+
+#include <unistd.h>
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist_parallel.h"
+
+/** Benchmarked data structure */
+struct foo {
+    uint64_t bar;
+    struct dlinkedlist_node list;
+};
+
+#define FOO(objects, i) ((struct foo*) (objects)[i])
+
+static uint64_t hash(uint64_t x) {
+    for (int i = 0; i < 8; i++) {
+        x ^= x >> 31;
+        x *= 0x7FB5D329728EA185ULL;
+    }
+    return x;
+}
+
+static void visit_checksum(struct dlinkedlist_node* node, void* ctx,
+                           void* acc) {
+    (void) ctx;
+    *(uint64_t*) acc += dlinkedlist_entry(node, struct foo, list)->bar;
+}
+
+static void visit_hash(struct dlinkedlist_node* node, void* ctx, void* acc) {
+    (void) ctx;
+    *(uint64_t*) acc += hash(dlinkedlist_entry(node, struct foo, list)->bar);
+}
+
+static void combine_sum(void* result, const void* acc, void* ctx) {
+    (void) ctx;
+    *(uint64_t*) result += *(const uint64_t*) acc;
+}
+
+struct workload {
+    const char* name;
+    dlinkedlist_parallel_visit visit;
+};
+
+static void report(const char* op, const char* workload, unsigned int threads,
+                   const char* placement, uint64_t size, uint64_t items,
+                   uint64_t ns, uint64_t sequential) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%s/%ut/%s", op, workload, threads,
+             placement);
+    bench_report(name, size, items, ns);
+    if (sequential > 0) {
+        printf("%-48s speedup %.2f\n", name, (double) sequential / ns);
+    }
+}
+
+static void check(uint64_t expected, uint64_t actual) {
+    if (expected != actual) {
+        fprintf(stderr, "parallel reduction mismatch\n");
+        exit(1);
+    }
+}
+
+static void bench_workload(struct dlinkedlist_node* head, uint64_t size,
+                           const struct workload* w, unsigned int maxthreads,
+                           const char* placement) {
+    uint64_t rounds = bench_rounds(size);
+    uint64_t expected = 0, sequential, start;
+
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct dlinkedlist_node* n;
+        uint64_t sum = 0;
+        dlinkedlist_for_each(head, n) {
+            w->visit(n, NULL, &sum);
+        }
+        expected = sum;
+    }
+    sequential = bench_now_ns() - start;
+    report("dlinkedlist_for_each", w->name, 1, placement, size,
+           rounds * size, sequential, 0);
+
+    for (unsigned int threads = 2; threads <= maxthreads; threads <<= 1) {
+        struct threadpool pool;
+        struct dlinkedlist_segments segments;
+        if (threads * 2 > maxthreads && threads < maxthreads) {
+            threads = maxthreads;
+        }
+        if (!threadpool_init(&pool, threads - 1)
+            || !dlinkedlist_segments_init(&segments, head, threads
+                                * DLINKEDLIST_PARALLEL_SEGMENTS_PER_THREAD)) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            uint64_t sum = 0;
+            dlinkedlist_parallel_reduce_segments(&pool, &segments, w->visit,
+                                                 combine_sum, NULL, &sum,
+                                                 sizeof(sum));
+            check(expected, sum);
+        }
+        report("segments", w->name, threads, placement, size, rounds * size,
+               bench_now_ns() - start, sequential);
+
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            uint64_t sum = 0;
+            dlinkedlist_parallel_reduce(&pool, head, w->visit, combine_sum,
+                                        NULL, &sum, sizeof(sum));
+            check(expected, sum);
+        }
+        report("dlinkedlist_parallel_reduce", w->name, threads, placement,
+               size, rounds * size, bench_now_ns() - start, sequential);
+
+        dlinkedlist_segments_free(&segments);
+        threadpool_free(&pool);
+    }
+}
+
+int main(int argc, char** argv) {
+    static const struct workload workloads[] = {
+        {"checksum", visit_checksum},
+        {"hash", visit_hash}
+    };
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int maxthreads = online > 1 ? (unsigned int) online : 1;
+    if (maxthreads == 1) {
+        printf("1 online processor: parallel traversals are not timed\n");
+    }
+    for (uint64_t size = 1 << 16; size <= max; size <<= 2) {
+        for (int p = 0; p < BENCH_PLACEMENTS; p++) {
+            struct dlinkedlist_node head;
+            void** objects = bench_alloc_objects((size_t) size,
+                                                 sizeof(struct foo), p);
+            dlinkedlist_init_head(&head, NULL);
+            for (uint64_t i = 0; i < size; i++) {
+                FOO(objects, i)->bar = i;
+                dlinkedlist_add_tail(&head, &(FOO(objects, i)->list), NULL);
+            }
+            for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]);
+                 w++) {
+                bench_workload(&head, size, &(workloads[w]), maxthreads,
+                               bench_placement_name(p));
+            }
+            bench_free_objects(objects, (size_t) size, p);
+        }
+    }
+    return 0;
+}
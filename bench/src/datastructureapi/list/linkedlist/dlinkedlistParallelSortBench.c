@@ -0,0 +1,78 @@
+//
+//  dlinkedlistParallelSortBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Measures dlinkedlist_parallel_sort throughput against the number of
+//  threads, up to the number of online processors.
+//
+
+#include <unistd.h>
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_sort.h"
+#include "datastructure/list/dlinkedlist_parallel_sort.h"
+
+/** Benchmarked data structure */
+struct foo {
+    uint64_t key;
+    struct dlinkedlist_node list;
+};
+
+static int compare_foo(const struct dlinkedlist_node* a,
+                       const struct dlinkedlist_node* b, void* ctx) {
+    uint64_t ka = dlinkedlist_entry(a, const struct foo, list)->key;
+    uint64_t kb = dlinkedlist_entry(b, const struct foo, list)->key;
+    (void) ctx;
+    return (ka > kb) - (ka < kb);
+}
+
+static void build(struct dlinkedlist_node* head, void** order, uint64_t size) {
+    dlinkedlist_init_head(head, NULL);
+    for (uint64_t i = 0; i < size; i++) {
+        dlinkedlist_add_tail(head, &(((struct foo*) order[i])->list), NULL);
+    }
+}
+
+int main(int argc, char** argv) {
+    uint64_t size = bench_max_size(argc, argv, 1 << 22);
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int cores = online > 0 ? (unsigned int) online : 1;
+    struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+    void** order = (void**) malloc(size * sizeof(void*));
+    struct dlinkedlist_node head;
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    for (uint64_t i = 0; i < size; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        foos[i].key = seed;
+        order[i] = &(foos[i]);
+    }
+    bench_shuffle(order, (size_t) size, 0x9E3779B97F4A7C15ULL);
+
+    build(&head, order, size);
+    uint64_t start = bench_now_ns();
+    dlinkedlist_sort(&head, compare_foo, NULL);
+    uint64_t sequential = bench_now_ns() - start;
+    bench_report("dlinkedlist_sort", size, size, sequential);
+
+    // Powers of 2 below the number of cores, then the number of cores
+    for (unsigned int threads = 1; threads <= cores;
+         threads = (threads < cores && threads << 1 > cores)
+                        ? cores : threads << 1) {
+        char name[64];
+        build(&head, order, size);
+        start = bench_now_ns();
+        dlinkedlist_parallel_sort(&head, compare_foo, NULL, threads);
+        uint64_t ns = bench_now_ns() - start;
+        snprintf(name, sizeof(name), "dlinkedlist_parallel_sort threads=%u",
+                 threads);
+        bench_report(name, size, size, ns);
+        printf("%-48s speedup=%.2f\n", "", (double) sequential / (double) ns);
+    }
+    free(order);
+    free(foos);
+    return 0;
+}
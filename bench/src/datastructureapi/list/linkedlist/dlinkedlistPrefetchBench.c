@@ -0,0 +1,94 @@
+//
+//  dlinkedlistPrefetchBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Compares dlinkedlist_for_each against prefetching traversals at various
+//  prefetch distances, on nodes scattered across the heap.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+
+#define PAYLOAD_WORDS 8
+
+/** Benchmarked data structure: payload lives in its own cache line */
+struct foo {
+    uint64_t payload[PAYLOAD_WORDS];
+    struct dlinkedlist_node list;
+};
+
+static uint64_t work(const struct foo* e) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < PAYLOAD_WORDS; i++) {
+        h = (h ^ e->payload[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static uint64_t scan_for_each(struct dlinkedlist_node* head, unsigned int d) {
+    struct dlinkedlist_node* n;
+    uint64_t sum = 0;
+    (void) d;
+    dlinkedlist_for_each(head, n) {
+        sum += work(dlinkedlist_entry(n, struct foo, list));
+    }
+    return sum;
+}
+
+static uint64_t scan_prefetch(struct dlinkedlist_node* head, unsigned int d) {
+    struct dlinkedlist_node* n;
+    struct dlinkedlist_node* ahead;
+    struct foo* pos;
+    uint64_t sum = 0;
+    dlinkedlist_for_each_entry_prefetch(head, pos, n, ahead,
+                                        struct foo, list, d) {
+        sum += work(pos);
+    }
+    return sum;
+}
+
+static void run(const char* name,
+                uint64_t (*fn)(struct dlinkedlist_node*, unsigned int),
+                struct dlinkedlist_node* head, uint64_t size, unsigned int d) {
+    char label[64];
+    uint64_t rounds = bench_rounds(size);
+    uint64_t start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        bench_sink += (uintptr_t) fn(head, d);
+    }
+    snprintf(label, sizeof(label), "%s distance=%u", name, d);
+    bench_report(label, size, rounds * size, bench_now_ns() - start);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    unsigned int distances[5] = {1, 2, 4, 8, 16};
+    for (uint64_t size = 1 << 14; size <= max; size <<= 2) {
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        void** order = (void**) malloc(size * sizeof(void*));
+        struct dlinkedlist_node head;
+        dlinkedlist_init_head(&head, NULL);
+        for (uint64_t i = 0; i < size; i++) {
+            for (int w = 0; w < PAYLOAD_WORDS; w++) {
+                foos[i].payload[w] = i + (uint64_t) w;
+            }
+            order[i] = &(foos[i]);
+        }
+        bench_shuffle(order, (size_t) size, 0x9E3779B97F4A7C15ULL);
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&head, &(((struct foo*) order[i])->list), NULL);
+        }
+
+        run("dlinkedlist_for_each", scan_for_each, &head, size, 0);
+        for (int d = 0; d < 5; d++) {
+            run("dlinkedlist_for_each_entry_prefetch", scan_prefetch, &head,
+                size, distances[d]);
+        }
+
+        free(order);
+        free(foos);
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+//
+//  dlinkedlistPrimitivesBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Times dlinkedlist primitives against sys/queue.h TAILQ:
+//  - add_head / add_tail / add_after / add_before (link n nodes)
+//  - remove (unlink n nodes, in link order)
+//  - split then splice back (O(1) flavours: sizes are not maintained)
+//  - size (O(n) walk)
+//  - traversal through dlinkedlist_for_each and struct iterator
+//
+//  Each measurement is run for every node placement:
+//  - contiguous: nodes lie in an array and are linked in address order
+//  - shuffled: nodes are allocated one by one and linked in random order
+//
+//  Traversals (and size) also report hardware counters per node when
+//  available (see datastructure/perf/perfcounters.h).
+//
+//  Sizes go from L1 resident (1024 nodes) to argv[1] nodes (default 4M).
+//  Large sizes (eg: 100000000) require about 40 bytes of memory per node.
+//
+
+#include <sys/queue.h>
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/** Benchmarked data structure */
+struct foo {
+    uintptr_t bar;
+    struct dlinkedlist_node list;
+};
+
+/** Same data structure, linked with TAILQ */
+struct tfoo {
+    uintptr_t bar;
+    TAILQ_ENTRY(tfoo) link;
+};
+
+TAILQ_HEAD(tfoo_head, tfoo);
+
+/** Number of O(1) operations timed per measurement */
+#define SPLICE_OPS (1 << 20)
+
+#define FOO(objects, i) ((struct foo*) (objects)[i])
+#define TFOO(objects, i) ((struct tfoo*) (objects)[i])
+
+static void report(const char* op, const char* placement, uint64_t size,
+                   uint64_t items, uint64_t ns) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%s", op, placement);
+    bench_report(name, size, items, ns);
+}
+
+static void bench_dlinkedlist(void** objects, uint64_t size,
+                              const char* placement) {
+    struct dlinkedlist_node head;
+    uint64_t rounds = bench_rounds(size);
+    uint64_t addhead = 0, addtail = 0, addafter = 0, addbefore = 0;
+    uint64_t remove = 0;
+    uint64_t start;
+
+    for (uint64_t i = 0; i < size; i++) {
+        FOO(objects, i)->bar = (uintptr_t) i;
+    }
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        dlinkedlist_init_head(&head, NULL);
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_head(&head, &(FOO(objects, i)->list), NULL);
+        }
+        addhead += bench_now_ns() - start;
+
+        // Each node is linked next to an already linked node
+        dlinkedlist_init_head(&head, NULL);
+        dlinkedlist_add_tail(&head, &(FOO(objects, 0)->list), NULL);
+        start = bench_now_ns();
+        for (uint64_t i = 1; i < size; i++) {
+            dlinkedlist_add_after(&(FOO(objects, i / 2)->list),
+                                  &(FOO(objects, i)->list), NULL);
+        }
+        addafter += bench_now_ns() - start;
+
+        dlinkedlist_init_head(&head, NULL);
+        dlinkedlist_add_tail(&head, &(FOO(objects, 0)->list), NULL);
+        start = bench_now_ns();
+        for (uint64_t i = 1; i < size; i++) {
+            dlinkedlist_add_before(&(FOO(objects, i / 2)->list),
+                                   &(FOO(objects, i)->list), NULL);
+        }
+        addbefore += bench_now_ns() - start;
+
+        dlinkedlist_init_head(&head, NULL);
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&head, &(FOO(objects, i)->list), NULL);
+        }
+        addtail += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_remove(&(FOO(objects, i)->list), NULL);
+        }
+        remove += bench_now_ns() - start;
+    }
+    report("dlinkedlist_add_head", placement, size, rounds * size, addhead);
+    report("dlinkedlist_add_tail", placement, size, rounds * size, addtail);
+    report("dlinkedlist_add_after", placement, size, rounds * size, addafter);
+    report("dlinkedlist_add_before", placement, size, rounds * size, addbefore);
+    report("dlinkedlist_remove", placement, size, rounds * size, remove);
+
+    dlinkedlist_init_head(&head, NULL);
+    for (uint64_t i = 0; i < size; i++) {
+        dlinkedlist_add_tail(&head, &(FOO(objects, i)->list), NULL);
+    }
+
+    // Split in the middle then splice back, alternating heads so that
+    // node order is kept
+    {
+        struct dlinkedlist_node heads[2];
+        struct dlinkedlist_node* middle = &(FOO(objects, size / 2)->list);
+        int h = 0;
+        dlinkedlist_init_head(&heads[0], NULL);
+        dlinkedlist_init_head(&heads[1], NULL);
+        dlinkedlist_splice(&head, &heads[0], NULL, NULL);
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < SPLICE_OPS; r++) {
+            dlinkedlist_split(&heads[h], &heads[1 - h], middle, NULL, NULL);
+            dlinkedlist_splice(&heads[h], &heads[1 - h], NULL, NULL);
+            h = 1 - h;
+        }
+        report("dlinkedlist_split+dlinkedlist_splice", placement, size,
+               SPLICE_OPS, bench_now_ns() - start);
+        dlinkedlist_init_head(&head, NULL);
+        dlinkedlist_splice(&heads[h], &head, NULL, NULL);
+    }
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        bench_sink += (uintptr_t) dlinkedlist_size(&head);
+    }
+    report("dlinkedlist_size", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct dlinkedlist_node* n;
+        uintptr_t sum = 0;
+        dlinkedlist_for_each(&head, n) {
+            sum += dlinkedlist_entry(n, struct foo, list)->bar;
+        }
+        bench_sink += sum;
+    }
+    report("dlinkedlist_for_each", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct iterator_dlinkedlist storage;
+        struct iterator* it = dlinkedlist_iterator_init(&storage, &head, NULL);
+        struct dlinkedlist_node* n;
+        uintptr_t sum = 0;
+        for (n = (struct dlinkedlist_node*) iterator_item_next(it); n != &head;
+             n = (struct dlinkedlist_node*) iterator_item_next(it)) {
+            sum += dlinkedlist_entry(n, struct foo, list)->bar;
+        }
+        dlinkedlist_iterator_deinit(it);
+        bench_sink += sum;
+    }
+    report("struct iterator", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+}
+
+static void bench_tailq(void** objects, uint64_t size, const char* placement) {
+    struct tfoo_head head;
+    uint64_t rounds = bench_rounds(size);
+    uint64_t addhead = 0, addtail = 0, addafter = 0, addbefore = 0;
+    uint64_t remove = 0;
+    uint64_t start;
+
+    for (uint64_t i = 0; i < size; i++) {
+        TFOO(objects, i)->bar = (uintptr_t) i;
+    }
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        TAILQ_INIT(&head);
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            TAILQ_INSERT_HEAD(&head, TFOO(objects, i), link);
+        }
+        addhead += bench_now_ns() - start;
+
+        TAILQ_INIT(&head);
+        TAILQ_INSERT_TAIL(&head, TFOO(objects, 0), link);
+        start = bench_now_ns();
+        for (uint64_t i = 1; i < size; i++) {
+            TAILQ_INSERT_AFTER(&head, TFOO(objects, i / 2), TFOO(objects, i),
+                               link);
+        }
+        addafter += bench_now_ns() - start;
+
+        TAILQ_INIT(&head);
+        TAILQ_INSERT_TAIL(&head, TFOO(objects, 0), link);
+        start = bench_now_ns();
+        for (uint64_t i = 1; i < size; i++) {
+            TAILQ_INSERT_BEFORE(TFOO(objects, i / 2), TFOO(objects, i), link);
+        }
+        addbefore += bench_now_ns() - start;
+
+        TAILQ_INIT(&head);
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            TAILQ_INSERT_TAIL(&head, TFOO(objects, i), link);
+        }
+        addtail += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            TAILQ_REMOVE(&head, TFOO(objects, i), link);
+        }
+        remove += bench_now_ns() - start;
+    }
+    report("TAILQ_INSERT_HEAD", placement, size, rounds * size, addhead);
+    report("TAILQ_INSERT_TAIL", placement, size, rounds * size, addtail);
+    report("TAILQ_INSERT_AFTER", placement, size, rounds * size, addafter);
+    report("TAILQ_INSERT_BEFORE", placement, size, rounds * size, addbefore);
+    report("TAILQ_REMOVE", placement, size, rounds * size, remove);
+
+    TAILQ_INIT(&head);
+    for (uint64_t i = 0; i < size; i++) {
+        TAILQ_INSERT_TAIL(&head, TFOO(objects, i), link);
+    }
+
+#ifdef TAILQ_CONCAT
+    // TAILQ has no split: only concatenation is timed, per concatenation
+    {
+        struct tfoo_head heads[2];
+        int h = 0;
+        TAILQ_INIT(&heads[0]);
+        TAILQ_INIT(&heads[1]);
+        TAILQ_CONCAT(&heads[0], &head, link);
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < SPLICE_OPS; r++) {
+            TAILQ_CONCAT(&heads[1 - h], &heads[h], link);
+            h = 1 - h;
+        }
+        report("TAILQ_CONCAT", placement, size, SPLICE_OPS,
+               bench_now_ns() - start);
+        TAILQ_CONCAT(&head, &heads[h], link);
+    }
+#endif
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct tfoo* e;
+        uintptr_t count = 0;
+        TAILQ_FOREACH(e, &head, link) {count++;}
+        bench_sink += count;
+    }
+    report("TAILQ_FOREACH (count)", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct tfoo* e;
+        uintptr_t sum = 0;
+        TAILQ_FOREACH(e, &head, link) {sum += e->bar;}
+        bench_sink += sum;
+    }
+    report("TAILQ_FOREACH", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    bench_counters_open();
+    size_t objsize = sizeof(struct foo) > sizeof(struct tfoo)
+                        ? sizeof(struct foo) : sizeof(struct tfoo);
+    for (uint64_t size = 1 << 10; size <= max;
+         size = bench_next_size(size, max)) {
+        for (int p = 0; p < BENCH_PLACEMENTS; p++) {
+            void** objects = bench_alloc_objects((size_t) size, objsize, p);
+            bench_dlinkedlist(objects, size, bench_placement_name(p));
+            bench_tailq(objects, size, bench_placement_name(p));
+            bench_free_objects(objects, (size_t) size, p);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+//
+//  dlinkedlistTypedIteratorBench.cpp
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Compares list traversal through:
+//  - dlinkedlist_for_each
+//  - datastructure::dlinkedlist_typed_iterator
+//
+
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_typed_iterator.hpp"
+
+/** Benchmarked data structure */
+struct foo {
+    uintptr_t bar;
+    struct dlinkedlist_node list;
+};
+
+typedef datastructure::dlinkedlist_typed_iterator<foo, &foo::list> foo_iterator;
+
+static uintptr_t sum_for_each(struct dlinkedlist_node* head) {
+    struct dlinkedlist_node* n;
+    uintptr_t sum = 0;
+    dlinkedlist_for_each(head, n) {
+        sum += dlinkedlist_entry(n, struct foo, list)->bar;
+    }
+    return sum;
+}
+
+static uintptr_t sum_typed_iterator(struct dlinkedlist_node* head) {
+    uintptr_t sum = 0;
+    for (foo_iterator i = foo_iterator::begin(head), end = foo_iterator::end(head);
+         i != end; ++i) {
+        sum += i->bar;
+    }
+    return sum;
+}
+
+static void run(const char* name, uintptr_t (*fn)(struct dlinkedlist_node*),
+                struct dlinkedlist_node* head, uint64_t size) {
+    uint64_t rounds = bench_rounds(size);
+    uint64_t start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        bench_sink += fn(head);
+    }
+    bench_report(name, size, rounds * size, bench_now_ns() - start);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    for (uint64_t size = 1 << 10; size <= max; size <<= 2) {
+        foo* foos = static_cast<foo*>(malloc(size * sizeof(foo)));
+        void** order = static_cast<void**>(malloc(size * sizeof(void*)));
+        struct dlinkedlist_node head;
+        dlinkedlist_init_head(&head, NULL);
+        for (uint64_t i = 0; i < size; i++) {
+            foos[i].bar = static_cast<uintptr_t>(i);
+            order[i] = &(foos[i]);
+        }
+        bench_shuffle(order, static_cast<size_t>(size), 0x9E3779B97F4A7C15ULL);
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&head, &(static_cast<foo*>(order[i])->list), NULL);
+        }
+
+        run("dlinkedlist_for_each", sum_for_each, &head, size);
+        run("dlinkedlist_typed_iterator<foo, &foo::list>", sum_typed_iterator,
+            &head, size);
+
+        free(order);
+        free(foos);
+    }
+    return 0;
+}
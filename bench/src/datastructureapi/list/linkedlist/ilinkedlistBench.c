@@ -0,0 +1,90 @@
+//
+//  ilinkedlistBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Compares scans of a pointer linked list and an index linked list whose
+//  containers live in an array, linked in shuffled order.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/list/ilinkedlist.h"
+
+/** Benchmarked data structure for the pointer linked list */
+struct foo {
+    uint32_t value;
+    struct dlinkedlist_node list;
+};
+
+/** Benchmarked data structure for the index linked list */
+struct bar {
+    uint32_t value;
+    struct ilinkedlist_node list;
+};
+
+static uint64_t scan_nodes(struct dlinkedlist_node* head) {
+    struct dlinkedlist_node* n;
+    uint64_t sum = 0;
+    dlinkedlist_for_each(head, n) {
+        sum += dlinkedlist_entry(n, struct foo, list)->value;
+    }
+    return sum;
+}
+
+static uint64_t scan_indices(const struct ilinkedlist_arena* arena,
+                             const struct ilinkedlist_head* head) {
+    uint32_t index;
+    uint64_t sum = 0;
+    ilinkedlist_for_each(arena, head, index) {
+        sum += ilinkedlist_entry(arena, index, struct bar)->value;
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    for (uint64_t size = 1 << 10; size <= max; size <<= 2) {
+        uint64_t rounds = bench_rounds(size);
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        struct bar* bars = (struct bar*) malloc(size * sizeof(struct bar));
+        void** order = (void**) malloc(size * sizeof(void*));
+        struct dlinkedlist_node head;
+        struct ilinkedlist_arena arena;
+        struct ilinkedlist_head ihead;
+        dlinkedlist_init_head(&head, NULL);
+        ilinkedlist_arena_init_type(&arena, bars, struct bar, list,
+                                    (uint32_t) size);
+        ilinkedlist_init_head(&ihead, NULL);
+        for (uint64_t i = 0; i < size; i++) {
+            foos[i].value = (uint32_t) i;
+            bars[i].value = (uint32_t) i;
+            order[i] = (void*) (uintptr_t) i;
+        }
+        bench_shuffle(order, (size_t) size, 0x9E3779B97F4A7C15ULL);
+        for (uint64_t i = 0; i < size; i++) {
+            uint32_t index = (uint32_t) (uintptr_t) order[i];
+            dlinkedlist_add_tail(&head, &(foos[index].list), NULL);
+            ilinkedlist_add_tail(&arena, &ihead, index, NULL);
+        }
+
+        uint64_t start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            bench_sink += (uintptr_t) scan_nodes(&head);
+        }
+        bench_report("dlinkedlist_for_each sizeof=24", size, rounds * size,
+                     bench_now_ns() - start);
+
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            bench_sink += (uintptr_t) scan_indices(&arena, &ihead);
+        }
+        bench_report("ilinkedlist_for_each sizeof=12", size, rounds * size,
+                     bench_now_ns() - start);
+
+        free(order);
+        free(bars);
+        free(foos);
+    }
+    return 0;
+}
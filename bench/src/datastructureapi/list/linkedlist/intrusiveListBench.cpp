@@ -0,0 +1,221 @@
+//
+//  intrusiveListBench.cpp
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Times datastructure::intrusive_list against the C API it wraps, on the
+//  same nodes:
+//  - dlinkedlist_add_tail vs push_back
+//  - dlinkedlist_for_each vs range-for vs std::accumulate
+//  - dlinkedlist_sort (comparator called through a pointer) vs sort
+//
+//  Each measurement is run for every node placement (see
+//  dlinkedlistPrimitivesBench.c). Both sides must compute the same results,
+//  otherwise the benchmark fails.
+//
+//  Traversals also report hardware counters per node when available (see
+//  datastructure/perf/perfcounters.h).
+//
+
+#include <numeric>
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist_sort.h"
+#include "datastructure/list/intrusive_list.hpp"
+
+/** Benchmarked data structure */
+struct foo {
+    uintptr_t bar;
+    struct dlinkedlist_node list;
+
+    bool operator<(const foo& other) const { return bar < other.bar; }
+};
+
+typedef datastructure::intrusive_list<foo, &foo::list> foo_list;
+
+#define FOO(objects, i) (static_cast<foo*>((objects)[i]))
+
+struct add_bar {
+    uintptr_t operator()(uintptr_t sum, const foo& f) const {
+        return sum + f.bar;
+    }
+};
+
+static int compare_foo(const struct dlinkedlist_node* a,
+                       const struct dlinkedlist_node* b, void* ctx) {
+    (void) ctx;
+    uintptr_t x = dlinkedlist_entry(a, struct foo, list)->bar;
+    uintptr_t y = dlinkedlist_entry(b, struct foo, list)->bar;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* op, const char* placement, uint64_t size,
+                   uint64_t items, uint64_t ns) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%s", op, placement);
+    bench_report(name, size, items, ns);
+}
+
+static void check(uintptr_t expected, uintptr_t actual, const char* op) {
+    if (expected != actual) {
+        fprintf(stderr, "%s: mismatch with dlinkedlist\n", op);
+        exit(1);
+    }
+}
+
+/**
+ *  Sets bars to pseudo random values, returns their sum
+ */
+static uintptr_t scramble(void** objects, uint64_t size) {
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    uintptr_t sum = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        FOO(objects, i)->bar = static_cast<uintptr_t>(x % size);
+        sum += FOO(objects, i)->bar;
+    }
+    return sum;
+}
+
+/**
+ *  Checksum depending on node order
+ */
+static uintptr_t ordered_sum(struct dlinkedlist_node* head) {
+    struct dlinkedlist_node* n;
+    uintptr_t sum = 0;
+    dlinkedlist_for_each(head, n) {
+        sum = sum * 31 + dlinkedlist_entry(n, struct foo, list)->bar;
+    }
+    return sum;
+}
+
+static void bench_add(void** objects, uint64_t size, const char* placement) {
+    uint64_t rounds = bench_rounds(size);
+    uint64_t c = 0, cpp = 0;
+    uint64_t start;
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct dlinkedlist_node head;
+        dlinkedlist_init_head(&head, NULL);
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&head, &(FOO(objects, i)->list), NULL);
+        }
+        c += bench_now_ns() - start;
+
+        foo_list list;
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            list.push_back(*FOO(objects, i));
+        }
+        cpp += bench_now_ns() - start;
+    }
+    report("dlinkedlist_add_tail", placement, size, rounds * size, c);
+    report("intrusive_list::push_back", placement, size, rounds * size, cpp);
+}
+
+static void bench_traversal(foo_list& list, uintptr_t expected, uint64_t size,
+                            const char* placement) {
+    uint64_t rounds = bench_rounds(size);
+    uint64_t start;
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        struct dlinkedlist_node* n;
+        uintptr_t sum = 0;
+        dlinkedlist_for_each(list.head(), n) {
+            sum += dlinkedlist_entry(n, struct foo, list)->bar;
+        }
+        check(expected, sum, "dlinkedlist_for_each");
+    }
+    report("dlinkedlist_for_each", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        uintptr_t sum = 0;
+        for (const foo& f : list) {
+            sum += f.bar;
+        }
+        check(expected, sum, "range-for");
+    }
+    report("intrusive_list range-for", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+
+    bench_counters_start();
+    start = bench_now_ns();
+    for (uint64_t r = 0; r < rounds; r++) {
+        uintptr_t sum = std::accumulate(list.cbegin(), list.cend(),
+                                        static_cast<uintptr_t>(0), add_bar());
+        check(expected, sum, "std::accumulate");
+    }
+    report("intrusive_list std::accumulate", placement, size, rounds * size,
+           bench_now_ns() - start);
+    bench_counters_report(rounds * size);
+}
+
+/**
+ *  Links objects in index order (bars are scrambled)
+ */
+static void relink(foo_list& list, void** objects, uint64_t size) {
+    list.clear();
+    for (uint64_t i = 0; i < size; i++) {
+        list.push_back(*FOO(objects, i));
+    }
+}
+
+static void bench_sort(void** objects, uint64_t size, const char* placement) {
+    uint64_t rounds = bench_rounds(size);
+    uint64_t c = 0, cpp = 0;
+    uint64_t start;
+    foo_list list;
+
+    // Both sorts start from the same order, equivalent nodes included
+    // (sorts are stable)
+    scramble(objects, size);
+    for (uint64_t r = 0; r < rounds; r++) {
+        relink(list, objects, size);
+        start = bench_now_ns();
+        dlinkedlist_sort(list.head(), compare_foo, NULL);
+        c += bench_now_ns() - start;
+        uintptr_t sorted = ordered_sum(list.head());
+
+        relink(list, objects, size);
+        start = bench_now_ns();
+        list.sort();
+        cpp += bench_now_ns() - start;
+        check(sorted, ordered_sum(list.head()), "intrusive_list::sort");
+    }
+    report("dlinkedlist_sort", placement, size, rounds * size, c);
+    report("intrusive_list::sort", placement, size, rounds * size, cpp);
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    bench_counters_open();
+    for (uint64_t size = 1 << 10; size <= max; size <<= 2) {
+        for (int p = 0; p < BENCH_PLACEMENTS; p++) {
+            const char* pname = bench_placement_name(p);
+            void** objects = bench_alloc_objects(static_cast<size_t>(size),
+                                                 sizeof(foo), p);
+            foo_list list;
+            uintptr_t sum = scramble(objects, size);
+
+            bench_add(objects, size, pname);
+            for (uint64_t i = 0; i < size; i++) {
+                list.push_back(*FOO(objects, i));
+            }
+            bench_traversal(list, sum, size, pname);
+            list.clear();
+            bench_sort(objects, size, pname);
+            bench_free_objects(objects, static_cast<size_t>(size), p);
+        }
+    }
+    return 0;
+}
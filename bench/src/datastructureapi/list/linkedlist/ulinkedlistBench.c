@@ -0,0 +1,123 @@
+//
+//  ulinkedlistBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Compares sequential scans of an array, an unrolled list (chunk by chunk
+//  and element by element) and a one node per element list whose nodes are
+//  scattered across the heap.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/list/ulinkedlist.h"
+
+/** Benchmarked data structure for the one node per element list */
+struct foo {
+    uint64_t value;
+    struct dlinkedlist_node list;
+};
+
+static uint64_t scan_array(const uint64_t* values, uint64_t size) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+static uint64_t scan_chunks(struct ulinkedlist* l) {
+    struct ulinkedlist_chunk* chunk;
+    uint64_t sum = 0;
+    ulinkedlist_for_each_chunk(l, chunk) {
+        const uint64_t* values = (const uint64_t*) ulinkedlist_chunk_data(chunk);
+        size_t count = ulinkedlist_chunk_count(chunk);
+        for (size_t i = 0; i < count; i++) {
+            sum += values[i];
+        }
+    }
+    return sum;
+}
+
+static uint64_t scan_elements(struct ulinkedlist* l) {
+    struct ulinkedlist_cursor c;
+    uint64_t* e;
+    uint64_t sum = 0;
+    ulinkedlist_for_each(l, c, e) {
+        sum += *e;
+    }
+    return sum;
+}
+
+static uint64_t scan_nodes(struct dlinkedlist_node* head) {
+    struct dlinkedlist_node* n;
+    uint64_t sum = 0;
+    dlinkedlist_for_each(head, n) {
+        sum += dlinkedlist_entry(n, struct foo, list)->value;
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 1 << 22);
+    size_t chunksizes[3] = {CACHE_LINE_SIZE, 0, 8 * CACHE_LINE_SIZE};
+    for (uint64_t size = 1 << 10; size <= max; size <<= 2) {
+        uint64_t rounds = bench_rounds(size);
+        uint64_t* values = (uint64_t*) malloc(size * sizeof(uint64_t));
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        void** order = (void**) malloc(size * sizeof(void*));
+        struct dlinkedlist_node head;
+        dlinkedlist_init_head(&head, NULL);
+        for (uint64_t i = 0; i < size; i++) {
+            values[i] = i;
+            foos[i].value = i;
+            order[i] = &(foos[i]);
+        }
+        bench_shuffle(order, (size_t) size, 0x9E3779B97F4A7C15ULL);
+        for (uint64_t i = 0; i < size; i++) {
+            dlinkedlist_add_tail(&head, &(((struct foo*) order[i])->list), NULL);
+        }
+
+        uint64_t start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            bench_sink += (uintptr_t) scan_array(values, size);
+        }
+        bench_report("array", size, rounds * size, bench_now_ns() - start);
+
+        for (int s = 0; s < 3; s++) {
+            char label[64];
+            struct ulinkedlist l;
+            ulinkedlist_init(&l, sizeof(uint64_t), chunksizes[s]);
+            for (uint64_t i = 0; i < size; i++) {
+                ulinkedlist_add_tail(&l, &i);
+            }
+            start = bench_now_ns();
+            for (uint64_t r = 0; r < rounds; r++) {
+                bench_sink += (uintptr_t) scan_chunks(&l);
+            }
+            snprintf(label, sizeof(label), "ulinkedlist_for_each_chunk chunk=%zu",
+                     (size_t) (chunksizes[s] ? chunksizes[s] : ULINKEDLIST_DEFAULT_CHUNK_SIZE));
+            bench_report(label, size, rounds * size, bench_now_ns() - start);
+            start = bench_now_ns();
+            for (uint64_t r = 0; r < rounds; r++) {
+                bench_sink += (uintptr_t) scan_elements(&l);
+            }
+            snprintf(label, sizeof(label), "ulinkedlist_for_each chunk=%zu",
+                     (size_t) (chunksizes[s] ? chunksizes[s] : ULINKEDLIST_DEFAULT_CHUNK_SIZE));
+            bench_report(label, size, rounds * size, bench_now_ns() - start);
+            ulinkedlist_free(&l);
+        }
+
+        start = bench_now_ns();
+        for (uint64_t r = 0; r < rounds; r++) {
+            bench_sink += (uintptr_t) scan_nodes(&head);
+        }
+        bench_report("dlinkedlist_for_each (shuffled)", size, rounds * size,
+                     bench_now_ns() - start);
+
+        free(order);
+        free(foos);
+        free(values);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+//
+//  mpscqueueBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Measures items handed from P producer threads to one consumer thread
+//  through mpscqueue, against dlinkedlist_add_tail guarded by a mutex.
+//
+
+#include <unistd.h>
+#include <pthread.h>
+#include "BenchRunner.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/queue/mpscqueue.h"
+
+/** Benchmarked data structure */
+struct foo {
+    uint64_t value;
+    struct dlinkedlist_node list;
+};
+
+struct shared {
+    struct mpscqueue queue;
+    pthread_mutex_t lock;
+    struct dlinkedlist_node locked;
+    int uselock;
+};
+
+struct producer {
+    struct shared* shared;
+    struct foo* foos;
+    uint64_t count;
+    pthread_t thread;
+};
+
+static void* produce(void* arg) {
+    struct producer* p = (struct producer*) arg;
+    for (uint64_t i = 0; i < p->count; i++) {
+        if (p->shared->uselock) {
+            pthread_mutex_lock(&(p->shared->lock));
+            dlinkedlist_add_tail(&(p->shared->locked), &(p->foos[i].list), NULL);
+            pthread_mutex_unlock(&(p->shared->lock));
+        } else {
+            mpscqueue_push(&(p->shared->queue), &(p->foos[i].list));
+        }
+    }
+    return NULL;
+}
+
+static uint64_t consume(struct shared* shared, struct dlinkedlist_node* batch) {
+    uint64_t count = 0;
+    struct dlinkedlist_node* n;
+    dlinkedlist_init_head(batch, NULL);
+    if (shared->uselock) {
+        pthread_mutex_lock(&(shared->lock));
+        if (!dlinkedlist_empty(&(shared->locked))) {
+            dlinkedlist_splice(&(shared->locked), batch, NULL, NULL);
+            dlinkedlist_init_head(&(shared->locked), NULL);
+        }
+        pthread_mutex_unlock(&(shared->lock));
+    } else {
+        mpscqueue_take_all(&(shared->queue), batch, NULL);
+    }
+    dlinkedlist_for_each(batch, n) {
+        bench_sink += (uintptr_t) dlinkedlist_entry(n, struct foo, list)->value;
+        count++;
+    }
+    return count;
+}
+
+static void run(const char* name, struct shared* shared, struct foo* foos,
+                uint64_t size, unsigned int producers) {
+    char label[64];
+    struct producer* p = (struct producer*) malloc(producers * sizeof(struct producer));
+    struct dlinkedlist_node batch;
+    uint64_t received = 0;
+    uint64_t start = bench_now_ns();
+    for (unsigned int i = 0; i < producers; i++) {
+        p[i].shared = shared;
+        p[i].foos = foos + i * (size / producers);
+        p[i].count = size / producers;
+        pthread_create(&(p[i].thread), NULL, produce, &(p[i]));
+    }
+    while (received < (size / producers) * producers) {
+        received += consume(shared, &batch);
+    }
+    for (unsigned int i = 0; i < producers; i++) {
+        pthread_join(p[i].thread, NULL);
+    }
+    snprintf(label, sizeof(label), "%s producers=%u", name, producers);
+    bench_report(label, size, received, bench_now_ns() - start);
+    free(p);
+}
+
+int main(int argc, char** argv) {
+    uint64_t size = bench_max_size(argc, argv, 1 << 22);
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int cores = online > 1 ? (unsigned int) online : 2;
+    struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+    struct shared shared;
+    for (uint64_t i = 0; i < size; i++) {
+        foos[i].value = i;
+    }
+    mpscqueue_init(&(shared.queue));
+    pthread_mutex_init(&(shared.lock), NULL);
+    dlinkedlist_init_head(&(shared.locked), NULL);
+    for (unsigned int producers = 1; producers < cores; producers <<= 1) {
+        shared.uselock = 1;
+        run("mutex + dlinkedlist_add_tail", &shared, foos, size, producers);
+        shared.uselock = 0;
+        run("mpscqueue_push", &shared, foos, size, producers);
+    }
+    pthread_mutex_destroy(&(shared.lock));
+    free(foos);
+    return 0;
+}
@@ -0,0 +1,85 @@
+//
+//  timerwheelBench.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Measures arming, re-arming (timeout reset), cancelling and expiring
+//  timers on a timing wheel holding up to 10M timers, with expiries spread
+//  over 2^20 ticks.
+//
+
+#include "BenchRunner.h"
+#include "datastructure/timer/timerwheel.h"
+
+#define BENCH_TICKS (1 << 20)
+
+/** Benchmarked data structure */
+struct foo {
+    uint64_t id;
+    struct timerwheel_timer timer;
+};
+
+static uint64_t next_random(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+int main(int argc, char** argv) {
+    uint64_t max = bench_max_size(argc, argv, 10000000);
+    for (uint64_t size = 10000; size <= max; size *= 10) {
+        struct foo* foos = (struct foo*) malloc(size * sizeof(struct foo));
+        if (foos == NULL) {return 1;}
+        struct timerwheel* wheel = (struct timerwheel*) malloc(
+                                                    sizeof(struct timerwheel));
+        struct dlinkedlist_node expired;
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        timerwheel_init(wheel, 0);
+        dlinkedlist_init_head(&expired, NULL);
+        for (uint64_t i = 0; i < size; i++) {
+            foos[i].id = i;
+            timerwheel_timer_init(&(foos[i].timer));
+        }
+
+        uint64_t start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            timerwheel_arm(wheel, &(foos[i].timer),
+                           1 + next_random(&seed) % (BENCH_TICKS - 1));
+        }
+        bench_report("timerwheel_arm", size, size, bench_now_ns() - start);
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i++) {
+            timerwheel_arm(wheel, &(foos[i].timer),
+                           1 + next_random(&seed) % (BENCH_TICKS - 1));
+        }
+        bench_report("timerwheel_arm (re-arm pending)", size, size,
+                     bench_now_ns() - start);
+
+        start = bench_now_ns();
+        for (uint64_t i = 0; i < size; i += 2) {
+            timerwheel_cancel(wheel, &(foos[i].timer));
+        }
+        bench_report("timerwheel_cancel", size, size / 2,
+                     bench_now_ns() - start);
+
+        uint64_t fired = 0;
+        start = bench_now_ns();
+        for (uint64_t tick = 0; tick < BENCH_TICKS; tick++) {
+            fired += timerwheel_advance(wheel, tick, &expired);
+            struct timerwheel_timer* timer;
+            while ((timer = timerwheel_take(&expired)) != NULL) {
+                bench_sink += (uintptr_t) timerwheel_entry(timer, struct foo,
+                                                           timer)->id;
+            }
+        }
+        bench_report("timerwheel_advance per expired timer", size, fired,
+                     bench_now_ns() - start);
+
+        free(wheel);
+        free(foos);
+    }
+    return 0;
+}
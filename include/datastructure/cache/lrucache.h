@@ -0,0 +1,444 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Intrusive least recently used (LRU) cache
+ *
+ *  Containers embed a struct lrucache_node, indexed by a struct hashmap and
+ *  kept in recency order (most recently used first) by a struct
+ *  dlinkedlist_node. Hits move the container to the front of the recency
+ *  list; entries are evicted from its back once the cache holds more
+ *  entries than its capacity or more charge (e.g bytes) than its budget.
+ *
+ *  Promotion may be lazy: hits then only move entries which are not among
+ *  the most recently moved ones, saving writes on hot entries (see
+ *  lrucache_set_promotion).
+ *
+ *  The cache never allocates containers: containers it drops on its own
+ *  (evicted, replaced, left at lrucache_free) are handed to the eviction
+ *  callback.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_CACHE_LRUCACHE_H_
+#define INCLUDE_DATASTRUCTURE_CACHE_LRUCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/hash/hashmap.h"
+
+/**
+ *  A cache node
+ */
+struct lrucache_node {
+    struct hashmap_node _hash;          /** Index link */
+    struct dlinkedlist_node _lru;       /** Recency link */
+    _UINT_LEAST_64_T _charge;           /** Entry's charge */
+    _UINT_LEAST_64_T _stamp;            /** Cache's clock when last moved */
+};
+
+/**
+ *  Cache counters
+ */
+struct lrucache_stats {
+    _UINT_LEAST_64_T hits;              /** Lookups finding an entry */
+    _UINT_LEAST_64_T misses;            /** Lookups finding no entry */
+    _UINT_LEAST_64_T evictions;         /** Entries dropped by the cache */
+};
+
+/**
+ *  Tests if a container matches a key
+ *
+ *  \param node Node embedded in the container
+ *  \param key Key
+ *
+ *  \return non 0 iff node matches
+ */
+typedef int (*lrucache_match)(const struct lrucache_node* node,
+                              const void* key);
+
+/**
+ *  Called on every container the cache drops on its own. The container is
+ *  not in the cache anymore and may be freed.
+ *
+ *  \param node Node embedded in the container
+ *  \param ctx Caller provided context
+ */
+typedef void (*lrucache_evict)(struct lrucache_node* node, void* ctx);
+
+/**
+ *  A cache
+ */
+struct lrucache {
+    struct hashmap _index;              /** Entries by key */
+    struct dlinkedlist_node _lru;       /** Entries, most recently used first */
+    lrucache_match _match;              /** Key matcher */
+    lrucache_evict _evict;              /** Eviction callback. NULL permitted */
+    void* _ctx;                         /** Eviction callback's context */
+    _UINT_LEAST_64_T _capacity;         /** Maximum entries. 0 if unbounded */
+    _UINT_LEAST_64_T _budget;           /** Maximum charge. 0 if unbounded */
+    _UINT_LEAST_64_T _charge;           /** Sum of entries' charge */
+    _UINT_LEAST_64_T _clock;            /** Number of entries moved to front */
+    _UINT_LEAST_64_T _promotion;        /** Minimum age of promoted entries */
+    struct lrucache_stats _stats;       /** Counters */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ * Get the struc for this entry
+ *
+ * Time Complexity: O(1)
+ * Space Complexity: O(0)
+ *
+ * \param ptr Pointer to the struct lrucache_node
+ * \param containertype Type of the struct ptr is embedded in
+ * \param member Name of the struct lrucache_node within containertype
+ */
+#define lrucache_entry(ptr, containertype, member)                             \
+    __dlinkedlist_container_of(ptr, containertype, member)
+
+/**
+ *  Iterates over cache's entries, most recently used first. The cache MUST
+ *  NOT be modified while iterating.
+ *
+ *  \param cache Cache
+ *  \param node the &struct dlinkedlist_node to use as a loop cursor. Use
+ *              lrucache_node to get the struct lrucache_node
+ */
+#define lrucache_for_each(cache, node)                                        \
+    dlinkedlist_for_each(&((cache)->_lru), node)
+
+/**
+ *  Gets the cache node a recency list node is embedded in
+ *
+ *  \param node Recency list node
+ *  \return Cache node
+ */
+static inline struct lrucache_node* lrucache_node(struct dlinkedlist_node* node) {
+    ASSERT(node != NULL)
+    return dlinkedlist_entry(node, struct lrucache_node, _lru);
+}
+
+/**
+ *  Initializes an empty cache
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ *  \param capacity Maximum number of entries. 0 if unbounded
+ *  \param budget Maximum sum of entries' charge. 0 if unbounded
+ *  \param match Key matcher
+ *  \param evict Eviction callback. NULL permitted
+ *  \param ctx evict's context. NULL permitted
+ *  \return 0 iff no memory is available
+ */
+static inline int lrucache_init(struct lrucache* cache,
+                                _UINT_LEAST_64_T capacity,
+                                _UINT_LEAST_64_T budget,
+                                lrucache_match match,
+                                lrucache_evict evict,
+                                void* ctx) {
+    ASSERT(cache != NULL)
+    ASSERT(match != NULL)
+    dlinkedlist_init_head(&(cache->_lru), NULL);
+    cache->_match = match;
+    cache->_evict = evict;
+    cache->_ctx = ctx;
+    cache->_capacity = capacity;
+    cache->_budget = budget;
+    cache->_charge = 0;
+    cache->_clock = 0;
+    cache->_promotion = 0;
+    cache->_stats.hits = 0;
+    cache->_stats.misses = 0;
+    cache->_stats.evictions = 0;
+    return hashmap_init(&(cache->_index), 16);
+}
+
+/**
+ *  Sets how lazily hits promote entries. An entry is moved to the front
+ *  on a hit only if more than age entries were moved to the front since it
+ *  last was, i.e. only if it is not among the age most recently moved
+ *  entries. 0 (the default) moves every hit entry.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param age Minimum age. A fraction of the capacity (e.g. 1/4) keeps
+ *              recency close to strict LRU
+ */
+static inline void lrucache_set_promotion(struct lrucache* cache,
+                                          _UINT_LEAST_64_T age) {
+    ASSERT(cache != NULL)
+    cache->_promotion = age;
+}
+
+/**
+ *  Gets the number of entries
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T lrucache_size(const struct lrucache* cache) {
+    ASSERT(cache != NULL)
+    return hashmap_size(&(cache->_index));
+}
+
+/**
+ *  Gets the sum of entries' charge
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return charge
+ */
+static inline _UINT_LEAST_64_T lrucache_charge(const struct lrucache* cache) {
+    ASSERT(cache != NULL)
+    return cache->_charge;
+}
+
+/**
+ *  Gets cache's counters
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return Counters
+ */
+static inline const struct lrucache_stats* lrucache_stats(
+                                            const struct lrucache* cache) {
+    ASSERT(cache != NULL)
+    return &(cache->_stats);
+}
+
+/**
+ *  Resets cache's counters
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ */
+static inline void lrucache_stats_reset(struct lrucache* cache) {
+    ASSERT(cache != NULL)
+    cache->_stats.hits = 0;
+    cache->_stats.misses = 0;
+    cache->_stats.evictions = 0;
+}
+
+/**
+ *  Finds an entry without touching recency nor counters
+ *
+ *  Time Complexity:    O(1) average
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \param key Key
+ *  \return Entry. NULL iff none
+ */
+static inline struct lrucache_node* lrucache_peek(const struct lrucache* cache,
+                                                  uint64_t hash,
+                                                  const void* key) {
+    ASSERT(cache != NULL)
+    struct hashmap_node* node;
+    hashmap_for_each_possible(&(cache->_index), node, hash) {
+        if (node->_hash != hash) {continue;}
+        struct lrucache_node* entry = dlinkedlist_entry(node,
+                                                        struct lrucache_node,
+                                                        _hash);
+        if (cache->_match(entry, key)) {return entry;}
+    }
+    return NULL;
+}
+
+/**
+ *  Removes an entry. The eviction callback is NOT called.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param node Entry
+ */
+static inline void lrucache_remove(struct lrucache* cache,
+                                   struct lrucache_node* node) {
+    ASSERT(cache != NULL)
+    ASSERT(node != NULL)
+    hashmap_remove(&(cache->_index), &(node->_hash));
+    dlinkedlist_remove_from(&(cache->_lru), &(node->_lru), NULL);
+    cache->_charge -= node->_charge;
+}
+
+/**
+ *  Drops an entry and hands it to the eviction callback
+ */
+static inline void __lrucache_evict(struct lrucache* cache,
+                                    struct lrucache_node* node) {
+    lrucache_remove(cache, node);
+    cache->_stats.evictions++;
+    if (cache->_evict != NULL) {cache->_evict(node, cache->_ctx);}
+}
+
+/**
+ *  Evicts least recently used entries other than keep until capacity and
+ *  budget are honoured
+ */
+static inline void __lrucache_trim(struct lrucache* cache,
+                                   struct lrucache_node* keep) {
+    while (!dlinkedlist_empty(&(cache->_lru))
+           && ((cache->_capacity != 0
+                && lrucache_size(cache) > cache->_capacity)
+               || (cache->_budget != 0 && cache->_charge > cache->_budget))) {
+        struct lrucache_node* lru = lrucache_node(cache->_lru.prev);
+        if (lru == keep) {break;}
+        __lrucache_evict(cache, lru);
+    }
+}
+
+/**
+ *  Finds an entry and marks it as the most recently used one, subject to
+ *  lazy promotion. Counts a hit or a miss.
+ *
+ *  Time Complexity:    O(1) average
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \param key Key
+ *  \return Entry. NULL iff none
+ */
+static inline struct lrucache_node* lrucache_get(struct lrucache* cache,
+                                                 uint64_t hash,
+                                                 const void* key) {
+    ASSERT(cache != NULL)
+    struct lrucache_node* node = lrucache_peek(cache, hash, key);
+    if (node == NULL) {
+        cache->_stats.misses++;
+        return NULL;
+    }
+    cache->_stats.hits++;
+    if (cache->_clock - node->_stamp > cache->_promotion) {
+        dlinkedlist_remove_from(&(cache->_lru), &(node->_lru), NULL);
+        dlinkedlist_add_head(&(cache->_lru), &(node->_lru), NULL);
+        node->_stamp = ++(cache->_clock);
+    }
+    return node;
+}
+
+/**
+ *  Adds an entry as the most recently used one. An entry with the same key
+ *  is replaced. Least recently used entries are then evicted as long as the
+ *  cache exceeds its capacity or budget; an entry whose charge alone
+ *  exceeds the budget is kept (alone).
+ *
+ *  Time Complexity:    O(1) amortized, O(e) with e evicted entries
+ *  Space Complexity:   O(1) amortized
+ *
+ *  \param cache Cache
+ *  \param node Entry to add. MUST NOT be in a cache
+ *  \param hash Key's hash
+ *  \param key Entry's key
+ *  \param charge Entry's charge
+ */
+static inline void lrucache_put(struct lrucache* cache,
+                                struct lrucache_node* node,
+                                uint64_t hash,
+                                const void* key,
+                                _UINT_LEAST_64_T charge) {
+    ASSERT(cache != NULL)
+    ASSERT(node != NULL)
+    struct lrucache_node* old = lrucache_peek(cache, hash, key);
+    if (old != NULL) {__lrucache_evict(cache, old);}
+    node->_charge = charge;
+    node->_stamp = ++(cache->_clock);
+    hashmap_add(&(cache->_index), &(node->_hash), hash);
+    dlinkedlist_add_head(&(cache->_lru), &(node->_lru), NULL);
+    cache->_charge += charge;
+    __lrucache_trim(cache, node);
+}
+
+/**
+ *  Changes capacity and budget, evicting entries as needed.
+ *
+ *  Time Complexity:    O(e) with e evicted entries
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ *  \param capacity Maximum number of entries. 0 if unbounded
+ *  \param budget Maximum sum of entries' charge. 0 if unbounded
+ */
+static inline void lrucache_resize(struct lrucache* cache,
+                                   _UINT_LEAST_64_T capacity,
+                                   _UINT_LEAST_64_T budget) {
+    ASSERT(cache != NULL)
+    cache->_capacity = capacity;
+    cache->_budget = budget;
+    __lrucache_trim(cache, NULL);
+}
+
+/**
+ *  Evicts every entry, least recently used first
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ */
+static inline void lrucache_clear(struct lrucache* cache) {
+    ASSERT(cache != NULL)
+    while (!dlinkedlist_empty(&(cache->_lru))) {
+        __lrucache_evict(cache, lrucache_node(cache->_lru.prev));
+    }
+}
+
+/**
+ *  Evicts every entry and frees cache's memory
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ */
+static inline void lrucache_free(struct lrucache* cache) {
+    ASSERT(cache != NULL)
+    lrucache_clear(cache);
+    hashmap_free(&(cache->_index));
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_CACHE_LRUCACHE_H_
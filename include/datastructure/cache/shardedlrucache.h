@@ -0,0 +1,362 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Thread safe sharded least recently used (LRU) cache
+ *
+ *  Keys hash to one of a power of two number of shards. Each shard is an
+ *  independent struct lrucache (own index, own recency list, own share of
+ *  capacity and budget) guarded by its own mutex, so that threads working
+ *  on distinct shards do not contend. Recency is per shard: the evicted
+ *  entry is the least recently used one of its shard.
+ *
+ *  Entries MUST only be accessed while their shard is locked: either
+ *  through the visitor of shardedlrucache_get or between
+ *  shardedlrucache_lock/shardedlrucache_unlock. Eviction callbacks run with
+ *  the shard locked.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_CACHE_SHARDEDLRUCACHE_H_
+#define INCLUDE_DATASTRUCTURE_CACHE_SHARDEDLRUCACHE_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "datastructure/macros.h"
+#include "datastructure/memory/aligned.h"
+#include "datastructure/cache/lrucache.h"
+
+/**
+ *  A shard
+ */
+struct __shardedlrucache_shard {
+    pthread_mutex_t _lock;
+    struct lrucache _cache;
+};
+
+/**
+ *  A shard padded to a multiple of the cache line size. Shards are
+ *  allocated on a cache line boundary, so that distinct shards' hot fields
+ *  do not share a cache line.
+ */
+union __shardedlrucache_slot {
+    struct __shardedlrucache_shard _shard;
+    char _pad[ALIGN_UP(sizeof(struct __shardedlrucache_shard),
+                       CACHE_LINE_SIZE)];
+};
+
+/**
+ *  A sharded cache
+ */
+struct shardedlrucache {
+    union __shardedlrucache_slot* _shards;      /** Shards */
+    size_t _mask;                               /** Number of shards - 1 */
+};
+
+/**
+ *  Called on a found entry, with its shard locked
+ *
+ *  \param node Entry
+ *  \param arg Caller provided argument
+ */
+typedef void (*shardedlrucache_visit)(struct lrucache_node* node, void* arg);
+
+EXTERN_C_BEGIN
+
+/**
+ *  Initializes an empty cache. Capacity and budget are evenly split among
+ *  shards (rounded up).
+ *
+ *  Time Complexity:    O(s), s being the number of shards
+ *  Space Complexity:   O(s)
+ *
+ *  \param cache Cache
+ *  \param shards Minimum number of shards. Rounded up to a power of 2
+ *  \param capacity Maximum number of entries. 0 if unbounded
+ *  \param budget Maximum sum of entries' charge. 0 if unbounded
+ *  \param match Key matcher
+ *  \param evict Eviction callback. NULL permitted
+ *  \param ctx evict's context. NULL permitted
+ *  \return 0 iff no memory is available
+ */
+static inline int shardedlrucache_init(struct shardedlrucache* cache,
+                                       size_t shards,
+                                       _UINT_LEAST_64_T capacity,
+                                       _UINT_LEAST_64_T budget,
+                                       lrucache_match match,
+                                       lrucache_evict evict,
+                                       void* ctx) {
+    ASSERT(cache != NULL)
+    size_t count = 1;
+    while (count < shards) {count <<= 1;}
+    cache->_shards = (union __shardedlrucache_slot*) __cache_aligned_malloc(
+                            count * sizeof(union __shardedlrucache_slot));
+    cache->_mask = 0;
+    if (cache->_shards == NULL) {return 0;}
+    for (size_t i = 0; i < count; i++) {
+        struct __shardedlrucache_shard* shard = &(cache->_shards[i]._shard);
+        if (!lrucache_init(&(shard->_cache), (capacity + count - 1) / count,
+                           (budget + count - 1) / count, match, evict, ctx)) {
+            while (i-- > 0) {
+                lrucache_free(&(cache->_shards[i]._shard._cache));
+                pthread_mutex_destroy(&(cache->_shards[i]._shard._lock));
+            }
+            __cache_aligned_free(cache->_shards);
+            cache->_shards = NULL;
+            return 0;
+        }
+        pthread_mutex_init(&(shard->_lock), NULL);
+    }
+    cache->_mask = count - 1;
+    return 1;
+}
+
+/**
+ *  Evicts every entry and frees cache's memory. No other thread may use
+ *  the cache.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ */
+static inline void shardedlrucache_free(struct shardedlrucache* cache) {
+    ASSERT(cache != NULL)
+    if (cache->_shards == NULL) {return;}
+    for (size_t i = 0; i <= cache->_mask; i++) {
+        lrucache_free(&(cache->_shards[i]._shard._cache));
+        pthread_mutex_destroy(&(cache->_shards[i]._shard._lock));
+    }
+    __cache_aligned_free(cache->_shards);
+    cache->_shards = NULL;
+    cache->_mask = 0;
+}
+
+/**
+ *  Gets the number of shards
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return Number of shards
+ */
+static inline size_t shardedlrucache_shard_count(
+                                        const struct shardedlrucache* cache) {
+    ASSERT(cache != NULL)
+    return cache->_mask + 1;
+}
+
+/**
+ *  Gets the shard a hash belongs to. Both halves of hash are folded then
+ *  multiplied by 2^64 / golden ratio, so that 32 bits hashes spread over
+ *  all shards too. Shards are selected by the product's high bits.
+ */
+static inline struct __shardedlrucache_shard* __shardedlrucache_shard(
+                                        const struct shardedlrucache* cache,
+                                        uint64_t hash) {
+    ASSERT(cache->_shards != NULL)
+    uint64_t mixed = (hash ^ (hash >> 32)) * UINT64_C(0x9E3779B97F4A7C15);
+    return &(cache->_shards[(size_t) (mixed >> 32) & cache->_mask]._shard);
+}
+
+/**
+ *  Locks the shard a hash belongs to
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \return Shard's cache, to use until shardedlrucache_unlock
+ */
+static inline struct lrucache* shardedlrucache_lock(
+                                        struct shardedlrucache* cache,
+                                        uint64_t hash) {
+    ASSERT(cache != NULL)
+    struct __shardedlrucache_shard* shard = __shardedlrucache_shard(cache, hash);
+    pthread_mutex_lock(&(shard->_lock));
+    return &(shard->_cache);
+}
+
+/**
+ *  Unlocks the shard a hash belongs to
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash, as passed to shardedlrucache_lock
+ */
+static inline void shardedlrucache_unlock(struct shardedlrucache* cache,
+                                          uint64_t hash) {
+    ASSERT(cache != NULL)
+    pthread_mutex_unlock(&(__shardedlrucache_shard(cache, hash)->_lock));
+}
+
+/**
+ *  Sets how lazily hits promote entries in every shard (see
+ *  lrucache_set_promotion). age is split among shards like capacity.
+ *
+ *  Time Complexity:    O(s), s being the number of shards
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param age Minimum age, for the whole cache
+ */
+static inline void shardedlrucache_set_promotion(struct shardedlrucache* cache,
+                                                 _UINT_LEAST_64_T age) {
+    ASSERT(cache != NULL)
+    for (size_t i = 0; i <= cache->_mask; i++) {
+        struct __shardedlrucache_shard* shard = &(cache->_shards[i]._shard);
+        pthread_mutex_lock(&(shard->_lock));
+        lrucache_set_promotion(&(shard->_cache), age / (cache->_mask + 1));
+        pthread_mutex_unlock(&(shard->_lock));
+    }
+}
+
+/**
+ *  Finds an entry, marks it as recently used and visits it
+ *
+ *  Time Complexity:    O(1) average
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \param key Key
+ *  \param visit Called on the entry, shard locked. NULL permitted
+ *  \param arg visit's argument. NULL permitted
+ *  \return 0 iff no entry matches
+ */
+static inline int shardedlrucache_get(struct shardedlrucache* cache,
+                                      uint64_t hash,
+                                      const void* key,
+                                      shardedlrucache_visit visit,
+                                      void* arg) {
+    struct lrucache* shard = shardedlrucache_lock(cache, hash);
+    struct lrucache_node* node = lrucache_get(shard, hash, key);
+    if (node != NULL && visit != NULL) {visit(node, arg);}
+    shardedlrucache_unlock(cache, hash);
+    return node != NULL;
+}
+
+/**
+ *  Adds an entry (see lrucache_put)
+ *
+ *  Time Complexity:    O(1) amortized, O(e) with e evicted entries
+ *  Space Complexity:   O(1) amortized
+ *
+ *  \param cache Cache
+ *  \param node Entry to add. MUST NOT be in a cache
+ *  \param hash Key's hash
+ *  \param key Entry's key
+ *  \param charge Entry's charge
+ */
+static inline void shardedlrucache_put(struct shardedlrucache* cache,
+                                       struct lrucache_node* node,
+                                       uint64_t hash,
+                                       const void* key,
+                                       _UINT_LEAST_64_T charge) {
+    struct lrucache* shard = shardedlrucache_lock(cache, hash);
+    lrucache_put(shard, node, hash, key, charge);
+    shardedlrucache_unlock(cache, hash);
+}
+
+/**
+ *  Removes the entry matching a key and hands it to the eviction callback
+ *
+ *  Time Complexity:    O(1) average
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \param key Key
+ *  \return 0 iff no entry matches
+ */
+static inline int shardedlrucache_erase(struct shardedlrucache* cache,
+                                        uint64_t hash,
+                                        const void* key) {
+    struct lrucache* shard = shardedlrucache_lock(cache, hash);
+    struct lrucache_node* node = lrucache_peek(shard, hash, key);
+    if (node != NULL) {__lrucache_evict(shard, node);}
+    shardedlrucache_unlock(cache, hash);
+    return node != NULL;
+}
+
+/**
+ *  Gets the number of entries. Shards are locked one at a time: the result
+ *  is not a snapshot while other threads modify the cache.
+ *
+ *  Time Complexity:    O(s), s being the number of shards
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T shardedlrucache_size(
+                                            struct shardedlrucache* cache) {
+    ASSERT(cache != NULL)
+    _UINT_LEAST_64_T size = 0;
+    for (size_t i = 0; i <= cache->_mask; i++) {
+        struct __shardedlrucache_shard* shard = &(cache->_shards[i]._shard);
+        pthread_mutex_lock(&(shard->_lock));
+        size += lrucache_size(&(shard->_cache));
+        pthread_mutex_unlock(&(shard->_lock));
+    }
+    return size;
+}
+
+/**
+ *  Sums shards' counters. Shards are locked one at a time.
+ *
+ *  Time Complexity:    O(s), s being the number of shards
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param stats Receives counters
+ */
+static inline void shardedlrucache_stats(struct shardedlrucache* cache,
+                                         struct lrucache_stats* stats) {
+    ASSERT(cache != NULL)
+    ASSERT(stats != NULL)
+    stats->hits = 0;
+    stats->misses = 0;
+    stats->evictions = 0;
+    for (size_t i = 0; i <= cache->_mask; i++) {
+        struct __shardedlrucache_shard* shard = &(cache->_shards[i]._shard);
+        pthread_mutex_lock(&(shard->_lock));
+        stats->hits += lrucache_stats(&(shard->_cache))->hits;
+        stats->misses += lrucache_stats(&(shard->_cache))->misses;
+        stats->evictions += lrucache_stats(&(shard->_cache))->evictions;
+        pthread_mutex_unlock(&(shard->_lock));
+    }
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_CACHE_SHARDEDLRUCACHE_H_
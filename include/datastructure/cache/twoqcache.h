@@ -0,0 +1,505 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Intrusive scan resistant cache (2Q replacement policy, T. Johnson and
+ *  D. Shasha)
+ *
+ *  Containers embed a struct twoqcache_node, indexed by a struct hashmap
+ *  and kept in one of two queues (struct dlinkedlist_node lists):
+ *  - in: entries seen once, FIFO. Hits do not move them.
+ *  - main: entries seen again, LRU. Hits move them to the front.
+ *  Entries evicted from in leave a ghost (their key's hash only) in a
+ *  bounded out FIFO. A put whose key has a ghost goes straight to main.
+ *  A sequential scan thus only churns in and out: main's entries survive.
+ *
+ *  Eviction takes in's oldest entry while in exceeds its share of the
+ *  capacity, main's least recently used entry otherwise.
+ *
+ *  Ghosts are matched by hash only: distinct keys with equal hashes share
+ *  ghosts. Ghost records come from a struct dlinkedlist_pool.
+ *
+ *  The cache never allocates containers: containers it drops on its own
+ *  (evicted, replaced, left at twoqcache_free) are handed to the eviction
+ *  callback.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_CACHE_TWOQCACHE_H_
+#define INCLUDE_DATASTRUCTURE_CACHE_TWOQCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_pool.h"
+#include "datastructure/hash/hashmap.h"
+
+/**
+ *  Share of the capacity in may hold, as a divisor (4: a quarter)
+ */
+#ifndef TWOQCACHE_IN_DIVISOR
+    #define TWOQCACHE_IN_DIVISOR 4
+#endif
+
+/**
+ *  Number of ghosts kept, as a divisor of the capacity (2: half)
+ */
+#ifndef TWOQCACHE_OUT_DIVISOR
+    #define TWOQCACHE_OUT_DIVISOR 2
+#endif
+
+/**
+ *  Queues
+ */
+#define __TWOQCACHE_IN      0
+#define __TWOQCACHE_MAIN    1
+
+/**
+ *  A cache node
+ */
+struct twoqcache_node {
+    struct hashmap_node _hash;          /** Index link */
+    struct dlinkedlist_node _queue;     /** Queue link */
+    int _in;                            /** __TWOQCACHE_IN or __TWOQCACHE_MAIN */
+};
+
+/**
+ *  A ghost: the hash of a key recently evicted from in
+ */
+struct __twoqcache_ghost {
+    struct hashmap_node _hash;          /** Ghost index link */
+    struct dlinkedlist_node _out;       /** out FIFO link, pool link */
+};
+
+/**
+ *  Cache counters
+ */
+struct twoqcache_stats {
+    _UINT_LEAST_64_T hits;              /** Lookups finding an entry */
+    _UINT_LEAST_64_T misses;            /** Lookups finding no entry */
+    _UINT_LEAST_64_T evictions;         /** Entries dropped by the cache */
+    _UINT_LEAST_64_T ghosthits;         /** Puts admitted to main by a ghost */
+};
+
+/**
+ *  Tests if a container matches a key
+ *
+ *  \param node Node embedded in the container
+ *  \param key Key
+ *
+ *  \return non 0 iff node matches
+ */
+typedef int (*twoqcache_match)(const struct twoqcache_node* node,
+                               const void* key);
+
+/**
+ *  Called on every container the cache drops on its own. The container is
+ *  not in the cache anymore and may be freed.
+ *
+ *  \param node Node embedded in the container
+ *  \param ctx Caller provided context
+ */
+typedef void (*twoqcache_evict)(struct twoqcache_node* node, void* ctx);
+
+/**
+ *  A cache
+ */
+struct twoqcache {
+    struct hashmap _index;              /** Entries by key */
+    struct hashmap _ghosts;             /** Ghosts by hash */
+    struct dlinkedlist_node _inq;       /** in entries, newest first */
+    struct dlinkedlist_node _mainq;     /** main entries, most recently used first */
+    struct dlinkedlist_node _outq;      /** Ghosts, newest first */
+    struct dlinkedlist_pool _pool;      /** Ghost records */
+    twoqcache_match _match;             /** Key matcher */
+    twoqcache_evict _evict;             /** Eviction callback. NULL permitted */
+    void* _ctx;                         /** Eviction callback's context */
+    _UINT_LEAST_64_T _capacity;         /** Maximum entries */
+    _UINT_LEAST_64_T _incapacity;       /** Maximum in entries before main is evicted */
+    _UINT_LEAST_64_T _outcapacity;      /** Maximum ghosts */
+    _UINT_LEAST_64_T _insize;           /** Number of in entries */
+    _UINT_LEAST_64_T _outsize;          /** Number of ghosts */
+    struct twoqcache_stats _stats;      /** Counters */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ * Get the struc for this entry
+ *
+ * Time Complexity: O(1)
+ * Space Complexity: O(0)
+ *
+ * \param ptr Pointer to the struct twoqcache_node
+ * \param containertype Type of the struct ptr is embedded in
+ * \param member Name of the struct twoqcache_node within containertype
+ */
+#define twoqcache_entry(ptr, containertype, member)                            \
+    __dlinkedlist_container_of(ptr, containertype, member)
+
+/**
+ *  Initializes an empty cache
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ *  \param capacity Maximum number of entries. Must be > 0
+ *  \param match Key matcher
+ *  \param evict Eviction callback. NULL permitted
+ *  \param ctx evict's context. NULL permitted
+ *  \return 0 iff no memory is available
+ */
+static inline int twoqcache_init(struct twoqcache* cache,
+                                 _UINT_LEAST_64_T capacity,
+                                 twoqcache_match match,
+                                 twoqcache_evict evict,
+                                 void* ctx) {
+    ASSERT(cache != NULL)
+    ASSERT(capacity > 0)
+    ASSERT(match != NULL)
+    dlinkedlist_init_head(&(cache->_inq), NULL);
+    dlinkedlist_init_head(&(cache->_mainq), NULL);
+    dlinkedlist_init_head(&(cache->_outq), NULL);
+    dlinkedlist_pool_init_type(&(cache->_pool), struct __twoqcache_ghost,
+                               _out, 256);
+    cache->_match = match;
+    cache->_evict = evict;
+    cache->_ctx = ctx;
+    cache->_capacity = capacity;
+    cache->_incapacity = capacity / TWOQCACHE_IN_DIVISOR;
+    cache->_outcapacity = capacity / TWOQCACHE_OUT_DIVISOR;
+    if (cache->_incapacity == 0) {cache->_incapacity = 1;}
+    if (cache->_outcapacity == 0) {cache->_outcapacity = 1;}
+    cache->_insize = 0;
+    cache->_outsize = 0;
+    cache->_stats.hits = 0;
+    cache->_stats.misses = 0;
+    cache->_stats.evictions = 0;
+    cache->_stats.ghosthits = 0;
+    if (!hashmap_init(&(cache->_index), 16)) {return 0;}
+    if (!hashmap_init(&(cache->_ghosts), 16)) {
+        hashmap_free(&(cache->_index));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ *  Gets the number of entries
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T twoqcache_size(const struct twoqcache* cache) {
+    ASSERT(cache != NULL)
+    return hashmap_size(&(cache->_index));
+}
+
+/**
+ *  Indicates if an entry is in main (seen more than once)
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Entry
+ *  \return 0 if the entry is in in
+ */
+static inline int twoqcache_in_main(const struct twoqcache_node* node) {
+    ASSERT(node != NULL)
+    return node->_in == __TWOQCACHE_MAIN;
+}
+
+/**
+ *  Gets cache's counters
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \return Counters
+ */
+static inline const struct twoqcache_stats* twoqcache_stats(
+                                            const struct twoqcache* cache) {
+    ASSERT(cache != NULL)
+    return &(cache->_stats);
+}
+
+/**
+ *  Finds an entry without touching recency nor counters
+ *
+ *  Time Complexity:    O(1) average
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \param key Key
+ *  \return Entry. NULL iff none
+ */
+static inline struct twoqcache_node* twoqcache_peek(const struct twoqcache* cache,
+                                                    uint64_t hash,
+                                                    const void* key) {
+    ASSERT(cache != NULL)
+    struct hashmap_node* node;
+    hashmap_for_each_possible(&(cache->_index), node, hash) {
+        if (node->_hash != hash) {continue;}
+        struct twoqcache_node* entry = dlinkedlist_entry(node,
+                                                         struct twoqcache_node,
+                                                         _hash);
+        if (cache->_match(entry, key)) {return entry;}
+    }
+    return NULL;
+}
+
+/**
+ *  Removes an entry. The eviction callback is NOT called and no ghost is
+ *  left.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param node Entry
+ */
+static inline void twoqcache_remove(struct twoqcache* cache,
+                                    struct twoqcache_node* node) {
+    ASSERT(cache != NULL)
+    ASSERT(node != NULL)
+    hashmap_remove(&(cache->_index), &(node->_hash));
+    struct dlinkedlist_node* queue = (node->_in == __TWOQCACHE_IN)
+                                        ? &(cache->_inq)
+                                        : &(cache->_mainq);
+    dlinkedlist_remove_from(queue, &(node->_queue), NULL);
+    if (node->_in == __TWOQCACHE_IN) {cache->_insize--;}
+}
+
+/**
+ *  Drops an entry and hands it to the eviction callback
+ */
+static inline void __twoqcache_evict(struct twoqcache* cache,
+                                     struct twoqcache_node* node) {
+    twoqcache_remove(cache, node);
+    cache->_stats.evictions++;
+    if (cache->_evict != NULL) {cache->_evict(node, cache->_ctx);}
+}
+
+/**
+ *  Records a ghost for hash, recycling the oldest ghost if out is full
+ */
+static inline void __twoqcache_add_ghost(struct twoqcache* cache,
+                                         uint64_t hash) {
+    struct dlinkedlist_node* out;
+    if (cache->_outsize >= cache->_outcapacity) {
+        out = cache->_outq.prev;
+        dlinkedlist_remove_from(&(cache->_outq), out, NULL);
+        hashmap_remove(&(cache->_ghosts), &(dlinkedlist_entry(out,
+                                    struct __twoqcache_ghost, _out)->_hash));
+        cache->_outsize--;
+    } else {
+        out = dlinkedlist_pool_alloc(&(cache->_pool));
+        if (out == NULL) {return;}
+    }
+    struct __twoqcache_ghost* ghost = dlinkedlist_entry(out,
+                                                        struct __twoqcache_ghost,
+                                                        _out);
+    hashmap_add(&(cache->_ghosts), &(ghost->_hash), hash);
+    dlinkedlist_add_head(&(cache->_outq), out, NULL);
+    cache->_outsize++;
+}
+
+/**
+ *  Forgets hash's ghost
+ *
+ *  \return 0 iff hash has no ghost
+ */
+static inline int __twoqcache_take_ghost(struct twoqcache* cache,
+                                         uint64_t hash) {
+    struct hashmap_node* node;
+    hashmap_for_each_possible(&(cache->_ghosts), node, hash) {
+        if (node->_hash != hash) {continue;}
+        struct __twoqcache_ghost* ghost = dlinkedlist_entry(node,
+                                                    struct __twoqcache_ghost,
+                                                    _hash);
+        hashmap_remove(&(cache->_ghosts), node);
+        dlinkedlist_remove_from(&(cache->_outq), &(ghost->_out), NULL);
+        dlinkedlist_pool_release(&(cache->_pool), &(ghost->_out));
+        cache->_outsize--;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ *  Evicts entries other than keep until the capacity is honoured
+ */
+static inline void __twoqcache_trim(struct twoqcache* cache,
+                                    struct twoqcache_node* keep) {
+    while (twoqcache_size(cache) > cache->_capacity) {
+        struct dlinkedlist_node* victim;
+        if (cache->_insize > cache->_incapacity
+            || dlinkedlist_empty(&(cache->_mainq))) {
+            victim = cache->_inq.prev;
+        } else {
+            victim = cache->_mainq.prev;
+        }
+        struct twoqcache_node* node = dlinkedlist_entry(victim,
+                                                        struct twoqcache_node,
+                                                        _queue);
+        if (node == keep) {
+            // keep is its queue's only candidate: evict from the other one
+            struct dlinkedlist_node* other = (keep->_in == __TWOQCACHE_MAIN)
+                                                ? &(cache->_inq)
+                                                : &(cache->_mainq);
+            if (dlinkedlist_empty(other)) {return;}
+            node = dlinkedlist_entry(other->prev, struct twoqcache_node,
+                                     _queue);
+        }
+        if (node->_in == __TWOQCACHE_IN) {
+            __twoqcache_add_ghost(cache, node->_hash._hash);
+        }
+        __twoqcache_evict(cache, node);
+    }
+}
+
+/**
+ *  Finds an entry. Entries in main become the most recently used ones;
+ *  entries in in are left in place. Counts a hit or a miss.
+ *
+ *  Time Complexity:    O(1) average
+ *  Space Complexity:   O(0)
+ *
+ *  \param cache Cache
+ *  \param hash Key's hash
+ *  \param key Key
+ *  \return Entry. NULL iff none
+ */
+static inline struct twoqcache_node* twoqcache_get(struct twoqcache* cache,
+                                                   uint64_t hash,
+                                                   const void* key) {
+    ASSERT(cache != NULL)
+    struct twoqcache_node* node = twoqcache_peek(cache, hash, key);
+    if (node == NULL) {
+        cache->_stats.misses++;
+        return NULL;
+    }
+    cache->_stats.hits++;
+    if (node->_in == __TWOQCACHE_MAIN && cache->_mainq.next != &(node->_queue)) {
+        dlinkedlist_remove_from(&(cache->_mainq), &(node->_queue), NULL);
+        dlinkedlist_add_head(&(cache->_mainq), &(node->_queue), NULL);
+    }
+    return node;
+}
+
+/**
+ *  Adds an entry: to main if an entry with the same key is replaced or its
+ *  key has a ghost, to in otherwise. Entries are then evicted as long as
+ *  the cache exceeds its capacity.
+ *
+ *  Time Complexity:    O(1) amortized
+ *  Space Complexity:   O(1) amortized
+ *
+ *  \param cache Cache
+ *  \param node Entry to add. MUST NOT be in a cache
+ *  \param hash Key's hash
+ *  \param key Entry's key
+ */
+static inline void twoqcache_put(struct twoqcache* cache,
+                                 struct twoqcache_node* node,
+                                 uint64_t hash,
+                                 const void* key) {
+    ASSERT(cache != NULL)
+    ASSERT(node != NULL)
+    int queue = __TWOQCACHE_IN;
+    struct twoqcache_node* old = twoqcache_peek(cache, hash, key);
+    if (old != NULL) {
+        queue = old->_in;
+        __twoqcache_evict(cache, old);
+    } else if (__twoqcache_take_ghost(cache, hash)) {
+        queue = __TWOQCACHE_MAIN;
+        cache->_stats.ghosthits++;
+    }
+    node->_in = queue;
+    hashmap_add(&(cache->_index), &(node->_hash), hash);
+    if (queue == __TWOQCACHE_IN) {
+        dlinkedlist_add_head(&(cache->_inq), &(node->_queue), NULL);
+        cache->_insize++;
+    } else {
+        dlinkedlist_add_head(&(cache->_mainq), &(node->_queue), NULL);
+    }
+    __twoqcache_trim(cache, node);
+}
+
+/**
+ *  Evicts every entry and forgets every ghost
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ */
+static inline void twoqcache_clear(struct twoqcache* cache) {
+    ASSERT(cache != NULL)
+    while (!dlinkedlist_empty(&(cache->_inq))) {
+        __twoqcache_evict(cache, dlinkedlist_entry(cache->_inq.prev,
+                                                   struct twoqcache_node,
+                                                   _queue));
+    }
+    while (!dlinkedlist_empty(&(cache->_mainq))) {
+        __twoqcache_evict(cache, dlinkedlist_entry(cache->_mainq.prev,
+                                                   struct twoqcache_node,
+                                                   _queue));
+    }
+    while (!dlinkedlist_empty(&(cache->_outq))) {
+        struct __twoqcache_ghost* ghost = dlinkedlist_entry(cache->_outq.next,
+                                                    struct __twoqcache_ghost,
+                                                    _out);
+        __twoqcache_take_ghost(cache, ghost->_hash._hash);
+    }
+}
+
+/**
+ *  Evicts every entry and frees cache's memory
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param cache Cache
+ */
+static inline void twoqcache_free(struct twoqcache* cache) {
+    ASSERT(cache != NULL)
+    twoqcache_clear(cache);
+    hashmap_free(&(cache->_index));
+    hashmap_free(&(cache->_ghosts));
+    dlinkedlist_pool_free(&(cache->_pool));
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_CACHE_TWOQCACHE_H_
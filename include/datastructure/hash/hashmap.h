@@ -0,0 +1,397 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Intrusive hash map growing incrementally
+ *
+ *  Containers embed a struct hashmap_node (a hash list node and the
+ *  container's hash) chained in one pointer buckets like struct hashtable.
+ *  Once the map holds as many containers as buckets, a table twice as large
+ *  is allocated and the old table's buckets are migrated a few at a time
+ *  (HASHMAP_MIGRATE_STEP buckets) by each subsequent add/remove, instead of
+ *  rehashing every container at once. Lookups search the one bucket a hash
+ *  currently lives in, whether it is migrated or not.
+ *
+ *  Map never shrinks.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_HASH_HASHMAP_H_
+#define INCLUDE_DATASTRUCTURE_HASH_HASHMAP_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/hlinkedlist.h"
+
+/**
+ *  Number of old buckets migrated by each add/remove while growing. Keeps
+ *  migration ahead of the next growth: a table of b buckets is replaced
+ *  after at least b adds.
+ */
+#ifndef HASHMAP_MIGRATE_STEP
+    #define HASHMAP_MIGRATE_STEP 4
+#endif
+
+/**
+ *  A hash map node. _link MUST remain the first member (see
+ *  hashmap_for_each).
+ */
+struct hashmap_node {
+    struct hlinkedlist_node _link;      /** Bucket chain */
+    uint64_t _hash;                     /** Container's hash */
+};
+
+/**
+ *  A hash map
+ */
+struct hashmap {
+    struct hlinkedlist_head* _buckets;  /** Current buckets */
+    size_t _mask;                       /** Number of _buckets - 1 */
+    struct hlinkedlist_head* _old;      /** Buckets being migrated. NULL iff not growing */
+    size_t _oldmask;                    /** Number of _old buckets - 1 */
+    size_t _migrated;                   /** Number of _old buckets migrated so far */
+    _UINT_LEAST_64_T _size;             /** Number of containers */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ * Get the struc for this entry
+ *
+ * Time Complexity: O(1)
+ * Space Complexity: O(0)
+ *
+ * \param ptr Pointer to the struct hashmap_node
+ * \param containertype Type of the struct ptr is embedded in
+ * \param member Name of the struct hashmap_node within containertype
+ */
+#define hashmap_entry(ptr, containertype, member)                              \
+    __dlinkedlist_container_of(ptr, containertype, member)
+
+/**
+ *  Tests if a container matches a key. Only called on containers whose
+ *  hash equals the key's hash.
+ *
+ *  \param node Node embedded in the container
+ *  \param key Key
+ *
+ *  \return non 0 iff node matches
+ */
+typedef int (*hashmap_match)(const struct hashmap_node* node, const void* key);
+
+/**
+ *  Allocates count buckets, initialized as empty iff init is not 0
+ *
+ *  \return NULL iff no memory is available
+ */
+static inline struct hlinkedlist_head* __hashmap_buckets(size_t count,
+                                                         int init) {
+    struct hlinkedlist_head* buckets = (struct hlinkedlist_head*) malloc(
+                                    count * sizeof(struct hlinkedlist_head));
+    if (buckets == NULL || !init) {return buckets;}
+    for (size_t i = 0; i < count; i++) {
+        hlinkedlist_init_head(&(buckets[i]), NULL);
+    }
+    return buckets;
+}
+
+/**
+ *  Initializes an empty map
+ *
+ *  Time Complexity:    O(b), b being the number of buckets
+ *  Space Complexity:   O(b)
+ *
+ *  \param map Map
+ *  \param buckets Initial minimum number of buckets. Rounded up to a power
+ *                 of 2
+ *  \return 0 iff no memory is available
+ */
+static inline int hashmap_init(struct hashmap* map, size_t buckets) {
+    ASSERT(map != NULL)
+    size_t count = 1;
+    while (count < buckets) {count <<= 1;}
+    map->_buckets = __hashmap_buckets(count, 1);
+    map->_mask = map->_buckets == NULL ? 0 : count - 1;
+    map->_old = NULL;
+    map->_oldmask = 0;
+    map->_migrated = 0;
+    map->_size = 0;
+    return map->_buckets != NULL;
+}
+
+/**
+ *  Frees map's buckets. Containers are left untouched.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param map Map
+ */
+static inline void hashmap_free(struct hashmap* map) {
+    ASSERT(map != NULL)
+    free(map->_buckets);
+    free(map->_old);
+    map->_buckets = NULL;
+    map->_mask = 0;
+    map->_old = NULL;
+    map->_oldmask = 0;
+    map->_migrated = 0;
+    map->_size = 0;
+}
+
+/**
+ *  Gets the number of containers in the map
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param map Map
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T hashmap_size(const struct hashmap* map) {
+    ASSERT(map != NULL)
+    return map->_size;
+}
+
+/**
+ *  Indicates if the map is empty
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param map Map
+ *  \return 0 if not empty.
+ */
+static inline int hashmap_empty(const struct hashmap* map) {
+    ASSERT(map != NULL)
+    return map->_size == 0;
+}
+
+/**
+ *  Indicates if the map is migrating buckets to a larger table
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param map Map
+ *  \return 0 if not growing.
+ */
+static inline int hashmap_growing(const struct hashmap* map) {
+    ASSERT(map != NULL)
+    return map->_old != NULL;
+}
+
+/**
+ *  Gets the bucket a hash currently lives in
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param map Map
+ *  \param hash Hash
+ *  \return Bucket's list head
+ */
+static inline struct hlinkedlist_head* __hashmap_bucket(const struct hashmap* map,
+                                                        uint64_t hash) {
+    if (map->_old != NULL) {
+        size_t old = (size_t) hash & map->_oldmask;
+        if (old >= map->_migrated) {return &(map->_old[old]);}
+    }
+    return &(map->_buckets[(size_t) hash & map->_mask]);
+}
+
+/**
+ *  Migrates buckets of the old table, if growing.
+ *
+ *  Time Complexity:    O(steps) buckets, each holding about 1 container
+ *  Space Complexity:   O(1)
+ *
+ *  \param map Map
+ *  \param steps Maximum number of buckets to migrate
+ *  \return 0 iff the map is not growing anymore
+ */
+static inline int hashmap_migrate(struct hashmap* map, size_t steps) {
+    ASSERT(map != NULL)
+    if (map->_old == NULL) {return 0;}
+    while (steps-- > 0 && map->_migrated <= map->_oldmask) {
+        struct hlinkedlist_head* bucket = &(map->_old[map->_migrated]);
+        hlinkedlist_init_head(&(map->_buckets[map->_migrated]), NULL);
+        hlinkedlist_init_head(&(map->_buckets[map->_migrated
+                                              + map->_oldmask + 1]), NULL);
+        while (!hlinkedlist_empty(bucket)) {
+            struct hlinkedlist_node* node = bucket->first;
+            uint64_t hash = ((struct hashmap_node*) node)->_hash;
+            hlinkedlist_remove(node, NULL);
+            hlinkedlist_add_head(&(map->_buckets[(size_t) hash & map->_mask]),
+                                 node, NULL);
+        }
+        map->_migrated++;
+    }
+    if (map->_migrated <= map->_oldmask) {return 1;}
+    free(map->_old);
+    map->_old = NULL;
+    map->_oldmask = 0;
+    map->_migrated = 0;
+    return 0;
+}
+
+/**
+ *  Starts growing the map iff it is full and not already growing. Map keeps
+ *  its size if no memory is available. New buckets are initialized as old
+ *  buckets are migrated to them.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(b), b being the new number of buckets
+ */
+static inline void __hashmap_grow(struct hashmap* map) {
+    if (map->_old != NULL || map->_size <= map->_mask) {return;}
+    size_t count = (map->_mask + 1) << 1;
+    struct hlinkedlist_head* buckets = __hashmap_buckets(count, 0);
+    if (buckets == NULL) {return;}
+    map->_old = map->_buckets;
+    map->_oldmask = map->_mask;
+    map->_migrated = 0;
+    map->_buckets = buckets;
+    map->_mask = count - 1;
+}
+
+/**
+ *  Iterates over the containers whose hash falls in the same bucket as hash
+ *
+ *  \param map Map
+ *  \param node the &struct hashmap_node to use as a loop cursor.
+ *  \param hash Hash
+ */
+#define hashmap_for_each_possible(map, node, hash)                            \
+    for (node = (struct hashmap_node*) __hashmap_bucket(map, hash)->first;    \
+         node != NULL;                                                        \
+         node = (struct hashmap_node*) (node)->_link.next)
+
+/**
+ *  Gets the first node of the bucket-th bucket: current buckets first, then
+ *  old buckets while growing.
+ *
+ *  \return NULL iff the bucket is empty (or not initialized yet)
+ */
+static inline struct hashmap_node* __hashmap_bucket_first(
+                                            const struct hashmap* map,
+                                            size_t bucket) {
+    if (bucket > map->_mask) {
+        return (struct hashmap_node*) map->_old[bucket - map->_mask - 1].first;
+    }
+    if (map->_old != NULL && (bucket & map->_oldmask) >= map->_migrated) {
+        return NULL;
+    }
+    return (struct hashmap_node*) map->_buckets[bucket].first;
+}
+
+/**
+ *  Iterates over every container, bucket by bucket. break only leaves the
+ *  current bucket. The map MUST NOT be modified while iterating.
+ *
+ *  \param map Map
+ *  \param bucket size_t to use as a bucket index cursor
+ *  \param node the &struct hashmap_node to use as a loop cursor.
+ */
+#define hashmap_for_each(map, bucket, node)                                   \
+    for (bucket = 0; bucket <= (map)->_mask                                   \
+                     + ((map)->_old == NULL ? 0 : (map)->_oldmask + 1);       \
+         bucket++)                                                            \
+        for (node = __hashmap_bucket_first(map, bucket);                      \
+             node != NULL;                                                    \
+             node = (struct hashmap_node*) (node)->_link.next)
+
+/**
+ *  Adds a container. Containers with equal keys are NOT detected.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1) (amortized)
+ *
+ *  \param map Map
+ *  \param node Node embedded in the container
+ *  \param hash Container's hash
+ */
+static inline void hashmap_add(struct hashmap* map,
+                               struct hashmap_node* node,
+                               uint64_t hash) {
+    ASSERT(map != NULL)
+    ASSERT(node != NULL)
+    hashmap_migrate(map, HASHMAP_MIGRATE_STEP);
+    node->_hash = hash;
+    hlinkedlist_add_head(__hashmap_bucket(map, hash), &(node->_link), NULL);
+    map->_size++;
+    __hashmap_grow(map);
+}
+
+/**
+ *  Removes a container
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param map Map the container is in
+ *  \param node Node embedded in the container
+ */
+static inline void hashmap_remove(struct hashmap* map,
+                                  struct hashmap_node* node) {
+    ASSERT(map != NULL)
+    ASSERT(node != NULL)
+    ASSERT(map->_size > 0)
+    hlinkedlist_remove(&(node->_link), NULL);
+    map->_size--;
+    hashmap_migrate(map, HASHMAP_MIGRATE_STEP);
+}
+
+/**
+ *  Finds a container
+ *
+ *  Time Complexity:    O(1) average, O(n) worst
+ *  Space Complexity:   O(0)
+ *
+ *  \param map Map
+ *  \param hash Key's hash
+ *  \param match Key matcher
+ *  \param key Key passed to match
+ *  \return Node embedded in the first matching container. NULL iff none
+ */
+static inline struct hashmap_node* hashmap_find(const struct hashmap* map,
+                                                uint64_t hash,
+                                                hashmap_match match,
+                                                const void* key) {
+    ASSERT(map != NULL)
+    ASSERT(match != NULL)
+    struct hashmap_node* node;
+    hashmap_for_each_possible(map, node, hash) {
+        if (node->_hash == hash && match(node, key)) {return node;}
+    }
+    return NULL;
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_HASH_HASHMAP_H_
@@ -0,0 +1,303 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Fixed size intrusive hash table
+ *
+ *  Containers embed a struct hlinkedlist_node and are chained in one of a
+ *  power of two number of buckets, selected by the low bits of the
+ *  container's hash. Buckets are struct hlinkedlist_head: one pointer per
+ *  bucket. The table neither hashes nor compares keys: callers supply the
+ *  hash (see hashtable_hash_u64 and friends to mix weak hashes) and match
+ *  containers while walking a bucket.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_HASH_HASHTABLE_H_
+#define INCLUDE_DATASTRUCTURE_HASH_HASHTABLE_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/hlinkedlist.h"
+
+/**
+ *  A hash table
+ */
+struct hashtable {
+    struct hlinkedlist_head* _buckets;  /** Buckets */
+    size_t _mask;                       /** Number of buckets - 1 */
+    _UINT_LEAST_64_T _size;             /** Number of containers */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Tests if a container matches a key
+ *
+ *  \param node Node embedded in the container
+ *  \param key Key
+ *
+ *  \return non 0 iff node matches
+ */
+typedef int (*hashtable_match)(const struct hlinkedlist_node* node,
+                               const void* key);
+
+/**
+ *  Mixes a 64 bits value into a hash whose low bits depend on every input
+ *  bit (splitmix64 finalizer).
+ *
+ *  \param value Value
+ *  \return Hash
+ */
+static inline uint64_t hashtable_hash_u64(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+/**
+ *  Hashes a pointer
+ *
+ *  \param ptr Pointer
+ *  \return Hash
+ */
+static inline uint64_t hashtable_hash_ptr(const void* ptr) {
+    return hashtable_hash_u64((uint64_t) (uintptr_t) ptr);
+}
+
+/**
+ *  Hashes a byte string (FNV-1a, mixed)
+ *
+ *  Time Complexity:    O(length)
+ *  Space Complexity:   O(1)
+ *
+ *  \param data Bytes
+ *  \param length Number of bytes
+ *  \return Hash
+ */
+static inline uint64_t hashtable_hash_bytes(const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*) data;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hashtable_hash_u64(hash);
+}
+
+/**
+ *  Initializes an empty table
+ *
+ *  Time Complexity:    O(b), b being the number of buckets
+ *  Space Complexity:   O(b)
+ *
+ *  \param table Table
+ *  \param buckets Minimum number of buckets. Rounded up to a power of 2
+ *  \return 0 iff no memory is available
+ */
+static inline int hashtable_init(struct hashtable* table, size_t buckets) {
+    ASSERT(table != NULL)
+    size_t count = 1;
+    while (count < buckets) {count <<= 1;}
+    table->_buckets = (struct hlinkedlist_head*) malloc(
+                                    count * sizeof(struct hlinkedlist_head));
+    table->_mask = 0;
+    table->_size = 0;
+    if (table->_buckets == NULL) {return 0;}
+    for (size_t i = 0; i < count; i++) {
+        hlinkedlist_init_head(&(table->_buckets[i]), NULL);
+    }
+    table->_mask = count - 1;
+    return 1;
+}
+
+/**
+ *  Frees table's buckets. Containers are left untouched.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param table Table
+ */
+static inline void hashtable_free(struct hashtable* table) {
+    ASSERT(table != NULL)
+    free(table->_buckets);
+    table->_buckets = NULL;
+    table->_mask = 0;
+    table->_size = 0;
+}
+
+/**
+ *  Gets the number of containers in the table
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T hashtable_size(const struct hashtable* table) {
+    ASSERT(table != NULL)
+    return table->_size;
+}
+
+/**
+ *  Indicates if the table is empty
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table
+ *  \return 0 if not empty.
+ */
+static inline int hashtable_empty(const struct hashtable* table) {
+    ASSERT(table != NULL)
+    return table->_size == 0;
+}
+
+/**
+ *  Gets the number of buckets
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table
+ *  \return Number of buckets
+ */
+static inline size_t hashtable_bucket_count(const struct hashtable* table) {
+    ASSERT(table != NULL)
+    return table->_mask + 1;
+}
+
+/**
+ *  Gets the bucket a hash belongs to
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table
+ *  \param hash Hash
+ *  \return Bucket's list head
+ */
+static inline struct hlinkedlist_head* hashtable_bucket(
+                                            const struct hashtable* table,
+                                            uint64_t hash) {
+    ASSERT(table != NULL)
+    ASSERT(table->_buckets != NULL)
+    return &(table->_buckets[(size_t) hash & table->_mask]);
+}
+
+/**
+ *  Iterates over the containers whose hash falls in the same bucket as hash
+ *
+ *  \param table Table
+ *  \param node the &struct hlinkedlist_node to use as a loop cursor.
+ *  \param hash Hash
+ */
+#define hashtable_for_each_possible(table, node, hash)                        \
+    hlinkedlist_for_each(hashtable_bucket(table, hash), node)
+
+/**
+ *  Iterates over every container, bucket by bucket. break only leaves the
+ *  current bucket.
+ *
+ *  \param table Table
+ *  \param bucket size_t to use as a bucket index cursor
+ *  \param node the &struct hlinkedlist_node to use as a loop cursor.
+ */
+#define hashtable_for_each(table, bucket, node)                               \
+    for (bucket = 0; bucket <= (table)->_mask; bucket++)                      \
+        hlinkedlist_for_each(&((table)->_buckets[bucket]), node)
+
+/**
+ *  Adds a container. Containers with equal keys are NOT detected.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table
+ *  \param node Node embedded in the container
+ *  \param hash Container's hash
+ */
+static inline void hashtable_add(struct hashtable* table,
+                                 struct hlinkedlist_node* node,
+                                 uint64_t hash) {
+    ASSERT(table != NULL)
+    hlinkedlist_add_head(hashtable_bucket(table, hash), node, NULL);
+    table->_size++;
+}
+
+/**
+ *  Removes a container
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table the container is in
+ *  \param node Node embedded in the container
+ */
+static inline void hashtable_remove(struct hashtable* table,
+                                    struct hlinkedlist_node* node) {
+    ASSERT(table != NULL)
+    ASSERT(table->_size > 0)
+    hlinkedlist_remove(node, NULL);
+    table->_size--;
+}
+
+/**
+ *  Finds a container
+ *
+ *  Time Complexity:    O(1) average, O(n) worst
+ *  Space Complexity:   O(0)
+ *
+ *  \param table Table
+ *  \param hash Key's hash
+ *  \param match Key matcher
+ *  \param key Key passed to match
+ *  \return Node embedded in the first matching container. NULL iff none
+ */
+static inline struct hlinkedlist_node* hashtable_find(
+                                            const struct hashtable* table,
+                                            uint64_t hash,
+                                            hashtable_match match,
+                                            const void* key) {
+    ASSERT(table != NULL)
+    ASSERT(match != NULL)
+    struct hlinkedlist_node* node;
+    hashtable_for_each_possible(table, node, hash) {
+        if (match(node, key)) {return node;}
+    }
+    return NULL;
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_HASH_HASHTABLE_H_
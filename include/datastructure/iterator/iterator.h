@@ -42,6 +42,15 @@
  *  - To free the iterator :
  *    void <datastructure name>_iterator_free(struct iterator* iterator, ...)
  *
+ *  Datastructures MAY also provide allocation free iterators living in
+ *  caller provided storage:
+ *
+ *  - To initialize the iterator :
+ *    struct iterator* <datastructure name>_iterator_init(struct iterator_<datastructure name>* storage, ...)
+ *
+ *  - To deinitialize the iterator :
+ *    void <datastructure name>_iterator_deinit(struct iterator* iterator, ...)
+ *
  */
 
 enum iterator_mode {
@@ -107,7 +116,7 @@ static inline void* iterator_item_prev(struct iterator* iterator) {
  * \param iterator The iterator to iterate onto
  * \return the item 
  */
-void* iterator_item_current(struct iterator* iterator) {
+static inline void* iterator_item_current(struct iterator* iterator) {
     if (iterator == NULL) {
         return NULL;
     }
@@ -37,8 +37,12 @@
 #include <stdint.h>
 #include "datastructure/macros.h"
 #include "datastructure/iterator/iterator.h"
+#ifdef DATASTRUCTURE_STATS
+    #include "datastructure/list/dlinkedlist_stats.h"
+#endif
 
 #define _INT_LEAST_32_T int_least32_t
+#define _UINT_LEAST_64_T uint_least64_t
 
 /**
  *  A double linked list node
@@ -93,6 +97,20 @@ EXTERN_C_BEGIN
 #define dlinkedlist_next_entry(ptr, containertype, member)                     \
     __dlinkedlist_container_of((ptr)->next, containertype, member)
 
+#ifdef DATASTRUCTURE_STATS
+    /*
+     * Traversal accounting (see dlinkedlist_stats.h): BEGIN evaluates to
+     * the first node, STEP to the loop condition
+     */
+    #define __DLINKEDLIST_STATS_WALK_BEGIN(head, first)                        \
+        (__dlinkedlist_stats_walk_begin(head), (first))
+    #define __DLINKEDLIST_STATS_WALK_STEP(head, more)                          \
+        __dlinkedlist_stats_walk_step((head), (more))
+#else
+    #define __DLINKEDLIST_STATS_WALK_BEGIN(head, first) (first)
+    #define __DLINKEDLIST_STATS_WALK_STEP(head, more) (more)
+#endif
+
 /**
  * Iterates over a list forward
  *
@@ -100,7 +118,9 @@ EXTERN_C_BEGIN
  * \param node	the &struct dlinkedlist_node to use as a loop cursor.
  */
 #define dlinkedlist_for_each(head, node)                                      \
-    for (node = (head)->next; node != (head) ; node = (node)->next)
+    for (node = __DLINKEDLIST_STATS_WALK_BEGIN((head), (head)->next);          \
+         __DLINKEDLIST_STATS_WALK_STEP((head), node != (head));                \
+         node = (node)->next)
 
 /**
  * Iterates over a list backward (eg: from tail to head)
@@ -109,7 +129,146 @@ EXTERN_C_BEGIN
  * \param node	the &struct dlinkedlist_node to use as a loop cursor.
  */
 #define dlinkedlist_for_each_prev(head, node)                                 \
-    for (node = (head)->prev; node != (head) ; node = (node)->prev)
+    for (node = __DLINKEDLIST_STATS_WALK_BEGIN((head), (head)->prev);          \
+         __DLINKEDLIST_STATS_WALK_STEP((head), node != (head));                \
+         node = (node)->prev)
+
+/**
+ *  Moves a prefetching cursor one node further and prefetches the node it
+ *  lands on (and optionally its container). Stops on the list head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head Lists head.
+ *  \param ahead Prefetching cursor
+ *  \param backward Moves to prev iff NOT 0, to next otherwise
+ *  \param offset Node offset within its container. (size_t)-1 to skip
+ *                container prefetching
+ *  \return New cursor position
+ */
+static inline struct dlinkedlist_node* __dlinkedlist_prefetch_advance(
+                                        const struct dlinkedlist_node* head,
+                                        struct dlinkedlist_node* ahead,
+                                        int backward,
+                                        size_t offset) {
+    if (ahead != head) {
+        ahead = backward ? ahead->prev : ahead->next;
+        PREFETCH(ahead);
+        if (offset != (size_t) -1 && ahead != head) {
+            PREFETCH((char*) ahead - offset);
+        }
+    }
+    return ahead;
+}
+
+/**
+ *  Positions a prefetching cursor distance nodes after node, prefetching
+ *  every node on the way. A distance of 0 parks the cursor on the list
+ *  head, so that nothing is prefetched.
+ *
+ *  Time Complexity:    O(distance)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head Lists head.
+ *  \param node First node visited by the traversal
+ *  \param distance Number of nodes to prefetch ahead
+ *  \param backward Moves to prev iff NOT 0, to next otherwise
+ *  \param offset Node offset within its container. (size_t)-1 to skip
+ *                container prefetching
+ *  \return Cursor
+ */
+static inline struct dlinkedlist_node* __dlinkedlist_prefetch_start(
+                                        const struct dlinkedlist_node* head,
+                                        struct dlinkedlist_node* node,
+                                        unsigned int distance,
+                                        int backward,
+                                        size_t offset) {
+    if (distance == 0) {return (struct dlinkedlist_node*) head;}
+    struct dlinkedlist_node* ahead = node;
+    for (unsigned int i = 0; i < distance; i++) {
+        ahead = __dlinkedlist_prefetch_advance(head, ahead, backward, offset);
+    }
+    return ahead;
+}
+
+/**
+ * Iterates over a list forward, prefetching nodes ahead of the cursor
+ *
+ * \param head	Lists head.
+ * \param node	the &struct dlinkedlist_node to use as a loop cursor.
+ * \param ahead	the &struct dlinkedlist_node to use as prefetching cursor.
+ * \param distance	Number of nodes prefetched ahead of node. 0 for none.
+ */
+#define dlinkedlist_for_each_prefetch(head, node, ahead, distance)            \
+    for (node = __DLINKEDLIST_STATS_WALK_BEGIN((head), (head)->next),          \
+         ahead = __dlinkedlist_prefetch_start((head), node, (distance), 0,     \
+                                              (size_t) -1);                    \
+         __DLINKEDLIST_STATS_WALK_STEP((head), node != (head));                \
+         node = (node)->next,                                                  \
+         ahead = __dlinkedlist_prefetch_advance((head), ahead, 0, (size_t) -1))
+
+/**
+ * Iterates over a list backward, prefetching nodes ahead of the cursor
+ *
+ * \param head	Lists head.
+ * \param node	the &struct dlinkedlist_node to use as a loop cursor.
+ * \param ahead	the &struct dlinkedlist_node to use as prefetching cursor.
+ * \param distance	Number of nodes prefetched ahead of node. 0 for none.
+ */
+#define dlinkedlist_for_each_prev_prefetch(head, node, ahead, distance)       \
+    for (node = __DLINKEDLIST_STATS_WALK_BEGIN((head), (head)->prev),          \
+         ahead = __dlinkedlist_prefetch_start((head), node, (distance), 1,     \
+                                              (size_t) -1);                    \
+         __DLINKEDLIST_STATS_WALK_STEP((head), node != (head));                \
+         node = (node)->prev,                                                  \
+         ahead = __dlinkedlist_prefetch_advance((head), ahead, 1, (size_t) -1))
+
+/**
+ * Iterates over list's entries forward, prefetching nodes and entries
+ * ahead of the cursor
+ *
+ * \param head	Lists head.
+ * \param pos	the containertype* to use as a loop cursor.
+ * \param node	the &struct dlinkedlist_node to use as a node cursor.
+ * \param ahead	the &struct dlinkedlist_node to use as prefetching cursor.
+ * \param containertype Type of the struct the node is embedded in
+ * \param member Name of the struct dlinkedlist_node within containertype
+ * \param distance	Number of entries prefetched ahead of pos. 0 for none.
+ */
+#define dlinkedlist_for_each_entry_prefetch(head, pos, node, ahead,            \
+                                            containertype, member, distance)   \
+    for (node = __DLINKEDLIST_STATS_WALK_BEGIN((head), (head)->next),          \
+         ahead = __dlinkedlist_prefetch_start((head), node, (distance), 0,     \
+                                    offsetof(containertype, member));          \
+         __DLINKEDLIST_STATS_WALK_STEP((head), node != (head))                 \
+         && ((pos = dlinkedlist_entry(node, containertype, member)), 1);       \
+         node = (node)->next,                                                  \
+         ahead = __dlinkedlist_prefetch_advance((head), ahead, 0,              \
+                                    offsetof(containertype, member)))
+
+/**
+ * Iterates over list's entries backward, prefetching nodes and entries
+ * ahead of the cursor
+ *
+ * \param head	Lists head.
+ * \param pos	the containertype* to use as a loop cursor.
+ * \param node	the &struct dlinkedlist_node to use as a node cursor.
+ * \param ahead	the &struct dlinkedlist_node to use as prefetching cursor.
+ * \param containertype Type of the struct the node is embedded in
+ * \param member Name of the struct dlinkedlist_node within containertype
+ * \param distance	Number of entries prefetched ahead of pos. 0 for none.
+ */
+#define dlinkedlist_for_each_entry_prev_prefetch(head, pos, node, ahead,       \
+                                            containertype, member, distance)   \
+    for (node = __DLINKEDLIST_STATS_WALK_BEGIN((head), (head)->prev),          \
+         ahead = __dlinkedlist_prefetch_start((head), node, (distance), 1,     \
+                                    offsetof(containertype, member));          \
+         __DLINKEDLIST_STATS_WALK_STEP((head), node != (head))                 \
+         && ((pos = dlinkedlist_entry(node, containertype, member)), 1);       \
+         node = (node)->prev,                                                  \
+         ahead = __dlinkedlist_prefetch_advance((head), ahead, 1,              \
+                                    offsetof(containertype, member)))
 
 /**
  *  Initializes the list head as depicted below and 
@@ -244,6 +403,7 @@ static inline void dlinkedlist_add_head(struct dlinkedlist_node* head,
     ASSERT(head != NULL)
     ASSERT(node != NULL)
     __dlinkedlist_add(node, head, head->next, size);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_ADDS, 1))
 }
 
 /**
@@ -262,6 +422,7 @@ static inline void dlinkedlist_add_tail(struct dlinkedlist_node* head,
     ASSERT(head != NULL)
     ASSERT(node != NULL)
     __dlinkedlist_add(node, head->prev, head, size);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_ADDS, 1))
 }
 
 /**
@@ -280,6 +441,7 @@ static inline void dlinkedlist_add_after(struct dlinkedlist_node* node,
     ASSERT(node != NULL);
     ASSERT(newnode != NULL);
     __dlinkedlist_add(newnode, node, node->next, size);
+    STATS(__dlinkedlist_stats_count(NULL, __DLINKEDLIST_STATS_ADDS, 1))
 }
 
 /**
@@ -298,6 +460,191 @@ static inline void dlinkedlist_add_before(struct dlinkedlist_node* node,
     ASSERT(node != NULL)
     ASSERT(newnode != NULL)
     __dlinkedlist_add(newnode, node->prev, node, size);
+    STATS(__dlinkedlist_stats_count(NULL, __DLINKEDLIST_STATS_ADDS, 1))
+}
+
+/**
+ *  Adds a new node after another node of a given list. Same as
+ *  dlinkedlist_add_after, with statistics accounted to head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head node belongs to
+ *  \param node Node/head of the list to append newnode to
+ *  \param newnode Node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void dlinkedlist_add_after_in(struct dlinkedlist_node* head,
+                                            struct dlinkedlist_node* node,
+                                            struct dlinkedlist_node* newnode,
+                                            _INT_LEAST_32_T*  size) {
+    ASSERT(head != NULL)
+    ASSERT(node != NULL)
+    ASSERT(newnode != NULL)
+    (void) head;
+    __dlinkedlist_add(newnode, node, node->next, size);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_ADDS, 1))
+}
+
+/**
+ *  Adds a new node before another node of a given list. Same as
+ *  dlinkedlist_add_before, with statistics accounted to head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head node belongs to
+ *  \param node Node/head of the list to prepend newnode to
+ *  \param newnode Node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void dlinkedlist_add_before_in(struct dlinkedlist_node* head,
+                                             struct dlinkedlist_node* node,
+                                             struct dlinkedlist_node* newnode,
+                                             _INT_LEAST_32_T*  size) {
+    ASSERT(head != NULL)
+    ASSERT(node != NULL)
+    ASSERT(newnode != NULL)
+    (void) head;
+    __dlinkedlist_add(newnode, node->prev, node, size);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_ADDS, 1))
+}
+
+/**
+ *  Links a chain of nodes after another node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node to append the chain to
+ *  \param first First node of the chain
+ *  \param last Last node of the chain
+ */
+static inline void __dlinkedlist_add_chain(struct dlinkedlist_node* node,
+                                           struct dlinkedlist_node* first,
+                                           struct dlinkedlist_node* last) {
+    struct dlinkedlist_node* next = node->next;
+    first->prev = node;
+    last->next = next;
+    node->next = first;
+    next->prev = last;
+}
+
+/**
+ *  Adds a chain of nodes after another node. Nodes from first to last MUST
+ *  already be linked to each other (first's prev and last's next are
+ *  ignored).
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node/head of the list to append the chain to
+ *  \param first First node of the chain
+ *  \param last Last node of the chain
+ *  \param count Number of nodes in the chain
+ *  \param size Increases list size by count iff NOT NULL
+ */
+static inline void dlinkedlist_add_chain_after(struct dlinkedlist_node* node,
+                                               struct dlinkedlist_node* first,
+                                               struct dlinkedlist_node* last,
+                                               size_t count,
+                                               _INT_LEAST_32_T*  size) {
+    ASSERT(node != NULL)
+    ASSERT(first != NULL)
+    ASSERT(last != NULL)
+    __dlinkedlist_add_chain(node, first, last);
+    if (size != NULL) {*size += (_INT_LEAST_32_T) count;}
+    STATS(__dlinkedlist_stats_count(NULL, __DLINKEDLIST_STATS_ADDS, count))
+}
+
+/**
+ *  Links an array of nodes to each other, in array order, then after
+ *  another node.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node to append nodes to
+ *  \param nodes Nodes to add
+ *  \param count Number of nodes
+ */
+static inline void __dlinkedlist_add_bulk(struct dlinkedlist_node* node,
+                                          struct dlinkedlist_node* const* nodes,
+                                          size_t count) {
+    if (count == 0) {return;}
+    for (size_t i = 1; i < count; i++) {
+        nodes[i - 1]->next = nodes[i];
+        nodes[i]->prev = nodes[i - 1];
+    }
+    __dlinkedlist_add_chain(node, nodes[0], nodes[count - 1]);
+}
+
+/**
+ *  Adds an array of nodes after another node, in array order. Nodes are
+ *  linked to each other in one pass, the list is touched once.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node/head of the list to append nodes to
+ *  \param nodes Nodes to add
+ *  \param count Number of nodes
+ *  \param size Increases list size by count iff NOT NULL
+ */
+static inline void dlinkedlist_add_after_bulk(struct dlinkedlist_node* node,
+                                              struct dlinkedlist_node* const* nodes,
+                                              size_t count,
+                                              _INT_LEAST_32_T*  size) {
+    ASSERT(node != NULL)
+    ASSERT(nodes != NULL || count == 0)
+    __dlinkedlist_add_bulk(node, nodes, count);
+    if (size != NULL) {*size += (_INT_LEAST_32_T) count;}
+    STATS(__dlinkedlist_stats_count(NULL, __DLINKEDLIST_STATS_ADDS, count))
+}
+
+/**
+ *  Adds an array of nodes after list's head, in array order.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param nodes Nodes to add
+ *  \param count Number of nodes
+ *  \param size Increases list size by count iff NOT NULL
+ */
+static inline void dlinkedlist_add_head_bulk(struct dlinkedlist_node* head,
+                                             struct dlinkedlist_node* const* nodes,
+                                             size_t count,
+                                             _INT_LEAST_32_T*  size) {
+    ASSERT(head != NULL)
+    ASSERT(nodes != NULL || count == 0)
+    __dlinkedlist_add_bulk(head, nodes, count);
+    if (size != NULL) {*size += (_INT_LEAST_32_T) count;}
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_ADDS, count))
+}
+
+/**
+ *  Adds an array of nodes after list's tail, in array order.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param nodes Nodes to add
+ *  \param count Number of nodes
+ *  \param size Increases list size by count iff NOT NULL
+ */
+static inline void dlinkedlist_add_tail_bulk(struct dlinkedlist_node* head,
+                                             struct dlinkedlist_node* const* nodes,
+                                             size_t count,
+                                             _INT_LEAST_32_T*  size) {
+    ASSERT(head != NULL)
+    ASSERT(nodes != NULL || count == 0)
+    __dlinkedlist_add_bulk(head->prev, nodes, count);
+    if (size != NULL) {*size += (_INT_LEAST_32_T) count;}
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_ADDS, count))
 }
 
 /*
@@ -342,6 +689,95 @@ static inline void dlinkedlist_remove(struct dlinkedlist_node* node,
                                _INT_LEAST_32_T*  size) {
     ASSERT(node != NULL)
     __dlinkedlist_remove(node->prev, node->next, size);
+    STATS(__dlinkedlist_stats_count(NULL, __DLINKEDLIST_STATS_REMOVES, 1))
+}
+
+/**
+ *  Removes a node from a given list. Same as dlinkedlist_remove, with
+ *  statistics accounted to head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head node belongs to
+ *  \param node Node to delete. Must NOT be head
+ *  \param size Decrements list size iff NOT NULL
+ */
+static inline void dlinkedlist_remove_from(struct dlinkedlist_node* head,
+                                           struct dlinkedlist_node* node,
+                                           _INT_LEAST_32_T*  size) {
+    ASSERT(head != NULL)
+    ASSERT(node != NULL)
+    ASSERT(node != head)
+    (void) head;
+    __dlinkedlist_remove(node->prev, node->next, size);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_REMOVES, 1))
+}
+
+/**
+ * Tests a node
+ *
+ * \param node Node
+ * \param ctx Caller provided context
+ *
+ * \return non 0 iff node matches
+ */
+typedef int (*dlinkedlist_predicate)(const struct dlinkedlist_node* node,
+                                     void* ctx);
+
+/**
+ *  Moves every node matching a predicate after removed's tail, in list
+ *  order, in a single traversal. Runs of consecutive matching nodes are
+ *  moved at once.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param head List head
+ *  \param pred Predicate. Must not modify the list
+ *  \param ctx pred's context. NULL permitted
+ *  \param removed Head of the list receiving matching nodes
+ *  \param headSize head parameter's size - updated only iff headSize is NOT NULL. NULL permitted.
+ *  \param removedSize removed parameter's size - updated only iff removedSize is NOT NULL. NULL permitted.
+ *  \return Number of moved nodes
+ */
+static inline size_t dlinkedlist_remove_if(struct dlinkedlist_node* head,
+                                           dlinkedlist_predicate pred,
+                                           void* ctx,
+                                           struct dlinkedlist_node* removed,
+                                           _INT_LEAST_32_T* headSize,
+                                           _INT_LEAST_32_T* removedSize) {
+    ASSERT(head != NULL)
+    ASSERT(pred != NULL)
+    ASSERT(removed != NULL)
+    ASSERT(removed != head)
+    size_t count = 0;
+    struct dlinkedlist_node* n = head->next;
+    while (n != head) {
+        if (!pred(n, ctx)) {
+            n = n->next;
+            continue;
+        }
+        // Extend the run as far as possible, then move it at once
+        struct dlinkedlist_node* first = n;
+        struct dlinkedlist_node* prev = n->prev;
+        size_t run = 1;
+        n = n->next;
+        while (n != head && pred(n, ctx)) {
+            n = n->next;
+            run++;
+        }
+        struct dlinkedlist_node* last = n->prev;
+        prev->next = n;
+        n->prev = prev;
+        __dlinkedlist_add_chain(removed->prev, first, last);
+        count += run;
+    }
+    if (headSize != NULL) {*headSize -= (_INT_LEAST_32_T) count;}
+    if (removedSize != NULL) {*removedSize += (_INT_LEAST_32_T) count;}
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_REMOVES, count))
+    STATS(__dlinkedlist_stats_count(removed, __DLINKEDLIST_STATS_ADDS, count))
+    return count;
 }
 
 /**
@@ -374,6 +810,34 @@ static inline void __dlinkedlist_splice(struct dlinkedlist_node* list,
     if (headSize != NULL && listSize != NULL) {*headSize+=*listSize;}
 }
 
+/**
+ *  Moves a run of consecutive nodes in between two consecutive nodes.
+ *  The run is unlinked from the list it belongs to.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param first First node of the run
+ *  \param last Last node of the run (first permitted)
+ *  \param prev Node to prepend to first. Must NOT be in the run
+ *  \param next prev's next node. Must NOT be in the run
+ */
+static inline void __dlinkedlist_move_range(struct dlinkedlist_node* first,
+                                            struct dlinkedlist_node* last,
+                                            struct dlinkedlist_node* prev,
+                                            struct dlinkedlist_node* next) {
+    ASSERT(first != NULL)
+    ASSERT(last != NULL)
+    ASSERT(prev != NULL)
+    ASSERT(next != NULL)
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+    prev->next = first;
+    first->prev = prev;
+    last->next = next;
+    next->prev = last;
+}
+
 /**
  *  Joins two lists together. Fist list is appended to head of the second list
  *
@@ -406,6 +870,7 @@ static inline void dlinkedlist_splice(struct dlinkedlist_node* list,
     //  list is now empty. Make sure head->next/head->prev points to head
     //  to prevent Seg fault when freeing the list for instance.
     dlinkedlist_init_head(list, listSize);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_SPLICES, 1))
 }
 
 /**
@@ -498,6 +963,169 @@ static inline void dlinkedlist_split(struct dlinkedlist_node* head,
     if (dlinkedlist_empty(head)) {return;}
     if (head == node) {return;}
     __dlinkedlist_split(head, list, node, headSize, listSize);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_SPLITS, 1))
+}
+
+/**
+ *  Moves a range of consecutive nodes after another node, possibly of
+ *  another list. Relinking is O(1).
+ *
+ *  Time Complexity:    O(1), O(k) iff sizes are requested and count is 0
+ *  Space Complexity:   O(0)
+ *
+ *  \param first First node of the range. Must NOT be a list head
+ *  \param last Last node of the range (first included). Must NOT be a list head
+ *  \param node Node/head to append the range to. Must NOT be in the range
+ *  \param count Number of nodes in the range. 0 if unknown
+ *  \param fromSize Size of the list the range is moved from - updated only iff NOT NULL. NULL permitted.
+ *  \param toSize Size of the list the range is moved to - updated only iff NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_splice_range(struct dlinkedlist_node* first,
+                                            struct dlinkedlist_node* last,
+                                            struct dlinkedlist_node* node,
+                                            size_t count,
+                                            _INT_LEAST_32_T* fromSize,
+                                            _INT_LEAST_32_T* toSize) {
+    ASSERT(first != NULL)
+    ASSERT(last != NULL)
+    ASSERT(node != NULL)
+    if (count == 0 && (fromSize != NULL || toSize != NULL)) {
+        struct dlinkedlist_node* n = first;
+        count = 1;
+        while (n != last) {
+            n = n->next;
+            count++;
+        }
+    }
+    if (node != first->prev) {
+        // Unlink the range, then link it after node
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+        struct dlinkedlist_node* next = node->next;
+        node->next = first;
+        first->prev = node;
+        last->next = next;
+        next->prev = last;
+    }
+    if (fromSize != NULL) {*fromSize -= (_INT_LEAST_32_T) count;}
+    if (toSize != NULL) {*toSize += (_INT_LEAST_32_T) count;}
+}
+
+/**
+ *  Splits a list into two lists, moving head's first node up to node
+ *  (included) into list.
+ *
+ *  Time Complexity:    O(1), O(k) iff sizes are requested
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List to cut
+ *  \param list An empty list
+ *  \param node Last node moved. head itself moves nothing
+ *  \param headSize head parameter's size - updated only iff headSize is NOT NULL. NULL permitted.
+ *  \param listSize list parameter's size - updated only iff listSize is NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_cut_position(struct dlinkedlist_node* head,
+                                            struct dlinkedlist_node* list,
+                                            struct dlinkedlist_node* node,
+                                            _INT_LEAST_32_T* headSize,
+                                            _INT_LEAST_32_T* listSize) {
+    ASSERT(head != NULL)
+    ASSERT(list != NULL)
+    ASSERT(node != NULL)
+    if (!dlinkedlist_empty(list)) {return;}
+    if (node == head) {return;}
+    dlinkedlist_splice_range(head->next, node, list, 0, headSize, listSize);
+    STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_SPLITS, 1))
+}
+
+/**
+ *  Splits a list into two lists, moving head's first count nodes into list.
+ *
+ *  Time Complexity:    O(k), k being count
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List to cut
+ *  \param list An empty list
+ *  \param count Number of nodes moved. Capped to head's size
+ *  \param headSize head parameter's size - updated only iff headSize is NOT NULL. NULL permitted.
+ *  \param listSize list parameter's size - updated only iff listSize is NOT NULL. NULL permitted.
+ *  \return Number of nodes moved
+ */
+static inline size_t dlinkedlist_cut_count(struct dlinkedlist_node* head,
+                                           struct dlinkedlist_node* list,
+                                           size_t count,
+                                           _INT_LEAST_32_T* headSize,
+                                           _INT_LEAST_32_T* listSize) {
+    ASSERT(head != NULL)
+    ASSERT(list != NULL)
+    if (!dlinkedlist_empty(list)) {return 0;}
+    struct dlinkedlist_node* node = head;
+    size_t moved = 0;
+    while (moved < count && node->next != head) {
+        node = node->next;
+        moved++;
+    }
+    if (moved > 0) {
+        dlinkedlist_splice_range(head->next, node, list, moved,
+                                 headSize, listSize);
+        STATS(__dlinkedlist_stats_count(head, __DLINKEDLIST_STATS_SPLITS, 1))
+    }
+    return moved;
+}
+
+/**
+ *  Moves list's first node after list's tail.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ */
+static inline void dlinkedlist_rotate_left(struct dlinkedlist_node* head) {
+    ASSERT(head != NULL)
+    // Empty and one node lists are left as is
+    if (head->next == head->prev) {return;}
+    struct dlinkedlist_node* first = head->next;
+    __dlinkedlist_move_range(first, first, head->prev, head);
+}
+
+/**
+ *  Rotates a list so that node becomes list's first node. Nodes order is
+ *  kept (circularly): only list's head moves.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node of the list
+ *  \param head List head
+ */
+static inline void dlinkedlist_rotate_to_front(struct dlinkedlist_node* node,
+                                               struct dlinkedlist_node* head) {
+    ASSERT(node != NULL)
+    ASSERT(head != NULL)
+    if (node == head || node == head->next) {return;}
+    head->prev->next = head->next;
+    head->next->prev = head->prev;
+    __dlinkedlist_add(head, node->prev, node, NULL);
+}
+
+/**
+ *  Reverses nodes order in place.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param head List head
+ */
+static inline void dlinkedlist_reverse(struct dlinkedlist_node* head) {
+    ASSERT(head != NULL)
+    struct dlinkedlist_node* n = head;
+    do {
+        struct dlinkedlist_node* next = n->next;
+        n->next = n->prev;
+        n->prev = next;
+        n = next;
+    } while (n != head);
 }
 
 /**
@@ -506,6 +1134,10 @@ static inline void dlinkedlist_split(struct dlinkedlist_node* head,
  *
  */
 
+/**
+ *  Iterator over a list. May live in caller provided storage
+ *  (see dlinkedlist_iterator_init)
+ */
 struct iterator_dlinkedlist {
     struct iterator _base;
     struct dlinkedlist_node* _current;
@@ -536,7 +1168,7 @@ static inline void* __dlinkedlist_iterator_prev (struct iterator* iterator) {
     return iterator2->_current;
 }
 
-void* __dlinkedlist_iterator_current (struct iterator* iterator) {
+static inline void* __dlinkedlist_iterator_current (struct iterator* iterator) {
     if (iterator == NULL) {
         return NULL;
     }
@@ -544,7 +1176,7 @@ void* __dlinkedlist_iterator_current (struct iterator* iterator) {
     return iterator2->_current;
 }
 
-void* __dlinkedlist_iterator_begin (struct iterator* iterator) {
+static inline void* __dlinkedlist_iterator_begin (struct iterator* iterator) {
     if (iterator == NULL) {
         return NULL;
     }
@@ -552,7 +1184,7 @@ void* __dlinkedlist_iterator_begin (struct iterator* iterator) {
     return iterator2->_head;
 }
 
-void* __dlinkedlist_iterator_end (struct iterator* iterator) {
+static inline void* __dlinkedlist_iterator_end (struct iterator* iterator) {
     if (iterator == NULL) {
         return NULL;
     }
@@ -561,36 +1193,109 @@ void* __dlinkedlist_iterator_end (struct iterator* iterator) {
 }
 
 /**
- *  Get an iterator on a list
+ *  Rebinds an iterator onto a list and moves it back to list's head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param iterator The iterator
+ *  \param head The HEAD of the list. NULL permitted to rewind the iterator
+ *              onto the list it is already bound to.
+ */
+static inline void dlinkedlist_iterator_reset(struct iterator* iterator,
+                                              struct dlinkedlist_node* head) {
+    ASSERT(iterator != NULL)
+    struct iterator_dlinkedlist* iterator2 = (struct iterator_dlinkedlist*) iterator;
+    if (head == NULL) {
+        head = iterator2->_head;
+    }
+    ASSERT(head != NULL)
+    iterator2->_head = head;
+    iterator2->_current = head;
+    dlinkedlist_init_head(&(iterator2->_sentineltail), NULL);
+    iterator2->_sentineltail.next = head;
+    iterator2->_sentineltail.prev = head->prev;
+    iterator2->_tail = &(iterator2->_sentineltail);
+}
+
+/**
+ *  Initializes an iterator on a list within caller provided storage
+ *  (eg: on the stack). No memory is allocated.
  *
  *  ALL iterator methods returns "struct dlinkedlist_node*" type
  *
  *  Time Complexity:    O(1)
- *  Space Complexity:   O(1)
+ *  Space Complexity:   O(0)
  *
+ *  \param iterator Storage for the iterator
  *  \param head The HEAD of the list
  *  \param headSize head parameter's size - updated only iff headSize is NOT NULL. NULL permitted.
+ *  \return The iterator, to be released with dlinkedlist_iterator_deinit
  */
-static inline struct iterator* dlinkedlist_iterator_get(struct dlinkedlist_node* head,
-                                     _INT_LEAST_32_T* headSize) {
+static inline struct iterator* dlinkedlist_iterator_init(
+                                    struct iterator_dlinkedlist* iterator,
+                                    struct dlinkedlist_node* head,
+                                    _INT_LEAST_32_T* headSize) {
+    ASSERT(iterator != NULL)
     ASSERT(head != NULL)
-    
-    struct iterator_dlinkedlist* iterator = malloc(sizeof(struct iterator_dlinkedlist));
+    (void) headSize;
     iterator->_base._mode = ITERATOR_ACCESS_MODE_FORWARD | ITERATOR_ACCESS_MODE_BACKWARD;
     iterator->_base.begin = __dlinkedlist_iterator_begin;
     iterator->_base.end = __dlinkedlist_iterator_end;
     iterator->_base.next = __dlinkedlist_iterator_next;
     iterator->_base.prev = __dlinkedlist_iterator_prev;
     iterator->_base.current = __dlinkedlist_iterator_current;
+    iterator->_base._first = NULL;
+    iterator->_base._last = NULL;
     iterator->_head = head;
-    iterator->_current = head;
-    dlinkedlist_init_head(&(iterator->_sentineltail), NULL);
-    iterator->_sentineltail.next = head;
-    iterator->_sentineltail.prev = head->prev;
-    iterator->_tail = &(iterator->_sentineltail);
+    dlinkedlist_iterator_reset(&(iterator->_base), head);
     return &(iterator->_base);
 }
 
+/**
+ *  Deinitializes an iterator initialized with dlinkedlist_iterator_init.
+ *  Caller provided storage is NOT freed.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param iterator The iterator
+ */
+static inline void dlinkedlist_iterator_deinit(struct iterator* iterator) {
+    if (iterator == NULL) {
+        return;
+    }
+    struct iterator_dlinkedlist* iterator2 = (struct iterator_dlinkedlist*) iterator;
+    iterator2->_head = NULL;
+    iterator2->_current = NULL;
+    iterator2->_tail = NULL;
+}
+
+/**
+ *  Get an iterator on a list
+ *
+ *  ALL iterator methods returns "struct dlinkedlist_node*" type
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param head The HEAD of the list
+ *  \param headSize head parameter's size - updated only iff headSize is NOT NULL. NULL permitted.
+ *  \return The iterator, to be released with dlinkedlist_iterator_free.
+ *          NULL iff no memory is available
+ */
+static inline struct iterator* dlinkedlist_iterator_get(struct dlinkedlist_node* head,
+                                     _INT_LEAST_32_T* headSize) {
+    ASSERT(head != NULL)
+    
+    struct iterator_dlinkedlist* iterator = (struct iterator_dlinkedlist*)
+                                    malloc(sizeof(struct iterator_dlinkedlist));
+    if (iterator == NULL) {
+        return NULL;
+    }
+    return dlinkedlist_iterator_init(iterator, head, headSize);
+}
+
 /**
  *  Free iterator
  *
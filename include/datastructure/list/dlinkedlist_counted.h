@@ -0,0 +1,347 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Counted double linked list: a list head bundled with a 64 bits node count
+ *  kept exact by every operation, so that size queries are O(1).
+ *
+ *  Nodes are regular struct dlinkedlist_node: all dlinkedlist_* traversal
+ *  macros work on &list->head.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_COUNTED_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_COUNTED_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  A counted double linked list
+ */
+struct dlinkedlist_counted {
+    struct dlinkedlist_node head;   /** List head */
+    _UINT_LEAST_64_T _size;         /** Number of nodes in the list */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Initializes an empty list
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ */
+static inline void dlinkedlist_counted_init(struct dlinkedlist_counted* list) {
+    ASSERT(list != NULL)
+    dlinkedlist_init_head(&(list->head), NULL);
+    list->_size = 0;
+}
+
+/**
+ *  Frees list's memory, calling fn on every node. List's head is embedded
+ *  in list and is NOT passed to fn. List is empty afterwards.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ *  \param fn Function called for freeing the node
+ */
+static inline void dlinkedlist_counted_free(struct dlinkedlist_counted* list,
+                                            dlinkedlist_free_node fn) {
+    ASSERT(list != NULL)
+    ASSERT(fn != NULL)
+    struct dlinkedlist_node* n = list->head.next;
+    while (n != &(list->head)) {
+        struct dlinkedlist_node* next = n->next;
+        fn(n);
+        n = next;
+    }
+    dlinkedlist_counted_init(list);
+}
+
+/**
+ *  Gets list's size
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T dlinkedlist_counted_size(
+                                    const struct dlinkedlist_counted* list) {
+    ASSERT(list != NULL)
+    return list->_size;
+}
+
+/**
+ *  Indicates if the list is empty
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \return 0 if not empty.
+ */
+static inline int dlinkedlist_counted_empty(
+                                    const struct dlinkedlist_counted* list) {
+    ASSERT(list != NULL)
+    return list->_size == 0;
+}
+
+/**
+ *  Adds a new node after list's head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param node Node to add
+ */
+static inline void dlinkedlist_counted_add_head(struct dlinkedlist_counted* list,
+                                                struct dlinkedlist_node* node) {
+    ASSERT(list != NULL)
+    dlinkedlist_add_head(&(list->head), node, NULL);
+    list->_size++;
+}
+
+/**
+ *  Adds a new node after list's tail.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param node Node to add
+ */
+static inline void dlinkedlist_counted_add_tail(struct dlinkedlist_counted* list,
+                                                struct dlinkedlist_node* node) {
+    ASSERT(list != NULL)
+    dlinkedlist_add_tail(&(list->head), node, NULL);
+    list->_size++;
+}
+
+/**
+ *  Adds a new node after another node of the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List node belongs to
+ *  \param node Node (or list's head) to append newnode to
+ *  \param newnode Node to add
+ */
+static inline void dlinkedlist_counted_add_after(struct dlinkedlist_counted* list,
+                                                 struct dlinkedlist_node* node,
+                                                 struct dlinkedlist_node* newnode) {
+    ASSERT(list != NULL)
+    dlinkedlist_add_after_in(&(list->head), node, newnode, NULL);
+    list->_size++;
+}
+
+/**
+ *  Adds a new node before another node of the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List node belongs to
+ *  \param node Node (or list's head) to prepend newnode to
+ *  \param newnode Node to add
+ */
+static inline void dlinkedlist_counted_add_before(struct dlinkedlist_counted* list,
+                                                  struct dlinkedlist_node* node,
+                                                  struct dlinkedlist_node* newnode) {
+    ASSERT(list != NULL)
+    dlinkedlist_add_before_in(&(list->head), node, newnode, NULL);
+    list->_size++;
+}
+
+/**
+ *  Removes a node from the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List node belongs to
+ *  \param node Node to remove. Must NOT be list's head
+ */
+static inline void dlinkedlist_counted_remove(struct dlinkedlist_counted* list,
+                                              struct dlinkedlist_node* node) {
+    ASSERT(list != NULL)
+    ASSERT(node != &(list->head))
+    ASSERT(list->_size > 0)
+    dlinkedlist_remove_from(&(list->head), node, NULL);
+    list->_size--;
+}
+
+/**
+ *  Adds an array of nodes after list's head, in array order.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param nodes Nodes to add
+ *  \param count Number of nodes
+ */
+static inline void dlinkedlist_counted_add_head_bulk(
+                                    struct dlinkedlist_counted* list,
+                                    struct dlinkedlist_node* const* nodes,
+                                    size_t count) {
+    ASSERT(list != NULL)
+    dlinkedlist_add_head_bulk(&(list->head), nodes, count, NULL);
+    list->_size += count;
+}
+
+/**
+ *  Adds an array of nodes after list's tail, in array order.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param nodes Nodes to add
+ *  \param count Number of nodes
+ */
+static inline void dlinkedlist_counted_add_tail_bulk(
+                                    struct dlinkedlist_counted* list,
+                                    struct dlinkedlist_node* const* nodes,
+                                    size_t count) {
+    ASSERT(list != NULL)
+    dlinkedlist_add_tail_bulk(&(list->head), nodes, count, NULL);
+    list->_size += count;
+}
+
+/**
+ *  Moves every node matching a predicate after removed's tail, in list
+ *  order, in a single traversal.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ *  \param pred Predicate. Must not modify the list
+ *  \param ctx pred's context. NULL permitted
+ *  \param removed List receiving matching nodes
+ *  \return Number of moved nodes
+ */
+static inline _UINT_LEAST_64_T dlinkedlist_counted_remove_if(
+                                    struct dlinkedlist_counted* list,
+                                    dlinkedlist_predicate pred,
+                                    void* ctx,
+                                    struct dlinkedlist_counted* removed) {
+    ASSERT(list != NULL)
+    ASSERT(removed != NULL)
+    _UINT_LEAST_64_T count = dlinkedlist_remove_if(&(list->head), pred, ctx,
+                                                   &(removed->head), NULL, NULL);
+    list->_size -= count;
+    removed->_size += count;
+    return count;
+}
+
+/**
+ *  Joins two lists together. list's nodes are inserted after head's head.
+ *  list is empty afterwards.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List to add
+ *  \param head List to append to
+ */
+static inline void dlinkedlist_counted_splice(struct dlinkedlist_counted* list,
+                                              struct dlinkedlist_counted* head) {
+    ASSERT(list != NULL)
+    ASSERT(head != NULL)
+    if (list->_size == 0) {return;}
+    dlinkedlist_splice(&(list->head), &(head->head), NULL, NULL);
+    head->_size += list->_size;
+    list->_size = 0;
+}
+
+/**
+ *  Splits a list into two lists, moving node up to head's tail into list,
+ *  when the number of moved nodes is already known.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List to split
+ *  \param list An empty list
+ *  \param node Node separator. Must NOT be head's head
+ *  \param count Number of nodes from node up to head's tail (included)
+ */
+static inline void dlinkedlist_counted_split_count(
+                                        struct dlinkedlist_counted* head,
+                                        struct dlinkedlist_counted* list,
+                                        struct dlinkedlist_node* node,
+                                        _UINT_LEAST_64_T count) {
+    ASSERT(head != NULL)
+    ASSERT(list != NULL)
+    ASSERT(count <= head->_size)
+    if (list->_size != 0) {return;}
+    if (head->_size == 0) {return;}
+    if (node == &(head->head)) {return;}
+    __dlinkedlist_split(&(head->head), &(list->head), node, NULL, NULL);
+    head->_size -= count;
+    list->_size = count;
+}
+
+/**
+ *  Splits a list into two lists, moving node up to head's tail into list.
+ *
+ *  Only moved nodes are walked to update sizes.
+ *
+ *  Time Complexity:    O(k), k being the number of nodes moved to list
+ *  Space Complexity:   O(1)
+ *
+ *  \param head List to split
+ *  \param list An empty list
+ *  \param node Node separator. Must NOT be head's head
+ */
+static inline void dlinkedlist_counted_split(struct dlinkedlist_counted* head,
+                                             struct dlinkedlist_counted* list,
+                                             struct dlinkedlist_node* node) {
+    ASSERT(head != NULL)
+    ASSERT(node != NULL)
+    _UINT_LEAST_64_T count = 0;
+    struct dlinkedlist_node* n = node;
+    while (n != &(head->head)) {
+        count++;
+        n = n->next;
+    }
+    dlinkedlist_counted_split_count(head, list, node, count);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_COUNTED_H_
@@ -0,0 +1,145 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Interleaved traversal of many independent double linked lists
+ *
+ *  Up to "width" lists are walked at once, in round robin. Each cursor
+ *  prefetches its next node before moving on to the next cursor, so that
+ *  several pointer chases are in flight at once (group prefetching /
+ *  asynchronous memory access chaining) instead of one.
+ *
+ *  Nodes of a given list are visited in order. Nodes of different lists are
+ *  visited interleaved.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_INTERLEAVE_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_INTERLEAVE_H_
+
+#include <stddef.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  Maximum number of lists walked at once
+ */
+#define DLINKEDLIST_INTERLEAVE_MAX_WIDTH 32
+
+/**
+ *  Number of lists walked at once when none is specified
+ */
+#define DLINKEDLIST_INTERLEAVE_DEFAULT_WIDTH 8
+
+/**
+ * Visits a node
+ *
+ * \param node Node visited. May be removed from its list or freed.
+ * \param list Index of node's list head
+ * \param ctx Caller provided context
+ */
+typedef void (*dlinkedlist_visit)(struct dlinkedlist_node* node,
+                                  size_t list,
+                                  void* ctx);
+
+EXTERN_C_BEGIN
+
+/**
+ *  Visits every node of several lists, walking up to width lists at once.
+ *
+ *  Time Complexity:    O(n + count)
+ *  Space Complexity:   O(width)
+ *
+ *  \param heads Lists heads
+ *  \param count Number of lists heads
+ *  \param width Number of lists walked at once. 0 uses
+ *               DLINKEDLIST_INTERLEAVE_DEFAULT_WIDTH. Capped to
+ *               DLINKEDLIST_INTERLEAVE_MAX_WIDTH.
+ *  \param offset Node offset within its container, so that containers are
+ *                prefetched along nodes. (size_t)-1 to skip it.
+ *  \param fn Function called on each node
+ *  \param ctx fn's context. NULL permitted
+ */
+static inline void dlinkedlist_interleave_for_each(
+                                        struct dlinkedlist_node* const* heads,
+                                        size_t count,
+                                        unsigned int width,
+                                        size_t offset,
+                                        dlinkedlist_visit fn,
+                                        void* ctx) {
+    ASSERT(heads != NULL || count == 0)
+    ASSERT(fn != NULL)
+    struct dlinkedlist_node* cursors[DLINKEDLIST_INTERLEAVE_MAX_WIDTH];
+    struct dlinkedlist_node* ends[DLINKEDLIST_INTERLEAVE_MAX_WIDTH];
+    size_t lists[DLINKEDLIST_INTERLEAVE_MAX_WIDTH];
+    size_t nextlist = 0;
+    unsigned int active = 0;
+    if (width == 0) {width = DLINKEDLIST_INTERLEAVE_DEFAULT_WIDTH;}
+    if (width > DLINKEDLIST_INTERLEAVE_MAX_WIDTH) {
+        width = DLINKEDLIST_INTERLEAVE_MAX_WIDTH;
+    }
+
+    for (;;) {
+        // Give idle cursors a non empty list to walk
+        while (active < width && nextlist < count) {
+            struct dlinkedlist_node* first = heads[nextlist]->next;
+            if (first != heads[nextlist]) {
+                PREFETCH(first);
+                if (offset != (size_t) -1) {PREFETCH((char*) first - offset);}
+                cursors[active] = first;
+                ends[active] = heads[nextlist];
+                lists[active] = nextlist;
+                active++;
+            }
+            nextlist++;
+        }
+        if (active == 0) {break;}
+
+        // Move every cursor one node further
+        unsigned int slot = 0;
+        while (slot < active) {
+            struct dlinkedlist_node* node = cursors[slot];
+            struct dlinkedlist_node* next = node->next;
+            size_t list = lists[slot];
+            if (next != ends[slot]) {
+                PREFETCH(next);
+                if (offset != (size_t) -1) {PREFETCH((char*) next - offset);}
+                cursors[slot] = next;
+                slot++;
+            } else {
+                // List is done: last active cursor takes its slot
+                active--;
+                cursors[slot] = cursors[active];
+                ends[slot] = ends[active];
+                lists[slot] = lists[active];
+            }
+            fn(node, list, ctx);
+        }
+    }
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_INTERLEAVE_H_
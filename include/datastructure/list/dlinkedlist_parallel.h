@@ -0,0 +1,396 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Parallel double linked list traversal over a work stealing thread pool
+ *  (see datastructure/thread/threadpool.h)
+ *
+ *  The list is partitioned into segments of about the same number of nodes
+ *  in one pass, without modifying it: a segment is a [first, end) range of
+ *  nodes. Each segment is visited by one task, into its own accumulator;
+ *  accumulators are then combined into the result in list order, so that
+ *  reductions need not be commutative.
+ *
+ *  Partitioning costs a sequential walk of the list. Lists traversed
+ *  several times without being modified should keep their partition in a
+ *  struct dlinkedlist_segments (segment index) and traverse it with
+ *  dlinkedlist_parallel_reduce_segments, for traversals to scale with the
+ *  number of threads.
+ *
+ *  Visitors are called concurrently from several threads, on distinct
+ *  nodes. They may modify containers, but neither the list nor its links.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_PARALLEL_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_PARALLEL_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "datastructure/macros.h"
+#include "datastructure/memory/aligned.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/thread/threadpool.h"
+
+/**
+ *  Minimum number of nodes per segment. Smaller lists use fewer segments.
+ *  May be defined before including this file.
+ */
+#ifndef DLINKEDLIST_PARALLEL_MIN_SEGMENT
+    #define DLINKEDLIST_PARALLEL_MIN_SEGMENT 4096
+#endif
+
+/**
+ *  Segments per thread (workers and calling thread) used when partitioning
+ *  on the fly. More segments than threads let fast threads steal the work
+ *  of slow ones. May be defined before including this file.
+ */
+#ifndef DLINKEDLIST_PARALLEL_SEGMENTS_PER_THREAD
+    #define DLINKEDLIST_PARALLEL_SEGMENTS_PER_THREAD 4
+#endif
+
+/**
+ *  Called on every node of the list
+ *
+ *  \param node Node
+ *  \param ctx Caller provided context
+ *  \param acc Accumulator of the node's segment. NULL iff no result
+ */
+typedef void (*dlinkedlist_parallel_visit)(struct dlinkedlist_node* node,
+                                           void* ctx,
+                                           void* acc);
+
+/**
+ *  Folds a segment's accumulator into the result
+ *
+ *  \param result Result
+ *  \param acc Accumulator
+ *  \param ctx Caller provided context
+ */
+typedef void (*dlinkedlist_parallel_combine)(void* result,
+                                             const void* acc,
+                                             void* ctx);
+
+/**
+ *  Segment index of a list
+ */
+struct dlinkedlist_segments {
+    struct dlinkedlist_node* _head;     /** List head */
+    struct dlinkedlist_node** _bounds;  /** Segments' first node, then head */
+    size_t _count;                      /** Number of segments */
+};
+
+/**
+ *  Shared by a traversal's tasks
+ */
+struct __dlinkedlist_parallel_traversal {
+    dlinkedlist_parallel_visit _visit;
+    void* _ctx;
+};
+
+/**
+ *  Visits one segment
+ */
+struct __dlinkedlist_parallel_job {
+    struct threadpool_task _task;
+    struct dlinkedlist_node* _first;
+    struct dlinkedlist_node* _end;
+    void* _acc;
+    const struct __dlinkedlist_parallel_traversal* _traversal;
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Partitions a list into segments of about the same number of nodes, in
+ *  one pass. Adding nodes keeps the index valid (but less balanced).
+ *  Removing a segment's first node invalidates it.
+ *
+ *  Every 2^k-th node is sampled into a buffer of 16 samples per segment;
+ *  whenever the buffer is full, every other sample is dropped and k grows.
+ *  Segment sizes thus differ by less than 1/8 of the average segment size.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(s), s being the number of segments
+ *
+ *  \param segments Segment index
+ *  \param head List head
+ *  \param count Maximum number of segments. At least 1
+ *  \return 0 iff no memory is available
+ */
+static inline int dlinkedlist_segments_init(
+                                    struct dlinkedlist_segments* segments,
+                                    struct dlinkedlist_node* head,
+                                    size_t count) {
+    ASSERT(segments != NULL)
+    ASSERT(head != NULL)
+    ASSERT(count > 0)
+    size_t capacity = count * 16;
+    struct dlinkedlist_node** samples = (struct dlinkedlist_node**) malloc(
+                                capacity * sizeof(struct dlinkedlist_node*));
+    segments->_head = head;
+    segments->_bounds = samples;
+    segments->_count = 0;
+    if (samples == NULL) {return 0;}
+
+    size_t size = 0, sampled = 0, next = 0, step = 1;
+    struct dlinkedlist_node* n;
+    dlinkedlist_for_each(head, n) {
+        if (size == next) {
+            if (sampled == capacity) {
+                for (size_t i = 0; i < capacity / 2; i++) {
+                    samples[i] = samples[i * 2];
+                }
+                sampled = capacity / 2;
+                step <<= 1;
+            }
+            samples[sampled++] = n;
+            next += step;
+        }
+        size++;
+    }
+
+    // Segment i starts at sample i * sampled / count (>= i)
+    if (size / DLINKEDLIST_PARALLEL_MIN_SEGMENT < count) {
+        count = size / DLINKEDLIST_PARALLEL_MIN_SEGMENT;
+        if (count == 0 && size > 0) {count = 1;}
+    }
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = samples[i * sampled / count];
+    }
+    samples[count] = head;
+    segments->_count = count;
+    return 1;
+}
+
+/**
+ *  Frees segment index's memory
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param segments Segment index
+ */
+static inline void dlinkedlist_segments_free(
+                                    struct dlinkedlist_segments* segments) {
+    ASSERT(segments != NULL)
+    free(segments->_bounds);
+    segments->_bounds = NULL;
+    segments->_count = 0;
+}
+
+/**
+ *  Gets the number of segments
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param segments Segment index
+ *  \return Number of segments. 0 iff the list was empty
+ */
+static inline size_t dlinkedlist_segments_count(
+                                const struct dlinkedlist_segments* segments) {
+    ASSERT(segments != NULL)
+    return segments->_count;
+}
+
+/**
+ *  Gets a segment's first node
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param segments Segment index
+ *  \param i Segment. i == count gets the list head (end of last segment)
+ *  \return Segment's first node
+ */
+static inline struct dlinkedlist_node* dlinkedlist_segments_first(
+                                const struct dlinkedlist_segments* segments,
+                                size_t i) {
+    ASSERT(segments != NULL)
+    ASSERT(i <= segments->_count)
+    return segments->_bounds[i];
+}
+
+static inline void __dlinkedlist_parallel_visit_range(
+                            struct dlinkedlist_node* first,
+                            struct dlinkedlist_node* end,
+                            const struct __dlinkedlist_parallel_traversal* t,
+                            void* acc) {
+    struct dlinkedlist_node* n;
+    for (n = first; n != end; n = n->next) {
+        t->_visit(n, t->_ctx, acc);
+    }
+}
+
+static inline void __dlinkedlist_parallel_run(struct threadpool_task* task) {
+    struct __dlinkedlist_parallel_job* job = threadpool_task_entry(task,
+                                    struct __dlinkedlist_parallel_job, _task);
+    __dlinkedlist_parallel_visit_range(job->_first, job->_end,
+                                       job->_traversal, job->_acc);
+}
+
+/**
+ *  Visits every node of an indexed list, segments being visited
+ *  concurrently by the pool's workers and the calling thread, then combines
+ *  segments' accumulators into result, in list order.
+ *
+ *  Each accumulator starts as a copy of result, which MUST therefore hold
+ *  the reduction's identity (eg: 0 for a sum). Falls back to a sequential
+ *  traversal, accumulating directly into result, when there is a single
+ *  thread or segment or when no memory is available.
+ *
+ *  Time Complexity:    O(n / t + s)
+ *  Space Complexity:   O(s)
+ *
+ *  \param pool Pool
+ *  \param segments List's segment index. MUST be valid
+ *  \param visit Visitor. Must be thread safe
+ *  \param combine Combiner. NULL iff resultSize is 0
+ *  \param ctx visit's and combine's context. NULL permitted
+ *  \param result Identity on call, result on return. NULL iff resultSize is 0
+ *  \param resultSize Size of result in bytes. 0 if none
+ */
+static inline void dlinkedlist_parallel_reduce_segments(
+                                struct threadpool* pool,
+                                const struct dlinkedlist_segments* segments,
+                                dlinkedlist_parallel_visit visit,
+                                dlinkedlist_parallel_combine combine,
+                                void* ctx,
+                                void* result,
+                                size_t resultSize) {
+    ASSERT(pool != NULL)
+    ASSERT(segments != NULL)
+    ASSERT(visit != NULL)
+    ASSERT(resultSize == 0 || (combine != NULL && result != NULL))
+    struct __dlinkedlist_parallel_traversal traversal = {visit, ctx};
+    size_t count = segments->_count;
+    // Accumulators start on distinct cache lines
+    size_t stride = ALIGN_UP(resultSize, CACHE_LINE_SIZE);
+    size_t jobsSize = ALIGN_UP(count * sizeof(struct __dlinkedlist_parallel_job),
+                               CACHE_LINE_SIZE);
+    char* memory = NULL;
+    if (count > 1 && threadpool_thread_count(pool) > 0) {
+        memory = (char*) __cache_aligned_malloc(jobsSize + count * stride);
+    }
+    if (memory == NULL) {
+        __dlinkedlist_parallel_visit_range(segments->_head->next,
+                                           segments->_head, &traversal,
+                                           resultSize > 0 ? result : NULL);
+        return;
+    }
+
+    struct __dlinkedlist_parallel_job* jobs =
+                                (struct __dlinkedlist_parallel_job*) memory;
+    struct threadpool_group group;
+    threadpool_group_init(&group);
+    for (size_t i = 0; i < count; i++) {
+        jobs[i]._first = segments->_bounds[i];
+        jobs[i]._end = segments->_bounds[i + 1];
+        jobs[i]._acc = NULL;
+        jobs[i]._traversal = &traversal;
+        if (resultSize > 0) {
+            jobs[i]._acc = memory + jobsSize + i * stride;
+            memcpy(jobs[i]._acc, result, resultSize);
+        }
+        threadpool_submit(pool, &group, &(jobs[i]._task),
+                          __dlinkedlist_parallel_run);
+    }
+    threadpool_wait(pool, &group);
+    if (resultSize > 0) {
+        for (size_t i = 0; i < count; i++) {
+            combine(result, jobs[i]._acc, ctx);
+        }
+    }
+    __cache_aligned_free(memory);
+}
+
+/**
+ *  Visits every node of a list concurrently, then combines segments'
+ *  accumulators into result (see dlinkedlist_parallel_reduce_segments).
+ *  The list is partitioned on the fly into
+ *  DLINKEDLIST_PARALLEL_SEGMENTS_PER_THREAD segments per thread.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(t)
+ *
+ *  \param pool Pool
+ *  \param head List head
+ *  \param visit Visitor. Must be thread safe
+ *  \param combine Combiner. NULL iff resultSize is 0
+ *  \param ctx visit's and combine's context. NULL permitted
+ *  \param result Identity on call, result on return. NULL iff resultSize is 0
+ *  \param resultSize Size of result in bytes. 0 if none
+ */
+static inline void dlinkedlist_parallel_reduce(
+                                        struct threadpool* pool,
+                                        struct dlinkedlist_node* head,
+                                        dlinkedlist_parallel_visit visit,
+                                        dlinkedlist_parallel_combine combine,
+                                        void* ctx,
+                                        void* result,
+                                        size_t resultSize) {
+    ASSERT(pool != NULL)
+    ASSERT(head != NULL)
+    struct dlinkedlist_segments segments;
+    size_t count = (threadpool_thread_count(pool) + 1)
+                        * DLINKEDLIST_PARALLEL_SEGMENTS_PER_THREAD;
+    if (threadpool_thread_count(pool) == 0
+        || !dlinkedlist_segments_init(&segments, head, count)) {
+        struct __dlinkedlist_parallel_traversal traversal = {visit, ctx};
+        __dlinkedlist_parallel_visit_range(head->next, head, &traversal,
+                                           resultSize > 0 ? result : NULL);
+        return;
+    }
+    dlinkedlist_parallel_reduce_segments(pool, &segments, visit, combine, ctx,
+                                         result, resultSize);
+    dlinkedlist_segments_free(&segments);
+}
+
+/**
+ *  Visits every node of a list concurrently (see
+ *  dlinkedlist_parallel_reduce). Accumulators are NULL.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(t)
+ *
+ *  \param pool Pool
+ *  \param head List head
+ *  \param visit Visitor. Must be thread safe
+ *  \param ctx visit's context. NULL permitted
+ */
+static inline void dlinkedlist_parallel_for_each(
+                                        struct threadpool* pool,
+                                        struct dlinkedlist_node* head,
+                                        dlinkedlist_parallel_visit visit,
+                                        void* ctx) {
+    dlinkedlist_parallel_reduce(pool, head, visit, NULL, ctx, NULL, 0);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_PARALLEL_H_
@@ -0,0 +1,200 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Multi threaded double linked list sorting (POSIX threads)
+ *
+ *  The list is cut into one segment per thread with O(1) splits, segments
+ *  are sorted concurrently with dlinkedlist_sort then merged back pairwise,
+ *  concurrently too, with dlinkedlist_merge.
+ *
+ *  Sort is stable. The comparator is called concurrently from several
+ *  threads.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_PARALLEL_SORT_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_PARALLEL_SORT_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_sort.h"
+
+/**
+ *  Minimum number of nodes sorted by a thread. Smaller lists use fewer
+ *  threads. May be defined before including this file.
+ */
+#ifndef DLINKEDLIST_PARALLEL_SORT_MIN_SEGMENT
+    #define DLINKEDLIST_PARALLEL_SORT_MIN_SEGMENT 16384
+#endif
+
+/**
+ *  Work done by one thread: sorting head (list is NULL) or merging list
+ *  into head.
+ */
+struct __dlinkedlist_parallel_sort_job {
+    struct dlinkedlist_node* _head;
+    struct dlinkedlist_node* _list;
+    dlinkedlist_compare _cmp;
+    void* _ctx;
+    pthread_t _thread;
+    int _spawned;
+};
+
+EXTERN_C_BEGIN
+
+static inline void* __dlinkedlist_parallel_sort_run(void* arg) {
+    struct __dlinkedlist_parallel_sort_job* job =
+                                (struct __dlinkedlist_parallel_sort_job*) arg;
+    if (job->_list == NULL) {
+        dlinkedlist_sort(job->_head, job->_cmp, job->_ctx);
+    } else {
+        dlinkedlist_merge(job->_list, job->_head, job->_cmp, job->_ctx,
+                          NULL, NULL);
+    }
+    return NULL;
+}
+
+/**
+ *  Runs jobs concurrently: jobs[1..count-1] on new threads, jobs[0] on the
+ *  calling thread. Jobs whose thread cannot be created run on the calling
+ *  thread.
+ */
+static inline void __dlinkedlist_parallel_sort_run_all(
+                                struct __dlinkedlist_parallel_sort_job* jobs,
+                                unsigned int count) {
+    for (unsigned int i = 1; i < count; i++) {
+        jobs[i]._spawned = pthread_create(&(jobs[i]._thread), NULL,
+                                          __dlinkedlist_parallel_sort_run,
+                                          &(jobs[i])) == 0;
+        if (!jobs[i]._spawned) {
+            __dlinkedlist_parallel_sort_run(&(jobs[i]));
+        }
+    }
+    if (count > 0) {
+        __dlinkedlist_parallel_sort_run(&(jobs[0]));
+    }
+    for (unsigned int i = 1; i < count; i++) {
+        if (jobs[i]._spawned) {
+            pthread_join(jobs[i]._thread, NULL);
+        }
+    }
+}
+
+/**
+ *  Sorts a list in place using several threads. Sort is stable.
+ *
+ *  Falls back to dlinkedlist_sort when the list is too small to be worth
+ *  splitting or when no memory is available.
+ *
+ *  Time Complexity:    O(n log n / t + n)
+ *  Space Complexity:   O(t)
+ *
+ *  \param head List head
+ *  \param cmp Comparator. Must be thread safe
+ *  \param ctx cmp's context. NULL permitted
+ *  \param threads Maximum number of threads (calling thread included).
+ *                 0 uses one thread per online processor
+ */
+static inline void dlinkedlist_parallel_sort(struct dlinkedlist_node* head,
+                                             dlinkedlist_compare cmp,
+                                             void* ctx,
+                                             unsigned int threads) {
+    ASSERT(head != NULL)
+    ASSERT(cmp != NULL)
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned int) online : 1;
+    }
+
+    // Pick number of segments
+    size_t size = 0;
+    struct dlinkedlist_node* n;
+    dlinkedlist_for_each(head, n) {size++;}
+    if (size / DLINKEDLIST_PARALLEL_SORT_MIN_SEGMENT < threads) {
+        threads = (unsigned int) (size / DLINKEDLIST_PARALLEL_SORT_MIN_SEGMENT);
+    }
+    struct __dlinkedlist_parallel_sort_job* jobs = NULL;
+    struct dlinkedlist_node* heads = NULL;
+    if (threads > 1) {
+        jobs = (struct __dlinkedlist_parallel_sort_job*) malloc(
+                    threads * sizeof(struct __dlinkedlist_parallel_sort_job));
+        heads = (struct dlinkedlist_node*) malloc(
+                    threads * sizeof(struct dlinkedlist_node));
+    }
+    if (jobs == NULL || heads == NULL) {
+        free(jobs);
+        free(heads);
+        dlinkedlist_sort(head, cmp, ctx);
+        return;
+    }
+
+    // Cut segments from the tail, segment 0 stays in head
+    size_t segment = size / threads;
+    size_t position = size;
+    n = head;
+    for (unsigned int i = threads - 1; i > 0; i--) {
+        size_t target = segment * i;
+        while (position > target) {
+            n = n->prev;
+            position--;
+        }
+        dlinkedlist_init_head(&(heads[i]), NULL);
+        dlinkedlist_split(head, &(heads[i]), n, NULL, NULL);
+        n = head;
+        position = target;
+    }
+    for (unsigned int i = 0; i < threads; i++) {
+        jobs[i]._head = (i == 0) ? head : &(heads[i]);
+        jobs[i]._list = NULL;
+        jobs[i]._cmp = cmp;
+        jobs[i]._ctx = ctx;
+    }
+    __dlinkedlist_parallel_sort_run_all(jobs, threads);
+
+    // Merge pairs of adjacent segments until one remains. Earlier segment
+    // is always the one merged into, to keep the sort stable.
+    for (unsigned int stride = 1; stride < threads; stride <<= 1) {
+        unsigned int count = 0;
+        for (unsigned int i = 0; i + stride < threads; i += stride << 1) {
+            jobs[count]._head = (i == 0) ? head : &(heads[i]);
+            jobs[count]._list = &(heads[i + stride]);
+            jobs[count]._cmp = cmp;
+            jobs[count]._ctx = ctx;
+            count++;
+        }
+        __dlinkedlist_parallel_sort_run_all(jobs, count);
+    }
+    free(jobs);
+    free(heads);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_PARALLEL_SORT_H_
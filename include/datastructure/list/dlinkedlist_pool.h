@@ -0,0 +1,247 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Fixed size object pool for containers embedding a struct dlinkedlist_node
+ *
+ *  Containers are carved out of contiguous slabs. Released containers are
+ *  kept in a free list threaded through their embedded node, so that:
+ *  - allocating/releasing a container is O(1)
+ *  - releasing a whole list is O(1) (the list is already a chain of nodes)
+ *  - releasing every container of the pool is O(1)
+ *
+ *  Slabs are only returned to the system by dlinkedlist_pool_free.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_POOL_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_POOL_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  Size of a slab header, rounded up so that the first container of the slab
+ *  is suitably aligned for any type.
+ */
+#define __DLINKEDLIST_POOL_SLAB_HEADER_SIZE                                    \
+    ALIGN_UP(sizeof(struct dlinkedlist_node), MAX_ALIGN)
+
+/**
+ *  An object pool
+ */
+struct dlinkedlist_pool {
+    struct dlinkedlist_node _slabs;     /** Slabs allocated so far */
+    struct dlinkedlist_node* _slab;     /** Slab containers are carved from */
+    struct dlinkedlist_node* _free;     /** Released nodes, chained by next */
+    char* _cursor;                      /** First never used container */
+    char* _limit;                       /** End of _slab */
+    size_t _objsize;                    /** Container size */
+    size_t _nodeoffset;                 /** Node offset within container */
+    size_t _slabobjs;                   /** Number of containers per slab */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Initializes an empty pool. No memory is allocated until the first
+ *  container is requested.
+ *
+ *  Containers are laid out like an array of containers, hence objsize MUST
+ *  be sizeof(containertype).
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool
+ *  \param objsize Container size
+ *  \param nodeoffset Offset of the struct dlinkedlist_node within container
+ *  \param slabobjs Number of containers allocated at once. Must be > 0
+ */
+static inline void dlinkedlist_pool_init(struct dlinkedlist_pool* pool,
+                                         size_t objsize,
+                                         size_t nodeoffset,
+                                         size_t slabobjs) {
+    ASSERT(pool != NULL)
+    ASSERT(nodeoffset + sizeof(struct dlinkedlist_node) <= objsize)
+    ASSERT(slabobjs > 0)
+    dlinkedlist_init_head(&(pool->_slabs), NULL);
+    pool->_slab = &(pool->_slabs);
+    pool->_free = NULL;
+    pool->_cursor = NULL;
+    pool->_limit = NULL;
+    pool->_objsize = objsize;
+    pool->_nodeoffset = nodeoffset;
+    pool->_slabobjs = slabobjs;
+}
+
+/**
+ *  Initializes an empty pool for a given container type
+ *
+ *  \param pool Pool
+ *  \param containertype Type of the struct the node is embedded in
+ *  \param member Name of the struct dlinkedlist_node within containertype
+ *  \param slabobjs Number of containers allocated at once. Must be > 0
+ */
+#define dlinkedlist_pool_init_type(pool, containertype, member, slabobjs)      \
+    dlinkedlist_pool_init(pool, sizeof(containertype),                         \
+                          offsetof(containertype, member), slabobjs)
+
+/**
+ *  Moves the pool onto the next slab, allocating it if necessary.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(slabobjs)
+ *
+ *  \param pool Pool
+ *  \return 0 iff no memory is available
+ */
+static inline int __dlinkedlist_pool_grow(struct dlinkedlist_pool* pool) {
+    ASSERT(pool != NULL)
+    struct dlinkedlist_node* slab = pool->_slab->next;
+    if (slab == &(pool->_slabs)) {
+        slab = (struct dlinkedlist_node*) malloc(
+                                    __DLINKEDLIST_POOL_SLAB_HEADER_SIZE
+                                    + pool->_objsize * pool->_slabobjs);
+        if (slab == NULL) {return 0;}
+        dlinkedlist_add_tail(&(pool->_slabs), slab, NULL);
+    }
+    pool->_slab = slab;
+    pool->_cursor = (char*) slab + __DLINKEDLIST_POOL_SLAB_HEADER_SIZE;
+    pool->_limit = pool->_cursor + pool->_objsize * pool->_slabobjs;
+    return 1;
+}
+
+/**
+ *  Gets a container from the pool.
+ *
+ *  Container's content is unspecified. Use dlinkedlist_entry to get the
+ *  container from the returned node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param pool Pool
+ *  \return Node embedded in the container. NULL iff no memory is available
+ */
+static inline struct dlinkedlist_node* dlinkedlist_pool_alloc(
+                                            struct dlinkedlist_pool* pool) {
+    ASSERT(pool != NULL)
+    struct dlinkedlist_node* node = pool->_free;
+    if (node != NULL) {
+        pool->_free = node->next;
+        return node;
+    }
+    if (pool->_cursor == pool->_limit && !__dlinkedlist_pool_grow(pool)) {
+        return NULL;
+    }
+    node = (struct dlinkedlist_node*) (pool->_cursor + pool->_nodeoffset);
+    pool->_cursor += pool->_objsize;
+    return node;
+}
+
+/**
+ *  Gives a container back to the pool. The node MUST NOT be in a list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool the container was allocated from
+ *  \param node Node embedded in the container
+ */
+static inline void dlinkedlist_pool_release(struct dlinkedlist_pool* pool,
+                                            struct dlinkedlist_node* node) {
+    ASSERT(pool != NULL)
+    ASSERT(node != NULL)
+    node->next = pool->_free;
+    pool->_free = node;
+}
+
+/**
+ *  Gives every container of a list back to the pool. List head is left
+ *  untouched (apart from being reinitialized) and is NOT given back.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool all list's containers were allocated from
+ *  \param head List head
+ *  \param size Set list's size to 0 iff NOT NULL
+ */
+static inline void dlinkedlist_pool_release_list(struct dlinkedlist_pool* pool,
+                                                 struct dlinkedlist_node* head,
+                                                 _INT_LEAST_32_T* size) {
+    ASSERT(pool != NULL)
+    ASSERT(head != NULL)
+    if (!dlinkedlist_empty(head)) {
+        head->prev->next = pool->_free;
+        pool->_free = head->next;
+    }
+    dlinkedlist_init_head(head, size);
+}
+
+/**
+ *  Gives every container ever allocated back to the pool. Slabs are kept
+ *  for reuse.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool
+ */
+static inline void dlinkedlist_pool_reset(struct dlinkedlist_pool* pool) {
+    ASSERT(pool != NULL)
+    pool->_slab = &(pool->_slabs);
+    pool->_free = NULL;
+    pool->_cursor = NULL;
+    pool->_limit = NULL;
+}
+
+/**
+ *  Frees pool's memory. Every container allocated from the pool becomes
+ *  invalid.
+ *
+ *  Time Complexity:    O(s) where s is the number of slabs
+ *  Space Complexity:   O(1)
+ *
+ *  \param pool Pool
+ */
+static inline void dlinkedlist_pool_free(struct dlinkedlist_pool* pool) {
+    ASSERT(pool != NULL)
+    struct dlinkedlist_node* slab = pool->_slabs.next;
+    while (slab != &(pool->_slabs)) {
+        struct dlinkedlist_node* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    dlinkedlist_init_head(&(pool->_slabs), NULL);
+    dlinkedlist_pool_reset(pool);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_POOL_H_
@@ -0,0 +1,412 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Read-copy-update double linked list
+ *
+ *  Readers walk the list forward with dlinkedlist_for_each_rcu without
+ *  taking any lock, between dlinkedlist_rcu_read_lock/unlock. Writers MUST
+ *  be serialized by the caller (eg: a mutex) and use the *_rcu variants to
+ *  publish/unpublish nodes.
+ *
+ *  A removed node may still be seen by readers: it is handed over to
+ *  dlinkedlist_rcu_retire and freed by dlinkedlist_rcu_reclaim once every
+ *  reader which could see it has left its read side critical section
+ *  (epoch based grace period).
+ *
+ *  Readers only follow next links: prev links are for writers only.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_RCU_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_RCU_H_
+
+#include <stddef.h>
+#include <sched.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+#ifndef ATOMIC_EXCHANGE
+    #error "dlinkedlist_rcu requires atomic operations (see macros.h)"
+#endif
+
+/**
+ *  Maximum number of readers registered at once on a domain. May be defined
+ *  before including this file.
+ */
+#ifndef DLINKEDLIST_RCU_MAX_READERS
+    #define DLINKEDLIST_RCU_MAX_READERS 64
+#endif
+
+/**
+ *  A reader slot, alone on its cache line
+ */
+struct __dlinkedlist_rcu_reader {
+    _UINT_LEAST_64_T _epoch;    /** Epoch entered. 0 outside read sections */
+    int _used;                  /** 1 iff registered */
+    char _pad[CACHE_LINE_SIZE - sizeof(_UINT_LEAST_64_T) - sizeof(int)];
+};
+
+/**
+ *  A reclamation domain: readers of one or more lists and nodes removed
+ *  from them waiting to be freed.
+ */
+struct dlinkedlist_rcu {
+    _UINT_LEAST_64_T _epoch;                /** Current epoch. Starts at 1 */
+    char _pad[CACHE_LINE_SIZE - sizeof(_UINT_LEAST_64_T)];
+    struct __dlinkedlist_rcu_reader _readers[DLINKEDLIST_RCU_MAX_READERS];
+    struct dlinkedlist_node* _retired;      /** Retired nodes, chained by prev */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Publishes a new node after another node. Readers see either the list
+ *  without newnode or with newnode fully initialized.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node (or list's head) to append newnode to
+ *  \param newnode Node to add
+ *  \param size Size of the list - updated only iff size is NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_add_after_rcu(struct dlinkedlist_node* node,
+                                             struct dlinkedlist_node* newnode,
+                                             _INT_LEAST_32_T* size) {
+    ASSERT(node != NULL)
+    ASSERT(newnode != NULL)
+    struct dlinkedlist_node* next = node->next;
+    newnode->next = next;
+    newnode->prev = node;
+    ATOMIC_STORE_RELEASE(&(node->next), newnode);
+    next->prev = newnode;
+    if (size != NULL) {(*size)++;}
+}
+
+/**
+ *  Publishes a new node before another node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node (or list's head) to prepend newnode to
+ *  \param newnode Node to add
+ *  \param size Size of the list - updated only iff size is NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_add_before_rcu(struct dlinkedlist_node* node,
+                                              struct dlinkedlist_node* newnode,
+                                              _INT_LEAST_32_T* size) {
+    ASSERT(node != NULL)
+    dlinkedlist_add_after_rcu(node->prev, newnode, size);
+}
+
+/**
+ *  Publishes a new node after list's head.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param node Node to add
+ *  \param size Size of the list - updated only iff size is NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_add_head_rcu(struct dlinkedlist_node* head,
+                                            struct dlinkedlist_node* node,
+                                            _INT_LEAST_32_T* size) {
+    dlinkedlist_add_after_rcu(head, node, size);
+}
+
+/**
+ *  Publishes a new node after list's tail.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param node Node to add
+ *  \param size Size of the list - updated only iff size is NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_add_tail_rcu(struct dlinkedlist_node* head,
+                                            struct dlinkedlist_node* node,
+                                            _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    dlinkedlist_add_after_rcu(head->prev, node, size);
+}
+
+/**
+ *  Unpublishes a node. Readers already on node keep walking the list from
+ *  it: node's next link is left untouched, node MUST be retired rather than
+ *  freed or reused.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node to remove
+ *  \param size Size of the list - updated only iff size is NOT NULL. NULL permitted.
+ */
+static inline void dlinkedlist_remove_rcu(struct dlinkedlist_node* node,
+                                          _INT_LEAST_32_T* size) {
+    ASSERT(node != NULL)
+    struct dlinkedlist_node* next = node->next;
+    ATOMIC_STORE_RELEASE(&(node->prev->next), next);
+    next->prev = node->prev;
+    if (size != NULL) {(*size)--;}
+}
+
+/**
+ *  Iterates over a list from a read side critical section
+ *
+ *  \param head List head
+ *  \param node struct dlinkedlist_node* to use as a loop cursor
+ */
+#define dlinkedlist_for_each_rcu(head, node)                                   \
+    for (node = ATOMIC_LOAD_ACQUIRE(&((head)->next));                          \
+         node != (head);                                                       \
+         node = ATOMIC_LOAD_ACQUIRE(&((node)->next)))
+
+/**
+ *  Initializes a domain
+ *
+ *  Time Complexity:    O(r) where r is DLINKEDLIST_RCU_MAX_READERS
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ */
+static inline void dlinkedlist_rcu_init(struct dlinkedlist_rcu* rcu) {
+    ASSERT(rcu != NULL)
+    rcu->_epoch = 1;
+    for (int i = 0; i < DLINKEDLIST_RCU_MAX_READERS; i++) {
+        rcu->_readers[i]._epoch = 0;
+        rcu->_readers[i]._used = 0;
+    }
+    rcu->_retired = NULL;
+}
+
+/**
+ *  Registers the calling reader thread. Thread safe.
+ *
+ *  Time Complexity:    O(r) where r is DLINKEDLIST_RCU_MAX_READERS
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ *  \return Reader slot to pass to read_lock/read_unlock/unregister.
+ *          -1 iff DLINKEDLIST_RCU_MAX_READERS readers are registered already
+ */
+static inline int dlinkedlist_rcu_register(struct dlinkedlist_rcu* rcu) {
+    ASSERT(rcu != NULL)
+    for (int i = 0; i < DLINKEDLIST_RCU_MAX_READERS; i++) {
+        int unused = 0;
+        if (ATOMIC_COMPARE_EXCHANGE(&(rcu->_readers[i]._used), &unused, 1)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ *  Unregisters a reader. Reader MUST be outside any read side critical
+ *  section.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ *  \param reader Reader slot
+ */
+static inline void dlinkedlist_rcu_unregister(struct dlinkedlist_rcu* rcu,
+                                              int reader) {
+    ASSERT(rcu != NULL)
+    ASSERT(reader >= 0 && reader < DLINKEDLIST_RCU_MAX_READERS)
+    ASSERT(rcu->_readers[reader]._epoch == 0)
+    ATOMIC_STORE_RELEASE(&(rcu->_readers[reader]._used), 0);
+}
+
+/**
+ *  Enters a read side critical section. Critical sections do not nest.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ *  \param reader Reader slot of the calling thread
+ */
+static inline void dlinkedlist_rcu_read_lock(struct dlinkedlist_rcu* rcu,
+                                             int reader) {
+    ASSERT(rcu != NULL)
+    ASSERT(reader >= 0 && reader < DLINKEDLIST_RCU_MAX_READERS)
+    ASSERT(rcu->_readers[reader]._epoch == 0)
+    ATOMIC_STORE_RELAXED(&(rcu->_readers[reader]._epoch),
+                         ATOMIC_LOAD_RELAXED(&(rcu->_epoch)));
+    // Epoch MUST be visible before any list pointer is read
+    ATOMIC_THREAD_FENCE();
+}
+
+/**
+ *  Leaves a read side critical section. Nodes seen in it MUST NOT be used
+ *  afterwards.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ *  \param reader Reader slot of the calling thread
+ */
+static inline void dlinkedlist_rcu_read_unlock(struct dlinkedlist_rcu* rcu,
+                                               int reader) {
+    ASSERT(rcu != NULL)
+    ASSERT(reader >= 0 && reader < DLINKEDLIST_RCU_MAX_READERS)
+    ATOMIC_STORE_RELEASE(&(rcu->_readers[reader]._epoch),
+                         (_UINT_LEAST_64_T) 0);
+}
+
+/**
+ *  Starts a new epoch. Nodes unpublished before the call are visible only
+ *  to readers which entered their critical section before the new epoch.
+ *
+ *  \return New epoch
+ */
+static inline _UINT_LEAST_64_T __dlinkedlist_rcu_advance(struct dlinkedlist_rcu* rcu) {
+    _UINT_LEAST_64_T epoch = ATOMIC_FETCH_ADD(&(rcu->_epoch), 1) + 1;
+    // Unpublishing stores MUST be visible before readers' epochs are read
+    ATOMIC_THREAD_FENCE();
+    return epoch;
+}
+
+/**
+ *  Indicates if no reader entered its critical section before epoch
+ */
+static inline int __dlinkedlist_rcu_quiescent(struct dlinkedlist_rcu* rcu,
+                                              _UINT_LEAST_64_T epoch) {
+    for (int i = 0; i < DLINKEDLIST_RCU_MAX_READERS; i++) {
+        _UINT_LEAST_64_T e = ATOMIC_LOAD_ACQUIRE(&(rcu->_readers[i]._epoch));
+        if (e != 0 && e < epoch) {return 0;}
+    }
+    return 1;
+}
+
+/**
+ *  Waits until every reader in a read side critical section at call time
+ *  has left it (grace period). MUST NOT be called from a read side critical
+ *  section.
+ *
+ *  Time Complexity:    O(r) where r is DLINKEDLIST_RCU_MAX_READERS, plus wait
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ */
+static inline void dlinkedlist_rcu_synchronize(struct dlinkedlist_rcu* rcu) {
+    ASSERT(rcu != NULL)
+    _UINT_LEAST_64_T epoch = __dlinkedlist_rcu_advance(rcu);
+    while (!__dlinkedlist_rcu_quiescent(rcu, epoch)) {
+        sched_yield();
+    }
+}
+
+/**
+ *  Hands a node unpublished with dlinkedlist_remove_rcu over for deferred
+ *  freeing. Writer side: serialized with other writers.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param rcu Domain
+ *  \param node Node
+ */
+static inline void dlinkedlist_rcu_retire(struct dlinkedlist_rcu* rcu,
+                                          struct dlinkedlist_node* node) {
+    ASSERT(rcu != NULL)
+    ASSERT(node != NULL)
+    node->prev = rcu->_retired;
+    rcu->_retired = node;
+}
+
+/**
+ *  Calls fn on a chain of retired nodes
+ *
+ *  \return Number of nodes
+ */
+static inline size_t __dlinkedlist_rcu_free_chain(struct dlinkedlist_node* n,
+                                                  dlinkedlist_free_node fn) {
+    size_t count = 0;
+    while (n != NULL) {
+        struct dlinkedlist_node* prev = n->prev;
+        fn(n);
+        n = prev;
+        count++;
+    }
+    return count;
+}
+
+/**
+ *  Frees every node retired so far, once a grace period has elapsed.
+ *  Writer side: serialized with other writers. MUST NOT be called from a
+ *  read side critical section.
+ *
+ *  Time Complexity:    O(k + r), k being the number of retired nodes, plus wait
+ *  Space Complexity:   O(1)
+ *
+ *  \param rcu Domain
+ *  \param fn Function called for freeing a node
+ *  \return Number of freed nodes
+ */
+static inline size_t dlinkedlist_rcu_reclaim(struct dlinkedlist_rcu* rcu,
+                                             dlinkedlist_free_node fn) {
+    ASSERT(rcu != NULL)
+    ASSERT(fn != NULL)
+    struct dlinkedlist_node* retired = rcu->_retired;
+    if (retired == NULL) {return 0;}
+    rcu->_retired = NULL;
+    dlinkedlist_rcu_synchronize(rcu);
+    return __dlinkedlist_rcu_free_chain(retired, fn);
+}
+
+/**
+ *  Frees every node retired so far iff no reader can still see them,
+ *  without waiting. Writer side: serialized with other writers.
+ *
+ *  Time Complexity:    O(k + r), k being the number of retired nodes
+ *  Space Complexity:   O(1)
+ *
+ *  \param rcu Domain
+ *  \param fn Function called for freeing a node
+ *  \return Number of freed nodes
+ */
+static inline size_t dlinkedlist_rcu_try_reclaim(struct dlinkedlist_rcu* rcu,
+                                                 dlinkedlist_free_node fn) {
+    ASSERT(rcu != NULL)
+    ASSERT(fn != NULL)
+    struct dlinkedlist_node* retired = rcu->_retired;
+    if (retired == NULL) {return 0;}
+    if (!__dlinkedlist_rcu_quiescent(rcu, __dlinkedlist_rcu_advance(rcu))) {
+        return 0;
+    }
+    rcu->_retired = NULL;
+    return __dlinkedlist_rcu_free_chain(retired, fn);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_RCU_H_
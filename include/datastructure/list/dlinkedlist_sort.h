@@ -0,0 +1,222 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Double linked list in place sorting and merging
+ *
+ *  Both operations are stable and allocation free.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_SORT_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_SORT_H_
+
+#include <stddef.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  Maximum number of pending runs. Sorts up to 2^64 nodes.
+ */
+#define __DLINKEDLIST_SORT_MAX_RUNS 64
+
+/**
+ * Compares two nodes
+ *
+ * \param a Node
+ * \param b Node
+ * \param ctx Caller provided context
+ *
+ * \return < 0 iff a goes before b, 0 iff a and b are equivalent, > 0 otherwise
+ */
+typedef int (*dlinkedlist_compare)(const struct dlinkedlist_node* a,
+                                   const struct dlinkedlist_node* b,
+                                   void* ctx);
+
+/**
+ *  Merges two sorted NULL terminated chains of nodes linked by next only.
+ *  On equivalent nodes, a's node goes first.
+ *
+ *  Comparisons are expanded in place, for comparators known at compile time
+ *  (eg: C++ functors, see intrusive_list.hpp) to be inlined.
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param result Receives the merged chain
+ *  \param a Chain
+ *  \param b Chain
+ *  \param before Macro: before(x, y) is non 0 iff node x goes strictly
+ *                before node y
+ */
+#define __DLINKEDLIST_MERGE_CHAINS(result, a, b, before)                       \
+    do {                                                                       \
+        struct dlinkedlist_node __first;                                       \
+        struct dlinkedlist_node* __tail = &__first;                            \
+        struct dlinkedlist_node* __a = (a);                                    \
+        struct dlinkedlist_node* __b = (b);                                    \
+        while (__a != NULL && __b != NULL) {                                   \
+            if (before(__b, __a)) {                                            \
+                __tail->next = __b;                                            \
+                __b = __b->next;                                               \
+            } else {                                                           \
+                __tail->next = __a;                                            \
+                __a = __a->next;                                               \
+            }                                                                  \
+            __tail = __tail->next;                                             \
+        }                                                                      \
+        __tail->next = (__a != NULL) ? __a : __b;                              \
+        (result) = __first.next;                                               \
+    } while (0)
+
+/**
+ *  Sorts a list in place with a bottom up merge sort (see dlinkedlist_sort)
+ *
+ *  \param head List head
+ *  \param before Macro: before(x, y) is non 0 iff node x goes strictly
+ *                before node y
+ */
+#define __DLINKEDLIST_SORT(head, before)                                       \
+    do {                                                                       \
+        struct dlinkedlist_node* __head = (head);                              \
+        struct dlinkedlist_node* __runs[__DLINKEDLIST_SORT_MAX_RUNS];          \
+        struct dlinkedlist_node* __n;                                          \
+        struct dlinkedlist_node* __sorted = NULL;                              \
+        struct dlinkedlist_node* __prev = __head;                              \
+        int __maxrun = 0;                                                      \
+        if (__head->next == __head->prev) {break;}                             \
+        /* Merge nodes into runs. Run i holds 2^i nodes, older than run        \
+           j < i */                                                            \
+        __head->prev->next = NULL;                                             \
+        __n = __head->next;                                                    \
+        while (__n != NULL) {                                                  \
+            struct dlinkedlist_node* __carry = __n;                            \
+            int __i = 0;                                                       \
+            __n = __n->next;                                                   \
+            __carry->next = NULL;                                              \
+            while (__i < __maxrun && __runs[__i] != NULL) {                    \
+                __DLINKEDLIST_MERGE_CHAINS(__carry, __runs[__i], __carry,      \
+                                           before);                            \
+                __runs[__i] = NULL;                                            \
+                __i++;                                                         \
+            }                                                                  \
+            if (__i == __maxrun) {                                             \
+                __maxrun++;                                                    \
+            }                                                                  \
+            __runs[__i] = __carry;                                             \
+        }                                                                      \
+        /* Merge all runs, newest first */                                     \
+        for (int __i = 0; __i < __maxrun; __i++) {                             \
+            if (__runs[__i] != NULL) {                                         \
+                __DLINKEDLIST_MERGE_CHAINS(__sorted, __runs[__i], __sorted,    \
+                                           before);                            \
+            }                                                                  \
+        }                                                                      \
+        /* Rebuild prev links */                                               \
+        __head->next = __sorted;                                               \
+        for (__n = __sorted; __n != NULL; __n = __n->next) {                   \
+            __n->prev = __prev;                                                \
+            __prev = __n;                                                      \
+        }                                                                      \
+        __prev->next = __head;                                                 \
+        __head->prev = __prev;                                                 \
+    } while (0)
+
+EXTERN_C_BEGIN
+
+/**
+ *  Sorts a list in place with a bottom up merge sort. Sort is stable.
+ *
+ *  Nodes are first linked by next only into runs whose lengths are powers of
+ *  2 (merged like a binary counter), then prev links are rebuilt.
+ *
+ *  Time Complexity:    O(n log n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param head List head
+ *  \param cmp Comparator
+ *  \param ctx cmp's context. NULL permitted
+ */
+static inline void dlinkedlist_sort(struct dlinkedlist_node* head,
+                                    dlinkedlist_compare cmp,
+                                    void* ctx) {
+    ASSERT(head != NULL)
+    ASSERT(cmp != NULL)
+    #define __DLINKEDLIST_SORT_BEFORE(x, y) (cmp((y), (x), ctx) > 0)
+    __DLINKEDLIST_SORT(head, __DLINKEDLIST_SORT_BEFORE);
+    #undef __DLINKEDLIST_SORT_BEFORE
+}
+
+/**
+ *  Merges a sorted list into another sorted list. Merge is stable: on
+ *  equivalent nodes, head's nodes go first. list is empty afterwards.
+ *
+ *  Runs of consecutive list's nodes are moved at once.
+ *
+ *  Time Complexity:    O(n + m)
+ *  Space Complexity:   O(1)
+ *
+ *  \param list Head of sorted list to merge
+ *  \param head Head of sorted list to merge into
+ *  \param cmp Comparator
+ *  \param ctx cmp's context. NULL permitted
+ *  \param listSize list parameter's size. NULL permitted
+ *  \param headSize head parameter's size updated only iff listSize and
+ *                  headSize are NOT NULL. NULL permitted
+ */
+static inline void dlinkedlist_merge(struct dlinkedlist_node* list,
+                                     struct dlinkedlist_node* head,
+                                     dlinkedlist_compare cmp,
+                                     void* ctx,
+                                     _INT_LEAST_32_T* listSize,
+                                     _INT_LEAST_32_T* headSize) {
+    ASSERT(list != NULL)
+    ASSERT(head != NULL)
+    ASSERT(cmp != NULL)
+    struct dlinkedlist_node* h = head->next;
+    while (!dlinkedlist_empty(list)) {
+        if (h == head) {
+            // Remaining list's nodes go after head's tail
+            __dlinkedlist_splice(list, head->prev, head, NULL, NULL);
+            dlinkedlist_init_head(list, NULL);
+            break;
+        }
+        struct dlinkedlist_node* first = list->next;
+        if (cmp(first, h, ctx) < 0) {
+            struct dlinkedlist_node* last = first;
+            while (last->next != list && cmp(last->next, h, ctx) < 0) {
+                last = last->next;
+            }
+            __dlinkedlist_move_range(first, last, h->prev, h);
+        }
+        h = h->next;
+    }
+    if (headSize != NULL && listSize != NULL) {*headSize += *listSize;}
+    if (listSize != NULL) {*listSize = 0;}
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_SORT_H_
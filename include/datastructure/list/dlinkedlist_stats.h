@@ -0,0 +1,453 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Opt-in operations statistics for struct dlinkedlist_node lists
+ *
+ *  Compiled in iff DATASTRUCTURE_STATS is defined (see STATS in macros.h):
+ *  otherwise dlinkedlist.h does not include this file and costs nothing.
+ *
+ *  Statistics are kept per list head, in a per thread table of counters
+ *  (no atomic read-modify-write, no shared cache line), and merged across
+ *  threads by dlinkedlist_stats_collect:
+ *  - adds, removes, splices and splits
+ *  - traversals (dlinkedlist_for_each* macros, hence dlinkedlist_size):
+ *    count, visited nodes and an histogram of traversal lengths
+ *
+ *  Operations not given the list head (dlinkedlist_add_after,
+ *  dlinkedlist_add_before, dlinkedlist_add_chain_after,
+ *  dlinkedlist_add_after_bulk, dlinkedlist_remove) are accounted to the
+ *  NULL head: use dlinkedlist_add_after_in, dlinkedlist_add_before_in and
+ *  dlinkedlist_remove_from to account them to their list. dlinkedlist_splice_range is not accounted. A traversal left
+ *  early (break) is recorded when the next traversal of the same list
+ *  starts (by the same thread); a traversal nested in a traversal of the
+ *  same list cuts the outer one short.
+ *
+ *  Heads are identified by address: a head reused after being freed keeps
+ *  the counters of its predecessor. Thread tables outlive their threads, so
+ *  that totals include exited threads.
+ *
+ *  Requires GCC/clang (thread local storage, atomics) and POSIX threads.
+ *  Exactly one translation unit of the program MUST contain
+ *  DLINKEDLIST_STATS_DEFINE (at file scope).
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_STATS_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "datastructure/macros.h"
+
+#ifndef ATOMIC_LOAD_RELAXED
+    #error "dlinkedlist statistics require atomic operations (see macros.h)"
+#endif
+
+/**
+ *  Number of traversal length histogram buckets. Bucket 0 counts empty
+ *  traversals, bucket b counts traversals of [2^(b-1), 2^b) nodes and the
+ *  last bucket every longer traversal.
+ */
+#define DLINKEDLIST_STATS_BUCKETS 24
+
+/** Counters */
+#define __DLINKEDLIST_STATS_ADDS        0
+#define __DLINKEDLIST_STATS_REMOVES     1
+#define __DLINKEDLIST_STATS_SPLICES     2
+#define __DLINKEDLIST_STATS_SPLITS      3
+#define __DLINKEDLIST_STATS_WALKS       4
+#define __DLINKEDLIST_STATS_WALKED      5
+#define __DLINKEDLIST_STATS_COUNTERS    6
+
+/** Initial number of slots of a thread table. Power of 2 */
+#define __DLINKEDLIST_STATS_SLOTS       16
+
+/**
+ *  Statistics of a list head, merged across threads
+ */
+struct dlinkedlist_stats {
+    const void* head;       /** List head. NULL for operations given no head */
+    uint64_t adds;          /** Nodes added */
+    uint64_t removes;       /** Nodes removed */
+    uint64_t splices;       /** Lists spliced into head */
+    uint64_t splits;        /** Times head was split/cut */
+    uint64_t walks;         /** Traversals */
+    uint64_t walked;        /** Nodes visited by traversals */
+    uint64_t walklengths[DLINKEDLIST_STATS_BUCKETS]; /** Traversal lengths histogram */
+};
+
+/**
+ *  Counters of a list head, in a thread table
+ */
+struct __dlinkedlist_stats_slot {
+    const void* _head;                  /** List head */
+    int _used;                          /** 0 iff the slot is free */
+    int _walking;                       /** A traversal is in progress */
+    uint64_t _walk;                     /** Nodes visited so far by it */
+    uint64_t _counters[__DLINKEDLIST_STATS_COUNTERS];
+    uint64_t _walklengths[DLINKEDLIST_STATS_BUCKETS];
+};
+
+/**
+ *  Counters of one thread (open addressing hash table). Only the owner
+ *  thread updates counters; slots are added/moved under _lock, which
+ *  readers hold while reading.
+ */
+struct __dlinkedlist_stats_table {
+    struct __dlinkedlist_stats_table* _next;    /** Next registered table */
+    pthread_mutex_t _lock;
+    struct __dlinkedlist_stats_slot* _slots;
+    struct __dlinkedlist_stats_slot* _last;     /** Last slot looked up */
+    size_t _mask;                               /** Number of slots - 1 */
+    size_t _size;                               /** Number of used slots */
+};
+
+/**
+ *  Every thread table
+ */
+struct __dlinkedlist_stats_registry {
+    pthread_mutex_t _lock;
+    struct __dlinkedlist_stats_table* _tables;
+};
+
+EXTERN_C_BEGIN
+
+extern struct __dlinkedlist_stats_registry __dlinkedlist_stats_registry;
+extern __thread struct __dlinkedlist_stats_table* __dlinkedlist_stats_local;
+
+EXTERN_C_END
+
+/**
+ *  Defines statistics storage. MUST appear in exactly one translation unit.
+ */
+#define DLINKEDLIST_STATS_DEFINE                                               \
+    struct __dlinkedlist_stats_registry __dlinkedlist_stats_registry =         \
+        {PTHREAD_MUTEX_INITIALIZER, NULL};                                     \
+    __thread struct __dlinkedlist_stats_table* __dlinkedlist_stats_local = NULL;
+
+EXTERN_C_BEGIN
+
+/**
+ *  Histogram bucket of a traversal length
+ *
+ *  Time Complexity:    O(log(length))
+ *  Space Complexity:   O(0)
+ *
+ *  \param length Number of nodes visited
+ *  \return Bucket in [0, DLINKEDLIST_STATS_BUCKETS)
+ */
+static inline int dlinkedlist_stats_bucket(uint64_t length) {
+    int bucket = 0;
+    while (length != 0 && bucket < DLINKEDLIST_STATS_BUCKETS - 1) {
+        length >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static inline size_t __dlinkedlist_stats_hash(const void* head) {
+    uint64_t h = (uint64_t) (uintptr_t) head;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return (size_t) h;
+}
+
+/**
+ *  Slot holding head's counters, or the free slot they belong to
+ */
+static inline struct __dlinkedlist_stats_slot* __dlinkedlist_stats_probe(
+                                        struct __dlinkedlist_stats_slot* slots,
+                                        size_t mask,
+                                        const void* head) {
+    size_t i = __dlinkedlist_stats_hash(head) & mask;
+    while (slots[i]._used && slots[i]._head != head) {
+        i = (i + 1) & mask;
+    }
+    return &(slots[i]);
+}
+
+/**
+ *  Calling thread's table, created and registered on first use
+ *
+ *  \return NULL iff no memory is available
+ */
+static inline struct __dlinkedlist_stats_table* __dlinkedlist_stats_table(void) {
+    struct __dlinkedlist_stats_table* table = __dlinkedlist_stats_local;
+    if (table != NULL) {return table;}
+    table = (struct __dlinkedlist_stats_table*) calloc(1, sizeof(*table));
+    if (table == NULL) {return NULL;}
+    table->_slots = (struct __dlinkedlist_stats_slot*) calloc(
+                __DLINKEDLIST_STATS_SLOTS, sizeof(struct __dlinkedlist_stats_slot));
+    if (table->_slots == NULL) {
+        free(table);
+        return NULL;
+    }
+    pthread_mutex_init(&(table->_lock), NULL);
+    table->_mask = __DLINKEDLIST_STATS_SLOTS - 1;
+    pthread_mutex_lock(&(__dlinkedlist_stats_registry._lock));
+    table->_next = __dlinkedlist_stats_registry._tables;
+    __dlinkedlist_stats_registry._tables = table;
+    pthread_mutex_unlock(&(__dlinkedlist_stats_registry._lock));
+    __dlinkedlist_stats_local = table;
+    return table;
+}
+
+/**
+ *  Calling thread's counters of a list head, created on first use
+ *
+ *  Time Complexity:    O(1) amortized
+ *  Space Complexity:   O(1) amortized
+ *
+ *  \param head List head
+ *  \return NULL iff no memory is available
+ */
+static inline struct __dlinkedlist_stats_slot* __dlinkedlist_stats_slot(
+                                                        const void* head) {
+    struct __dlinkedlist_stats_table* table = __dlinkedlist_stats_table();
+    if (table == NULL) {return NULL;}
+    if (table->_last != NULL && table->_last->_head == head) {
+        return table->_last;
+    }
+    struct __dlinkedlist_stats_slot* slot = __dlinkedlist_stats_probe(
+                                        table->_slots, table->_mask, head);
+    if (!slot->_used) {
+        pthread_mutex_lock(&(table->_lock));
+        if ((table->_size + 1) * 4 > (table->_mask + 1) * 3) {
+            // Keep the load factor under 3/4
+            size_t mask = table->_mask * 2 + 1;
+            struct __dlinkedlist_stats_slot* slots =
+                (struct __dlinkedlist_stats_slot*) calloc(
+                        mask + 1, sizeof(struct __dlinkedlist_stats_slot));
+            if (slots == NULL) {
+                pthread_mutex_unlock(&(table->_lock));
+                return NULL;
+            }
+            for (size_t i = 0; i <= table->_mask; i++) {
+                if (!table->_slots[i]._used) {continue;}
+                *__dlinkedlist_stats_probe(slots, mask,
+                                           table->_slots[i]._head)
+                    = table->_slots[i];
+            }
+            free(table->_slots);
+            table->_slots = slots;
+            table->_mask = mask;
+            slot = __dlinkedlist_stats_probe(slots, mask, head);
+        }
+        slot->_head = head;
+        slot->_used = 1;
+        table->_size++;
+        pthread_mutex_unlock(&(table->_lock));
+    }
+    table->_last = slot;
+    return slot;
+}
+
+/**
+ *  Adds to a counter. Only the owner thread writes it: no read-modify-write
+ *  atomic is needed, relaxed accesses keep concurrent readers defined.
+ */
+static inline void __dlinkedlist_stats_inc(uint64_t* counter, uint64_t value) {
+    ATOMIC_STORE_RELAXED(counter, ATOMIC_LOAD_RELAXED(counter) + value);
+}
+
+/**
+ *  Accounts an operation to a list head
+ *
+ *  \param head List head. NULL if unknown
+ *  \param counter __DLINKEDLIST_STATS_*
+ *  \param value Amount
+ */
+static inline void __dlinkedlist_stats_count(const void* head, int counter,
+                                             uint64_t value) {
+    struct __dlinkedlist_stats_slot* slot = __dlinkedlist_stats_slot(head);
+    if (slot == NULL) {return;}
+    __dlinkedlist_stats_inc(&(slot->_counters[counter]), value);
+}
+
+static inline void __dlinkedlist_stats_walk_end(
+                                        struct __dlinkedlist_stats_slot* slot) {
+    __dlinkedlist_stats_inc(&(slot->_counters[__DLINKEDLIST_STATS_WALKS]), 1);
+    __dlinkedlist_stats_inc(&(slot->_counters[__DLINKEDLIST_STATS_WALKED]),
+                            slot->_walk);
+    __dlinkedlist_stats_inc(
+                &(slot->_walklengths[dlinkedlist_stats_bucket(slot->_walk)]), 1);
+    slot->_walking = 0;
+}
+
+/**
+ *  Starts accounting a traversal
+ *
+ *  \param head List head
+ */
+static inline void __dlinkedlist_stats_walk_begin(const void* head) {
+    struct __dlinkedlist_stats_slot* slot = __dlinkedlist_stats_slot(head);
+    if (slot == NULL) {return;}
+    if (slot->_walking) {
+        // Previous traversal was left early
+        __dlinkedlist_stats_walk_end(slot);
+    }
+    slot->_walk = 0;
+    slot->_walking = 1;
+}
+
+/**
+ *  Accounts a traversal step
+ *
+ *  \param head List head
+ *  \param more 0 iff the traversal is over
+ *  \return more
+ */
+static inline int __dlinkedlist_stats_walk_step(const void* head, int more) {
+    struct __dlinkedlist_stats_slot* slot = __dlinkedlist_stats_slot(head);
+    if (slot == NULL || !slot->_walking) {return more;}
+    if (more) {
+        slot->_walk++;
+    } else {
+        __dlinkedlist_stats_walk_end(slot);
+    }
+    return more;
+}
+
+static inline int __dlinkedlist_stats_compare(const void* a, const void* b) {
+    uintptr_t ha = (uintptr_t) ((const struct dlinkedlist_stats*) a)->head;
+    uintptr_t hb = (uintptr_t) ((const struct dlinkedlist_stats*) b)->head;
+    return ha < hb ? -1 : (ha > hb ? 1 : 0);
+}
+
+/**
+ *  Merges every thread's statistics. May run concurrently with list
+ *  operations: operations in progress may or may not be accounted for.
+ *
+ *  Time Complexity:    O(s log(s)), s being the number of (thread, head) pairs
+ *  Space Complexity:   O(s)
+ *
+ *  \param count Set to the number of returned heads
+ *  \return Statistics sorted by head address, to be freed by the caller.
+ *          NULL iff no memory is available (count set to 0)
+ */
+static inline struct dlinkedlist_stats* dlinkedlist_stats_collect(
+                                                        size_t* count) {
+    ASSERT(count != NULL)
+    struct __dlinkedlist_stats_table* table;
+    struct dlinkedlist_stats* stats;
+    size_t capacity = 1;
+    size_t n = 0;
+    *count = 0;
+    pthread_mutex_lock(&(__dlinkedlist_stats_registry._lock));
+    for (table = __dlinkedlist_stats_registry._tables; table != NULL;
+         table = table->_next) {
+        pthread_mutex_lock(&(table->_lock));
+        capacity += table->_size;
+        pthread_mutex_unlock(&(table->_lock));
+    }
+    stats = (struct dlinkedlist_stats*) calloc(capacity,
+                                               sizeof(struct dlinkedlist_stats));
+    if (stats == NULL) {
+        pthread_mutex_unlock(&(__dlinkedlist_stats_registry._lock));
+        return NULL;
+    }
+    for (table = __dlinkedlist_stats_registry._tables; table != NULL;
+         table = table->_next) {
+        pthread_mutex_lock(&(table->_lock));
+        for (size_t i = 0; i <= table->_mask && n < capacity; i++) {
+            struct __dlinkedlist_stats_slot* slot = &(table->_slots[i]);
+            uint64_t* c = slot->_counters;
+            if (!slot->_used) {continue;}
+            stats[n].head = slot->_head;
+            stats[n].adds = ATOMIC_LOAD_RELAXED(&c[__DLINKEDLIST_STATS_ADDS]);
+            stats[n].removes = ATOMIC_LOAD_RELAXED(&c[__DLINKEDLIST_STATS_REMOVES]);
+            stats[n].splices = ATOMIC_LOAD_RELAXED(&c[__DLINKEDLIST_STATS_SPLICES]);
+            stats[n].splits = ATOMIC_LOAD_RELAXED(&c[__DLINKEDLIST_STATS_SPLITS]);
+            stats[n].walks = ATOMIC_LOAD_RELAXED(&c[__DLINKEDLIST_STATS_WALKS]);
+            stats[n].walked = ATOMIC_LOAD_RELAXED(&c[__DLINKEDLIST_STATS_WALKED]);
+            for (int b = 0; b < DLINKEDLIST_STATS_BUCKETS; b++) {
+                stats[n].walklengths[b] =
+                    ATOMIC_LOAD_RELAXED(&(slot->_walklengths[b]));
+            }
+            n++;
+        }
+        pthread_mutex_unlock(&(table->_lock));
+    }
+    pthread_mutex_unlock(&(__dlinkedlist_stats_registry._lock));
+
+    // Merge threads' counters of the same head
+    qsort(stats, n, sizeof(struct dlinkedlist_stats),
+          __dlinkedlist_stats_compare);
+    size_t merged = 0;
+    for (size_t i = 0; i < n; i++) {
+        struct dlinkedlist_stats* to;
+        if (merged == 0 || stats[merged - 1].head != stats[i].head) {
+            stats[merged++] = stats[i];
+            continue;
+        }
+        to = &(stats[merged - 1]);
+        to->adds += stats[i].adds;
+        to->removes += stats[i].removes;
+        to->splices += stats[i].splices;
+        to->splits += stats[i].splits;
+        to->walks += stats[i].walks;
+        to->walked += stats[i].walked;
+        for (int b = 0; b < DLINKEDLIST_STATS_BUCKETS; b++) {
+            to->walklengths[b] += stats[i].walklengths[b];
+        }
+    }
+    *count = merged;
+    return stats;
+}
+
+/**
+ *  Zeroes every thread's statistics. Heads stay known.
+ *
+ *  Time Complexity:    O(s), s being the number of (thread, head) pairs
+ *  Space Complexity:   O(0)
+ */
+static inline void dlinkedlist_stats_reset(void) {
+    struct __dlinkedlist_stats_table* table;
+    pthread_mutex_lock(&(__dlinkedlist_stats_registry._lock));
+    for (table = __dlinkedlist_stats_registry._tables; table != NULL;
+         table = table->_next) {
+        pthread_mutex_lock(&(table->_lock));
+        for (size_t i = 0; i <= table->_mask; i++) {
+            struct __dlinkedlist_stats_slot* slot = &(table->_slots[i]);
+            for (int c = 0; c < __DLINKEDLIST_STATS_COUNTERS; c++) {
+                ATOMIC_STORE_RELAXED(&(slot->_counters[c]), (uint64_t) 0);
+            }
+            for (int b = 0; b < DLINKEDLIST_STATS_BUCKETS; b++) {
+                ATOMIC_STORE_RELAXED(&(slot->_walklengths[b]), (uint64_t) 0);
+            }
+        }
+        pthread_mutex_unlock(&(table->_lock));
+    }
+    pthread_mutex_unlock(&(__dlinkedlist_stats_registry._lock));
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_STATS_H_
@@ -0,0 +1,153 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Typed iterators over a double linked list, specialized at compile time
+ *  for a given container type.
+ *
+ *  Unlike struct iterator, there is no function pointer nor access mode
+ *  check: every operation is a static inline function the compiler can
+ *  inline down to plain pointer chasing.
+ *
+ *  Eg:
+ *
+ *  struct foo {
+ *      int bar;
+ *      struct dlinkedlist_node list;
+ *  };
+ *
+ *  DLINKEDLIST_DEFINE_TYPED_ITERATOR(foo_iterator, struct foo, list)
+ *
+ *  struct foo_iterator it;
+ *  struct foo* e;
+ *  foo_iterator_init(&it, head);
+ *  while ((e = foo_iterator_next(&it)) != NULL) {
+ *      ...
+ *  }
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_TYPED_ITERATOR_H_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_TYPED_ITERATOR_H_
+
+#include <stddef.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  Defines a typed iterator named "name" over lists of containertype.
+ *
+ *  Defines:
+ *  - struct name
+ *
+ *  - void name_init(struct name* it, struct dlinkedlist_node* head)
+ *    Binds the iterator to a list. Iterator is positioned before the first
+ *    entry.
+ *
+ *  - containertype* name_begin(struct name* it)
+ *    Returns the first entry (NULL iff empty). Iterator does NOT move.
+ *
+ *  - containertype* name_end(struct name* it)
+ *    Returns the last entry (NULL iff empty). Iterator does NOT move.
+ *
+ *  - containertype* name_next(struct name* it)
+ *    Moves the iterator onto the next entry. Returns it or NULL once the
+ *    iterator moved past the last entry, where it stays.
+ *
+ *  - containertype* name_prev(struct name* it)
+ *    Moves the iterator onto the previous entry. Returns it or NULL once the
+ *    iterator moved before the first entry, where it stays.
+ *
+ *  - containertype* name_current(struct name* it)
+ *    Returns entry the iterator is positioned on (NULL iff before the first
+ *    or past the last entry).
+ *
+ *  Like struct iterator, begin/end do not move the iterator and next/prev
+ *  stop on both ends of the list rather than wrapping around. As list's
+ *  head is not an entry, begin/end return the first/last entry where
+ *  struct iterator returns its head/tail sentinels.
+ *
+ *  Time Complexity:    O(1) for all functions
+ *  Space Complexity:   O(0) for all functions
+ *
+ *  \param name Iterator's name
+ *  \param containertype Type of the struct the node is embedded in
+ *  \param member Name of the struct dlinkedlist_node within containertype
+ */
+#define DLINKEDLIST_DEFINE_TYPED_ITERATOR(name, containertype, member)         \
+    struct name {                                                              \
+        struct dlinkedlist_node* _head;                                        \
+        struct dlinkedlist_node* _current; /* NULL iff past the last entry */  \
+    };                                                                         \
+                                                                               \
+    static inline containertype* name##_current(struct name* it) {             \
+        ASSERT(it != NULL)                                                     \
+        return (it->_current == NULL || it->_current == it->_head) ? NULL :    \
+            dlinkedlist_entry(it->_current, containertype, member);            \
+    }                                                                          \
+                                                                               \
+    static inline void name##_init(struct name* it,                            \
+                                   struct dlinkedlist_node* head) {            \
+        ASSERT(it != NULL)                                                     \
+        ASSERT(head != NULL)                                                   \
+        it->_head = head;                                                      \
+        it->_current = head;                                                   \
+    }                                                                          \
+                                                                               \
+    static inline containertype* name##_begin(struct name* it) {               \
+        ASSERT(it != NULL)                                                     \
+        return it->_head->next == it->_head ? NULL :                           \
+            dlinkedlist_entry(it->_head->next, containertype, member);         \
+    }                                                                          \
+                                                                               \
+    static inline containertype* name##_end(struct name* it) {                 \
+        ASSERT(it != NULL)                                                     \
+        return it->_head->prev == it->_head ? NULL :                           \
+            dlinkedlist_entry(it->_head->prev, containertype, member);         \
+    }                                                                          \
+                                                                               \
+    static inline containertype* name##_next(struct name* it) {                \
+        ASSERT(it != NULL)                                                     \
+        if (it->_current == NULL) {                                            \
+            return NULL;                                                       \
+        }                                                                      \
+        it->_current = it->_current->next;                                     \
+        if (it->_current == it->_head) {                                       \
+            it->_current = NULL;                                               \
+        }                                                                      \
+        return name##_current(it);                                             \
+    }                                                                          \
+                                                                               \
+    static inline containertype* name##_prev(struct name* it) {                \
+        ASSERT(it != NULL)                                                     \
+        if (it->_current == it->_head) {                                       \
+            return NULL;                                                       \
+        }                                                                      \
+        it->_current = it->_current == NULL ? it->_head->prev :                \
+                                              it->_current->prev;              \
+        return name##_current(it);                                             \
+    }
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_TYPED_ITERATOR_H_
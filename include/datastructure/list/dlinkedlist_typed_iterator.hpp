@@ -0,0 +1,294 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  C++ typed bidirectional iterator over a double linked list, specialized
+ *  at compile time for a given container type and node member.
+ *
+ *  Every operation is inlined down to plain pointer chasing.
+ *
+ *  Eg:
+ *
+ *  struct foo {
+ *      int bar;
+ *      struct dlinkedlist_node list;
+ *  };
+ *
+ *  typedef datastructure::dlinkedlist_typed_iterator<foo, &foo::list> it;
+ *  for (it i = it::begin(head); i != it::end(head); ++i) {
+ *      i->bar ...
+ *  }
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_TYPED_ITERATOR_HPP_
+#define INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_TYPED_ITERATOR_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include "datastructure/list/dlinkedlist.h"
+
+namespace datastructure {
+
+/**
+ *  Conversions between a container and its embedded node
+ *
+ *  \tparam T Type of the struct the node is embedded in
+ *  \tparam Member struct dlinkedlist_node member within T
+ */
+template <typename T, struct dlinkedlist_node T::*Member>
+struct dlinkedlist_member_traits {
+    /**
+     * Offset of Member within T
+     */
+    static std::ptrdiff_t offset() {
+        return _offset;
+    }
+
+    /**
+     * Get the container for this node
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    static T* entry(struct dlinkedlist_node* node) {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(node) - offset());
+    }
+
+    /**
+     * Get the container for this node
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    static const T* entry(const struct dlinkedlist_node* node) {
+        return reinterpret_cast<const T*>(
+                        reinterpret_cast<const char*>(node) - offset());
+    }
+
+    /**
+     * Get the node embedded in this container
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    static struct dlinkedlist_node* node(T* container) {
+        return &(container->*Member);
+    }
+
+ private:
+    /**
+     * Layout whose padding before _t is T's alignment
+     */
+    struct __alignment_probe {
+        char _c;
+        T _t;
+    };
+
+    /**
+     * Computes Member's offset over static storage aligned for T
+     */
+    static std::ptrdiff_t __offset() {
+        static const std::size_t alignment =
+            sizeof(__alignment_probe) - sizeof(T);
+        static char storage[sizeof(T) + alignment];
+        std::size_t address = reinterpret_cast<std::size_t>(storage);
+        address = (address + alignment - 1) / alignment * alignment;
+        const T* container = reinterpret_cast<const T*>(address);
+        return reinterpret_cast<const char*>(&(container->*Member))
+               - reinterpret_cast<const char*>(container);
+    }
+
+    static const std::ptrdiff_t _offset;
+};
+
+template <typename T, struct dlinkedlist_node T::*Member>
+const std::ptrdiff_t dlinkedlist_member_traits<T, Member>::_offset =
+    dlinkedlist_member_traits<T, Member>::__offset();
+
+/**
+ *  Bidirectional iterator over the containers of a list
+ *
+ *  \tparam T Type of the struct the node is embedded in
+ *  \tparam Member struct dlinkedlist_node member within T
+ */
+template <typename T, struct dlinkedlist_node T::*Member>
+class dlinkedlist_typed_iterator {
+ public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef dlinkedlist_member_traits<T, Member> traits;
+
+    dlinkedlist_typed_iterator() : _current(NULL) {}
+
+    explicit dlinkedlist_typed_iterator(struct dlinkedlist_node* node)
+        : _current(node) {}
+
+    /**
+     * Iterator on list's first container
+     */
+    static dlinkedlist_typed_iterator begin(struct dlinkedlist_node* head) {
+        return dlinkedlist_typed_iterator(head->next);
+    }
+
+    /**
+     * Past-the-end iterator (ie: on list's head)
+     */
+    static dlinkedlist_typed_iterator end(struct dlinkedlist_node* head) {
+        return dlinkedlist_typed_iterator(head);
+    }
+
+    reference operator*() const { return *traits::entry(_current); }
+    pointer operator->() const { return traits::entry(_current); }
+
+    dlinkedlist_typed_iterator& operator++() {
+        _current = _current->next;
+        return *this;
+    }
+
+    dlinkedlist_typed_iterator operator++(int) {
+        dlinkedlist_typed_iterator previous(*this);
+        _current = _current->next;
+        return previous;
+    }
+
+    dlinkedlist_typed_iterator& operator--() {
+        _current = _current->prev;
+        return *this;
+    }
+
+    dlinkedlist_typed_iterator operator--(int) {
+        dlinkedlist_typed_iterator previous(*this);
+        _current = _current->prev;
+        return previous;
+    }
+
+    bool operator==(const dlinkedlist_typed_iterator& other) const {
+        return _current == other._current;
+    }
+
+    bool operator!=(const dlinkedlist_typed_iterator& other) const {
+        return _current != other._current;
+    }
+
+    /**
+     * Node the iterator is positioned on
+     */
+    struct dlinkedlist_node* node() const { return _current; }
+
+ private:
+    struct dlinkedlist_node* _current;
+};
+
+/**
+ *  Bidirectional iterator over the containers of a list, read only
+ *
+ *  \tparam T Type of the struct the node is embedded in
+ *  \tparam Member struct dlinkedlist_node member within T
+ */
+template <typename T, struct dlinkedlist_node T::*Member>
+class dlinkedlist_typed_const_iterator {
+ public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+    typedef dlinkedlist_member_traits<T, Member> traits;
+
+    dlinkedlist_typed_const_iterator() : _current(NULL) {}
+
+    explicit dlinkedlist_typed_const_iterator(
+                                        const struct dlinkedlist_node* node)
+        : _current(node) {}
+
+    dlinkedlist_typed_const_iterator(
+                        const dlinkedlist_typed_iterator<T, Member>& other)
+        : _current(other.node()) {}
+
+    /**
+     * Iterator on list's first container
+     */
+    static dlinkedlist_typed_const_iterator begin(
+                                        const struct dlinkedlist_node* head) {
+        return dlinkedlist_typed_const_iterator(head->next);
+    }
+
+    /**
+     * Past-the-end iterator (ie: on list's head)
+     */
+    static dlinkedlist_typed_const_iterator end(
+                                        const struct dlinkedlist_node* head) {
+        return dlinkedlist_typed_const_iterator(head);
+    }
+
+    reference operator*() const { return *traits::entry(_current); }
+    pointer operator->() const { return traits::entry(_current); }
+
+    dlinkedlist_typed_const_iterator& operator++() {
+        _current = _current->next;
+        return *this;
+    }
+
+    dlinkedlist_typed_const_iterator operator++(int) {
+        dlinkedlist_typed_const_iterator previous(*this);
+        _current = _current->next;
+        return previous;
+    }
+
+    dlinkedlist_typed_const_iterator& operator--() {
+        _current = _current->prev;
+        return *this;
+    }
+
+    dlinkedlist_typed_const_iterator operator--(int) {
+        dlinkedlist_typed_const_iterator previous(*this);
+        _current = _current->prev;
+        return previous;
+    }
+
+    bool operator==(const dlinkedlist_typed_const_iterator& other) const {
+        return _current == other._current;
+    }
+
+    bool operator!=(const dlinkedlist_typed_const_iterator& other) const {
+        return _current != other._current;
+    }
+
+    /**
+     * Node the iterator is positioned on
+     */
+    const struct dlinkedlist_node* node() const { return _current; }
+
+ private:
+    const struct dlinkedlist_node* _current;
+};
+
+}  // namespace datastructure
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_DLINKEDLIST_TYPED_ITERATOR_HPP_
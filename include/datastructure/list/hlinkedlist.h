@@ -0,0 +1,291 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Hash list (instrusive list with a single pointer head) inspired from
+ *  Linux Kernel's hlist.
+ *
+ *  A list head is a single pointer, half the size of a struct
+ *  dlinkedlist_node, which suits large arrays of list heads such as hash
+ *  table buckets. Lists are NULL terminated: the tail can not be reached in
+ *  O(1). Each node points to the pointer pointing to it (either the head's
+ *  or the previous node's), so that a node is removed in O(1) without
+ *  knowing its list head.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_HLINKEDLIST_H_
+#define INCLUDE_DATASTRUCTURE_LIST_HLINKEDLIST_H_
+
+#include <stddef.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  A hash list node
+ */
+struct hlinkedlist_node {
+    struct hlinkedlist_node*    next;   /** Next node */
+    struct hlinkedlist_node**   pprev;  /** Pointer pointing to this node */
+};
+
+/**
+ *  A hash list head
+ */
+struct hlinkedlist_head {
+    struct hlinkedlist_node*    first;  /** First node */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ * Get the struc for this entry
+ *
+ * Time Complexity: O(1)
+ * Space Complexity: O(0)
+ */
+#define hlinkedlist_entry(ptr, containertype, member)                          \
+    __dlinkedlist_container_of(ptr, containertype, member)
+
+/**
+ * Iterates over a list forward
+ *
+ * \param head	Lists head.
+ * \param node	the &struct hlinkedlist_node to use as a loop cursor.
+ */
+#define hlinkedlist_for_each(head, node)                                      \
+    for (node = (head)->first; node != NULL; node = (node)->next)
+
+/**
+ * Iterates over a list forward. node may be removed from the list.
+ *
+ * \param head	Lists head.
+ * \param node	the &struct hlinkedlist_node to use as a loop cursor.
+ * \param next	another &struct hlinkedlist_node to use as temporary storage
+ */
+#define hlinkedlist_for_each_safe(head, node, next)                           \
+    for (node = (head)->first;                                                \
+         node != NULL && ((next = (node)->next), 1);                          \
+         node = next)
+
+/**
+ *  Initializes a list's head
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param size Set list size to 0 iff NOT NULL
+ */
+static inline void hlinkedlist_init_head(struct hlinkedlist_head* head,
+                                         _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    head->first = NULL;
+    if (size != NULL) {*size = 0;}
+}
+
+/**
+ *  Initializes a node as not being in any list
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node
+ */
+static inline void hlinkedlist_init_node(struct hlinkedlist_node* node) {
+    ASSERT(node != NULL)
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+/**
+ *  Indicates if a node initialized by hlinkedlist_init_node (or removed
+ *  since) is in a list
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node
+ *  \return 0 if node is in a list.
+ */
+static inline int hlinkedlist_unhashed(const struct hlinkedlist_node* node) {
+    ASSERT(node != NULL)
+    return node->pprev == NULL;
+}
+
+/**
+ *  Indicates if the list is empty
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \return 0 if not empty.
+ */
+static inline int hlinkedlist_empty(const struct hlinkedlist_head* head) {
+    ASSERT(head != NULL)
+    return head->first == NULL;
+}
+
+/**
+ *  Gets list's size
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param head List head
+ *  \return size
+ */
+static inline _INT_LEAST_32_T hlinkedlist_size(
+                                        const struct hlinkedlist_head* head) {
+    ASSERT(head != NULL)
+    _INT_LEAST_32_T size = 0;
+    const struct hlinkedlist_node* node;
+    hlinkedlist_for_each(head, node) {size++;}
+    return size;
+}
+
+/**
+ *  Adds a new node before list's first node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param node Node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void hlinkedlist_add_head(struct hlinkedlist_head* head,
+                                        struct hlinkedlist_node* node,
+                                        _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    ASSERT(node != NULL)
+    struct hlinkedlist_node* first = head->first;
+    node->next = first;
+    if (first != NULL) {first->pprev = &(node->next);}
+    head->first = node;
+    node->pprev = &(head->first);
+    if (size != NULL) {(*size)++;}
+}
+
+/**
+ *  Adds a new node before another node of the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node to prepend to
+ *  \param newNode Node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void hlinkedlist_add_before(struct hlinkedlist_node* node,
+                                          struct hlinkedlist_node* newNode,
+                                          _INT_LEAST_32_T* size) {
+    ASSERT(node != NULL)
+    ASSERT(newNode != NULL)
+    newNode->pprev = node->pprev;
+    newNode->next = node;
+    node->pprev = &(newNode->next);
+    *(newNode->pprev) = newNode;
+    if (size != NULL) {(*size)++;}
+}
+
+/**
+ *  Adds a new node after another node of the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node to append to
+ *  \param newNode Node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void hlinkedlist_add_after(struct hlinkedlist_node* node,
+                                         struct hlinkedlist_node* newNode,
+                                         _INT_LEAST_32_T* size) {
+    ASSERT(node != NULL)
+    ASSERT(newNode != NULL)
+    newNode->next = node->next;
+    node->next = newNode;
+    newNode->pprev = &(node->next);
+    if (newNode->next != NULL) {newNode->next->pprev = &(newNode->next);}
+    if (size != NULL) {(*size)++;}
+}
+
+/**
+ *  Removes a node from its list. The node is left as initialized by
+ *  hlinkedlist_init_node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param node Node to delete
+ *  \param size Decrements list size iff NOT NULL
+ */
+static inline void hlinkedlist_remove(struct hlinkedlist_node* node,
+                                      _INT_LEAST_32_T* size) {
+    ASSERT(node != NULL)
+    ASSERT(node->pprev != NULL)
+    struct hlinkedlist_node* next = node->next;
+    *(node->pprev) = next;
+    if (next != NULL) {next->pprev = node->pprev;}
+    hlinkedlist_init_node(node);
+    if (size != NULL) {(*size)--;}
+}
+
+/**
+ *  Moves every node of list before head's first node. list is empty
+ *  afterwards.
+ *
+ *  Time Complexity:    O(k), k being list's size
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List to add
+ *  \param head List to prepend to
+ *  \param listSize list parameter's size. NULL permitted
+ *  \param headSize head parameter's size updated only iff listSize and
+ *                  headSize are NOT NULL. NULL permitted
+ */
+static inline void hlinkedlist_splice(struct hlinkedlist_head* list,
+                                      struct hlinkedlist_head* head,
+                                      _INT_LEAST_32_T* listSize,
+                                      _INT_LEAST_32_T* headSize) {
+    ASSERT(list != NULL)
+    ASSERT(head != NULL)
+    if (hlinkedlist_empty(list)) {return;}
+    struct hlinkedlist_node* last = list->first;
+    while (last->next != NULL) {last = last->next;}
+    last->next = head->first;
+    if (head->first != NULL) {head->first->pprev = &(last->next);}
+    head->first = list->first;
+    head->first->pprev = &(head->first);
+    if (headSize != NULL && listSize != NULL) {*headSize += *listSize;}
+    hlinkedlist_init_head(list, listSize);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_HLINKEDLIST_H_
@@ -0,0 +1,492 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Index linked double linked list
+ *
+ *  Containers live in an arena (an array of containers) and embed a
+ *  struct ilinkedlist_node linking them by 32 bits arena indices: 8 bytes
+ *  per node instead of 16 for struct dlinkedlist_node on 64 bits hosts.
+ *
+ *  Lists are NIL terminated (not circular): a list head holds its first and
+ *  last indices. Any number of lists may share an arena. Every function
+ *  takes the arena nodes live in.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_ILINKEDLIST_H_
+#define INCLUDE_DATASTRUCTURE_LIST_ILINKEDLIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  Index of no node
+ */
+#define ILINKEDLIST_NIL UINT32_MAX
+
+/**
+ *  A node
+ */
+struct ilinkedlist_node {
+    uint32_t next;
+    uint32_t prev;
+};
+
+/**
+ *  A list head
+ */
+struct ilinkedlist_head {
+    uint32_t first;
+    uint32_t last;
+};
+
+/**
+ *  An arena of containers. Containers may also be handed out by the arena
+ *  itself, with released ones kept in a free list threaded through their
+ *  node.
+ */
+struct ilinkedlist_arena {
+    char* _base;                /** First container */
+    size_t _stride;             /** Container size */
+    size_t _offset;             /** Node offset within container */
+    uint32_t _capacity;         /** Number of containers */
+    uint32_t _cursor;           /** First never allocated container */
+    uint32_t _free;             /** Released containers, chained by next */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Initializes an arena on caller provided containers. Memory is NOT
+ *  owned by the arena.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param base First container
+ *  \param stride Container size, sizeof(containertype)
+ *  \param offset Offset of the struct ilinkedlist_node within container
+ *  \param capacity Number of containers. Must be < ILINKEDLIST_NIL
+ */
+static inline void ilinkedlist_arena_init(struct ilinkedlist_arena* arena,
+                                          void* base,
+                                          size_t stride,
+                                          size_t offset,
+                                          uint32_t capacity) {
+    ASSERT(arena != NULL)
+    ASSERT(base != NULL || capacity == 0)
+    ASSERT(offset + sizeof(struct ilinkedlist_node) <= stride)
+    ASSERT(capacity < ILINKEDLIST_NIL)
+    arena->_base = (char*) base;
+    arena->_stride = stride;
+    arena->_offset = offset;
+    arena->_capacity = capacity;
+    arena->_cursor = 0;
+    arena->_free = ILINKEDLIST_NIL;
+}
+
+/**
+ *  Initializes an arena on an array of containers
+ *
+ *  \param arena Arena
+ *  \param array Array of containertype
+ *  \param containertype Type of the struct the node is embedded in
+ *  \param member Name of the struct ilinkedlist_node within containertype
+ *  \param capacity Number of containers in array
+ */
+#define ilinkedlist_arena_init_type(arena, array, containertype, member,        \
+                                    capacity)                                  \
+    ilinkedlist_arena_init(arena, array, sizeof(containertype),                \
+                           offsetof(containertype, member), capacity)
+
+/**
+ *  Gets the node of a container
+ *
+ *  \param arena Arena
+ *  \param index Container index. Must NOT be ILINKEDLIST_NIL
+ *  \return Node
+ */
+static inline struct ilinkedlist_node* ilinkedlist_node(
+                                        const struct ilinkedlist_arena* arena,
+                                        uint32_t index) {
+    ASSERT(arena != NULL)
+    ASSERT(index < arena->_capacity)
+    return (struct ilinkedlist_node*) (arena->_base + arena->_offset
+                                       + (size_t) index * arena->_stride);
+}
+
+/**
+ *  Gets a container
+ *
+ *  \param arena Arena
+ *  \param index Container index. Must NOT be ILINKEDLIST_NIL
+ *  \param containertype Type of the struct the node is embedded in
+ */
+#define ilinkedlist_entry(arena, index, containertype)                         \
+    ((containertype*) ((arena)->_base + (size_t) (index) * (arena)->_stride))
+
+/**
+ *  Gets a container's index
+ *
+ *  \param arena Arena
+ *  \param ptr Container
+ *  \return Index
+ */
+static inline uint32_t ilinkedlist_index(const struct ilinkedlist_arena* arena,
+                                         const void* ptr) {
+    ASSERT(arena != NULL)
+    ASSERT((const char*) ptr >= arena->_base)
+    return (uint32_t) (((const char*) ptr - arena->_base) / arena->_stride);
+}
+
+/**
+ *  Gets an unused container from the arena
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \return Container index. ILINKEDLIST_NIL iff every container is in use
+ */
+static inline uint32_t ilinkedlist_arena_alloc(struct ilinkedlist_arena* arena) {
+    ASSERT(arena != NULL)
+    uint32_t index = arena->_free;
+    if (index != ILINKEDLIST_NIL) {
+        arena->_free = ilinkedlist_node(arena, index)->next;
+        return index;
+    }
+    if (arena->_cursor == arena->_capacity) {return ILINKEDLIST_NIL;}
+    return arena->_cursor++;
+}
+
+/**
+ *  Gives a container back to the arena. Its node MUST NOT be in a list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param index Container index
+ */
+static inline void ilinkedlist_arena_release(struct ilinkedlist_arena* arena,
+                                             uint32_t index) {
+    ASSERT(arena != NULL)
+    ilinkedlist_node(arena, index)->next = arena->_free;
+    arena->_free = index;
+}
+
+/**
+ *  Initializes a list's head
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \param size Set list size to 0 iff NOT NULL
+ */
+static inline void ilinkedlist_init_head(struct ilinkedlist_head* head,
+                                         _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    head->first = ILINKEDLIST_NIL;
+    head->last = ILINKEDLIST_NIL;
+    if (size != NULL) {*size = 0;}
+}
+
+/**
+ *  Indicates if the list is empty
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param head List head
+ *  \return 0 if not empty.
+ */
+static inline int ilinkedlist_empty(const struct ilinkedlist_head* head) {
+    ASSERT(head != NULL)
+    return head->first == ILINKEDLIST_NIL;
+}
+
+/**
+ *  Iterates over a list
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param index uint32_t to use as a loop cursor
+ */
+#define ilinkedlist_for_each(arena, head, index)                               \
+    for (index = (head)->first;                                                \
+         index != ILINKEDLIST_NIL;                                             \
+         index = ilinkedlist_node(arena, index)->next)
+
+/**
+ *  Iterates over a list backward
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param index uint32_t to use as a loop cursor
+ */
+#define ilinkedlist_for_each_prev(arena, head, index)                          \
+    for (index = (head)->last;                                                 \
+         index != ILINKEDLIST_NIL;                                             \
+         index = ilinkedlist_node(arena, index)->prev)
+
+/**
+ *  Gets list's size
+ *
+ *  Time Complexity:    O(n)
+ *  Space Complexity:   O(1)
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \return size
+ */
+static inline _INT_LEAST_32_T ilinkedlist_size(const struct ilinkedlist_arena* arena,
+                                               const struct ilinkedlist_head* head) {
+    ASSERT(head != NULL)
+    _INT_LEAST_32_T size = 0;
+    uint32_t index;
+    ilinkedlist_for_each(arena, head, index) {size++;}
+    return size;
+}
+
+/**
+ *  Links a node between prev and next (either may be ILINKEDLIST_NIL)
+ */
+static inline void __ilinkedlist_add(const struct ilinkedlist_arena* arena,
+                                     struct ilinkedlist_head* head,
+                                     uint32_t index,
+                                     uint32_t prev,
+                                     uint32_t next,
+                                     _INT_LEAST_32_T* size) {
+    struct ilinkedlist_node* node = ilinkedlist_node(arena, index);
+    node->prev = prev;
+    node->next = next;
+    if (prev == ILINKEDLIST_NIL) {
+        head->first = index;
+    } else {
+        ilinkedlist_node(arena, prev)->next = index;
+    }
+    if (next == ILINKEDLIST_NIL) {
+        head->last = index;
+    } else {
+        ilinkedlist_node(arena, next)->prev = index;
+    }
+    if (size != NULL) {(*size)++;}
+}
+
+/**
+ *  Adds a new node before list's first node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param index Container index of the node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void ilinkedlist_add_head(const struct ilinkedlist_arena* arena,
+                                        struct ilinkedlist_head* head,
+                                        uint32_t index,
+                                        _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    __ilinkedlist_add(arena, head, index, ILINKEDLIST_NIL, head->first, size);
+}
+
+/**
+ *  Adds a new node after list's last node.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param index Container index of the node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void ilinkedlist_add_tail(const struct ilinkedlist_arena* arena,
+                                        struct ilinkedlist_head* head,
+                                        uint32_t index,
+                                        _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    __ilinkedlist_add(arena, head, index, head->last, ILINKEDLIST_NIL, size);
+}
+
+/**
+ *  Adds a new node after another node of the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param at Container index of the node to append to
+ *  \param index Container index of the node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void ilinkedlist_add_after(const struct ilinkedlist_arena* arena,
+                                         struct ilinkedlist_head* head,
+                                         uint32_t at,
+                                         uint32_t index,
+                                         _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    __ilinkedlist_add(arena, head, index, at, ilinkedlist_node(arena, at)->next,
+                      size);
+}
+
+/**
+ *  Adds a new node before another node of the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param at Container index of the node to prepend to
+ *  \param index Container index of the node to add
+ *  \param size Increments list size iff NOT NULL
+ */
+static inline void ilinkedlist_add_before(const struct ilinkedlist_arena* arena,
+                                          struct ilinkedlist_head* head,
+                                          uint32_t at,
+                                          uint32_t index,
+                                          _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    __ilinkedlist_add(arena, head, index, ilinkedlist_node(arena, at)->prev, at,
+                      size);
+}
+
+/**
+ *  Removes a node from the list.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param head List head
+ *  \param index Container index of the node to remove
+ *  \param size Decrements list size iff NOT NULL
+ */
+static inline void ilinkedlist_remove(const struct ilinkedlist_arena* arena,
+                                      struct ilinkedlist_head* head,
+                                      uint32_t index,
+                                      _INT_LEAST_32_T* size) {
+    ASSERT(head != NULL)
+    struct ilinkedlist_node* node = ilinkedlist_node(arena, index);
+    if (node->prev == ILINKEDLIST_NIL) {
+        head->first = node->next;
+    } else {
+        ilinkedlist_node(arena, node->prev)->next = node->next;
+    }
+    if (node->next == ILINKEDLIST_NIL) {
+        head->last = node->prev;
+    } else {
+        ilinkedlist_node(arena, node->next)->prev = node->prev;
+    }
+    if (size != NULL) {(*size)--;}
+}
+
+/**
+ *  Joins two lists together. list's nodes are inserted before head's first
+ *  node. list is empty afterwards.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param list List to add
+ *  \param head List to prepend to
+ *  \param listSize list parameter's size. NULL permitted
+ *  \param headSize head parameter's size updated only iff listSize and
+ *                  headSize are NOT NULL. NULL permitted
+ */
+static inline void ilinkedlist_splice(const struct ilinkedlist_arena* arena,
+                                      struct ilinkedlist_head* list,
+                                      struct ilinkedlist_head* head,
+                                      _INT_LEAST_32_T* listSize,
+                                      _INT_LEAST_32_T* headSize) {
+    ASSERT(list != NULL)
+    ASSERT(head != NULL)
+    if (ilinkedlist_empty(list)) {return;}
+    if (ilinkedlist_empty(head)) {
+        head->last = list->last;
+    } else {
+        ilinkedlist_node(arena, list->last)->next = head->first;
+        ilinkedlist_node(arena, head->first)->prev = list->last;
+    }
+    head->first = list->first;
+    if (headSize != NULL && listSize != NULL) {*headSize += *listSize;}
+    ilinkedlist_init_head(list, listSize);
+}
+
+/**
+ *  Splits a list into two lists, moving index up to head's last node into
+ *  list.
+ *
+ *  Time Complexity:    O(1), O(k) iff sizes are requested
+ *  Space Complexity:   O(0)
+ *
+ *  \param arena Arena
+ *  \param head List to split
+ *  \param list An empty list
+ *  \param index Container index of the separator node
+ *  \param headSize head parameter's size. NULL permitted
+ *  \param listSize list parameter's size updated only iff listSize and
+ *                  headSize are NOT NULL. NULL permitted
+ */
+static inline void ilinkedlist_split(const struct ilinkedlist_arena* arena,
+                                     struct ilinkedlist_head* head,
+                                     struct ilinkedlist_head* list,
+                                     uint32_t index,
+                                     _INT_LEAST_32_T* headSize,
+                                     _INT_LEAST_32_T* listSize) {
+    ASSERT(head != NULL)
+    ASSERT(list != NULL)
+    if (!ilinkedlist_empty(list)) {return;}
+    if (ilinkedlist_empty(head)) {return;}
+    if (index == ILINKEDLIST_NIL) {return;}
+    struct ilinkedlist_node* node = ilinkedlist_node(arena, index);
+    list->first = index;
+    list->last = head->last;
+    head->last = node->prev;
+    if (node->prev == ILINKEDLIST_NIL) {
+        head->first = ILINKEDLIST_NIL;
+    } else {
+        ilinkedlist_node(arena, node->prev)->next = ILINKEDLIST_NIL;
+    }
+    node->prev = ILINKEDLIST_NIL;
+    if (headSize != NULL && listSize != NULL) {
+        *listSize = ilinkedlist_size(arena, list);
+        *headSize -= *listSize;
+    }
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_ILINKEDLIST_H_
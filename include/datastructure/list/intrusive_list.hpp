@@ -0,0 +1,337 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  C++ intrusive list of containers embedding a struct dlinkedlist_node,
+ *  specialized at compile time for a given container type and node member.
+ *
+ *  The list only owns its head: containers are linked/unlinked, never
+ *  copied, allocated or freed. Every operation is a thin inlined wrapper
+ *  over dlinkedlist.h, so that traversals compile down to the same pointer
+ *  chasing as dlinkedlist_for_each, and the head interoperates with the C
+ *  API (see head()).
+ *
+ *  Eg:
+ *
+ *  struct foo {
+ *      int bar;
+ *      struct dlinkedlist_node list;
+ *  };
+ *
+ *  datastructure::intrusive_list<foo, &foo::list> foos;
+ *  foos.push_back(f);
+ *  for (foo& f : foos) {...}
+ *  std::find_if(foos.begin(), foos.end(), ...);
+ *
+ *  Containers still linked when the list is destroyed keep pointing to the
+ *  destroyed head: clear() (O(1)) only forgets them.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_INTRUSIVE_LIST_HPP_
+#define INCLUDE_DATASTRUCTURE_LIST_INTRUSIVE_LIST_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_sort.h"
+#include "datastructure/list/dlinkedlist_typed_iterator.hpp"
+
+namespace datastructure {
+
+/**
+ *  Intrusive double linked list
+ *
+ *  \tparam T Type of the struct the node is embedded in
+ *  \tparam Member struct dlinkedlist_node member within T
+ */
+template <typename T, struct dlinkedlist_node T::*Member>
+class intrusive_list {
+ public:
+    typedef T value_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef dlinkedlist_typed_iterator<T, Member> iterator;
+    typedef dlinkedlist_typed_const_iterator<T, Member> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef dlinkedlist_member_traits<T, Member> traits;
+
+    /**
+     * Empty list
+     */
+    intrusive_list() { dlinkedlist_init_head(&_head, NULL); }
+
+#if __cplusplus >= 201103L
+    /**
+     * Takes other's containers. other is left empty.
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    intrusive_list(intrusive_list&& other) {
+        dlinkedlist_init_head(&_head, NULL);
+        _take(other);
+    }
+
+    /**
+     * Forgets list's containers then takes other's. other is left empty.
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    intrusive_list& operator=(intrusive_list&& other) {
+        if (this != &other) {
+            clear();
+            _take(other);
+        }
+        return *this;
+    }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+#endif
+
+    iterator begin() { return iterator::begin(&_head); }
+    iterator end() { return iterator::end(&_head); }
+    const_iterator begin() const { return const_iterator::begin(&_head); }
+    const_iterator end() const { return const_iterator::end(&_head); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * Iterator on a container of the list
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    static iterator iterator_to(reference value) {
+        return iterator(traits::node(&value));
+    }
+
+    /**
+     * List head, for use with the C API
+     */
+    struct dlinkedlist_node* head() { return &_head; }
+
+    bool empty() const { return dlinkedlist_empty(&_head) != 0; }
+
+    /**
+     * Number of containers
+     *
+     * Time Complexity: O(n)
+     * Space Complexity: O(0)
+     */
+    size_type size() const {
+        return static_cast<size_type>(dlinkedlist_size(&_head));
+    }
+
+    reference front() { return *traits::entry(_head.next); }
+    const_reference front() const { return *traits::entry(_head.next); }
+    reference back() { return *traits::entry(_head.prev); }
+    const_reference back() const { return *traits::entry(_head.prev); }
+
+    void push_front(reference value) {
+        dlinkedlist_add_head(&_head, traits::node(&value), NULL);
+    }
+
+    void push_back(reference value) {
+        dlinkedlist_add_tail(&_head, traits::node(&value), NULL);
+    }
+
+    /**
+     * Unlinks the first container. List MUST NOT be empty
+     */
+    void pop_front() { dlinkedlist_remove(_head.next, NULL); }
+
+    /**
+     * Unlinks the last container. List MUST NOT be empty
+     */
+    void pop_back() { dlinkedlist_remove(_head.prev, NULL); }
+
+    /**
+     * Links value before pos
+     *
+     * \return Iterator on value
+     */
+    iterator insert(iterator pos, reference value) {
+        struct dlinkedlist_node* node = traits::node(&value);
+        dlinkedlist_add_before(pos.node(), node, NULL);
+        return iterator(node);
+    }
+
+    /**
+     * Unlinks pos's container
+     *
+     * \return Iterator on the following container
+     */
+    iterator erase(iterator pos) {
+        struct dlinkedlist_node* next = pos.node()->next;
+        dlinkedlist_remove(pos.node(), NULL);
+        return iterator(next);
+    }
+
+    /**
+     * Unlinks [first, last) containers
+     *
+     * Time Complexity: O(k), k being the number of containers unlinked
+     * Space Complexity: O(0)
+     *
+     * \return last
+     */
+    iterator erase(iterator first, iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return last;
+    }
+
+    /**
+     * Forgets every container. Containers are left as is.
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    void clear() { dlinkedlist_init_head(&_head, NULL); }
+
+    /**
+     * Moves every other's container before pos
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    void splice(iterator pos, intrusive_list& other) {
+        if (other.empty()) {return;}
+        dlinkedlist_splice_range(other._head.next, other._head.prev,
+                                 pos.node()->prev, 0, NULL, NULL);
+    }
+
+    /**
+     * Moves other's container it before pos
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    void splice(iterator pos, intrusive_list& other, iterator it) {
+        (void) other;
+        if (pos == it || pos.node()->prev == it.node()) {return;}
+        dlinkedlist_splice_range(it.node(), it.node(), pos.node()->prev, 1,
+                                 NULL, NULL);
+    }
+
+    /**
+     * Moves other's [first, last) containers before pos. pos MUST NOT be
+     * in [first, last)
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    void splice(iterator pos, intrusive_list& other, iterator first,
+                iterator last) {
+        (void) other;
+        if (first == last || pos == last) {return;}
+        dlinkedlist_splice_range(first.node(), last.node()->prev,
+                                 pos.node()->prev, 0, NULL, NULL);
+    }
+
+    /**
+     * Exchanges containers with other
+     *
+     * Time Complexity: O(1)
+     * Space Complexity: O(0)
+     */
+    void swap(intrusive_list& other) {
+        intrusive_list tmp;
+        tmp._take(other);
+        other._take(*this);
+        _take(tmp);
+    }
+
+    /**
+     * Reverses containers order
+     *
+     * Time Complexity: O(n)
+     * Space Complexity: O(0)
+     */
+    void reverse() { dlinkedlist_reverse(&_head); }
+
+    /**
+     * Sorts containers in place (see dlinkedlist_sort). Sort is stable.
+     *
+     * Time Complexity: O(n log n)
+     * Space Complexity: O(1)
+     *
+     * \param less Strict weak ordering: less(a, b) iff a goes before b
+     */
+    template <typename Compare>
+    void sort(Compare less) {
+        // Same algorithm as dlinkedlist_sort, with less inlined
+        #define __INTRUSIVE_LIST_BEFORE(x, y)                                  \
+            less(*traits::entry(x), *traits::entry(y))
+        __DLINKEDLIST_SORT(&_head, __INTRUSIVE_LIST_BEFORE);
+        #undef __INTRUSIVE_LIST_BEFORE
+    }
+
+    /**
+     * Sorts containers in place with T's operator<. Sort is stable.
+     */
+    void sort() { sort(_less()); }
+
+ private:
+#if __cplusplus < 201103L
+    intrusive_list(const intrusive_list&);
+    intrusive_list& operator=(const intrusive_list&);
+#endif
+
+    struct _less {
+        bool operator()(const T& a, const T& b) const { return a < b; }
+    };
+
+    /**
+     * Takes other's containers. List MUST be empty
+     */
+    void _take(intrusive_list& other) {
+        dlinkedlist_splice(&other._head, &_head, NULL, NULL);
+    }
+
+    struct dlinkedlist_node _head;
+};
+
+}  // namespace datastructure
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_INTRUSIVE_LIST_HPP_
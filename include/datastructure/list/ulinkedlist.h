@@ -0,0 +1,720 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Unrolled double linked list
+ *
+ *  Elements are copied by value into chunks of a few cache lines. Chunks are
+ *  linked in a double linked list, elements within a chunk are contiguous:
+ *  - link overhead is paid once per chunk instead of once per element
+ *  - sequential scans touch consecutive cache lines most of the time
+ *
+ *  Elements are identified by a cursor (chunk, index). Adding or removing an
+ *  element moves the elements following it in its chunk: pointers to
+ *  elements and cursors other than the one passed are invalidated.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_LIST_ULINKEDLIST_H_
+#define INCLUDE_DATASTRUCTURE_LIST_ULINKEDLIST_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "datastructure/macros.h"
+#include "datastructure/iterator/iterator.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  Chunk size in bytes (header included) when none is specified
+ */
+#define ULINKEDLIST_DEFAULT_CHUNK_SIZE (2 * CACHE_LINE_SIZE)
+
+/**
+ *  A chunk of elements
+ */
+struct ulinkedlist_chunk {
+    struct dlinkedlist_node _link;      /** Chunks list node */
+    size_t _count;                      /** Number of elements in the chunk */
+};
+
+/**
+ *  Size of a chunk header, rounded up so that the first element of the chunk
+ *  is suitably aligned for any type.
+ */
+#define __ULINKEDLIST_CHUNK_HEADER_SIZE                                        \
+    ALIGN_UP(sizeof(struct ulinkedlist_chunk), MAX_ALIGN)
+
+/**
+ *  An unrolled list
+ */
+struct ulinkedlist {
+    struct dlinkedlist_node _chunks;    /** Chunks */
+    size_t _elemsize;                   /** Element size */
+    size_t _capacity;                   /** Number of elements per chunk */
+    _UINT_LEAST_64_T _size;             /** Number of elements in the list */
+};
+
+/**
+ *  Position of an element within a list. Past the last element (and before
+ *  the first one) when _chunk is list's chunks head.
+ */
+struct ulinkedlist_cursor {
+    struct dlinkedlist_node* _chunk;    /** Chunk's node */
+    size_t _index;                      /** Element index within the chunk */
+};
+
+#define __ulinkedlist_chunk(node)                                              \
+    dlinkedlist_entry(node, struct ulinkedlist_chunk, _link)
+
+EXTERN_C_BEGIN
+
+/**
+ *  Initializes an empty list. No memory is allocated until the first element
+ *  is added.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param elemsize Element size. Must be > 0
+ *  \param chunksize Chunk size in bytes, header included. 0 uses
+ *                   ULINKEDLIST_DEFAULT_CHUNK_SIZE. Chunks hold at least 1
+ *                   element.
+ */
+static inline void ulinkedlist_init(struct ulinkedlist* list,
+                                    size_t elemsize,
+                                    size_t chunksize) {
+    ASSERT(list != NULL)
+    ASSERT(elemsize > 0)
+    if (chunksize == 0) {chunksize = ULINKEDLIST_DEFAULT_CHUNK_SIZE;}
+    dlinkedlist_init_head(&(list->_chunks), NULL);
+    list->_elemsize = elemsize;
+    list->_capacity = 1;
+    if (chunksize > __ULINKEDLIST_CHUNK_HEADER_SIZE + elemsize) {
+        list->_capacity = (chunksize - __ULINKEDLIST_CHUNK_HEADER_SIZE) / elemsize;
+    }
+    list->_size = 0;
+}
+
+/**
+ *  Frees list's memory. List is empty afterwards.
+ *
+ *  Time Complexity:    O(c) where c is the number of chunks
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ */
+static inline void ulinkedlist_free(struct ulinkedlist* list) {
+    ASSERT(list != NULL)
+    struct dlinkedlist_node* c = list->_chunks.next;
+    while (c != &(list->_chunks)) {
+        struct dlinkedlist_node* next = c->next;
+        free(__ulinkedlist_chunk(c));
+        c = next;
+    }
+    dlinkedlist_init_head(&(list->_chunks), NULL);
+    list->_size = 0;
+}
+
+/**
+ *  Gets list's size
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T ulinkedlist_size(const struct ulinkedlist* list) {
+    ASSERT(list != NULL)
+    return list->_size;
+}
+
+/**
+ *  Indicates if the list is empty
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \return 0 if not empty.
+ */
+static inline int ulinkedlist_empty(const struct ulinkedlist* list) {
+    ASSERT(list != NULL)
+    return list->_size == 0;
+}
+
+/**
+ *  Gets chunk's first element. Elements are contiguous.
+ *
+ *  \param chunk Chunk
+ *  \return Element
+ */
+static inline void* ulinkedlist_chunk_data(struct ulinkedlist_chunk* chunk) {
+    ASSERT(chunk != NULL)
+    return (char*) chunk + __ULINKEDLIST_CHUNK_HEADER_SIZE;
+}
+
+/**
+ *  Gets the number of elements in a chunk
+ *
+ *  \param chunk Chunk
+ *  \return count
+ */
+static inline size_t ulinkedlist_chunk_count(const struct ulinkedlist_chunk* chunk) {
+    ASSERT(chunk != NULL)
+    return chunk->_count;
+}
+
+static inline char* __ulinkedlist_element(const struct ulinkedlist* list,
+                                          struct ulinkedlist_chunk* chunk,
+                                          size_t index) {
+    return (char*) ulinkedlist_chunk_data(chunk) + index * list->_elemsize;
+}
+
+/**
+ *  Allocates an empty chunk
+ *
+ *  \return chunk. NULL iff no memory is available
+ */
+static inline struct ulinkedlist_chunk* __ulinkedlist_chunk_new(
+                                            const struct ulinkedlist* list) {
+    struct ulinkedlist_chunk* chunk = (struct ulinkedlist_chunk*) malloc(
+            __ULINKEDLIST_CHUNK_HEADER_SIZE + list->_capacity * list->_elemsize);
+    if (chunk != NULL) {
+        chunk->_count = 0;
+    }
+    return chunk;
+}
+
+/**
+ *  Makes room for an element at index in a non full chunk
+ *
+ *  \return Room for the element
+ */
+static inline void* __ulinkedlist_chunk_insert(struct ulinkedlist* list,
+                                               struct ulinkedlist_chunk* chunk,
+                                               size_t index,
+                                               const void* elem) {
+    ASSERT(chunk->_count < list->_capacity)
+    ASSERT(index <= chunk->_count)
+    char* slot = __ulinkedlist_element(list, chunk, index);
+    memmove(slot + list->_elemsize, slot, (chunk->_count - index) * list->_elemsize);
+    if (elem != NULL) {
+        memcpy(slot, elem, list->_elemsize);
+    }
+    chunk->_count++;
+    list->_size++;
+    return slot;
+}
+
+/**
+ *  Adds a new element before list's first element
+ *
+ *  Time Complexity:    O(b) where b is the number of elements per chunk
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ *  \param elem Element copied into the list. NULL permitted to leave the
+ *              element uninitialized
+ *  \return Element in the list. NULL iff no memory is available
+ */
+static inline void* ulinkedlist_add_head(struct ulinkedlist* list,
+                                         const void* elem) {
+    ASSERT(list != NULL)
+    struct dlinkedlist_node* c = list->_chunks.next;
+    if (c == &(list->_chunks) || __ulinkedlist_chunk(c)->_count == list->_capacity) {
+        struct ulinkedlist_chunk* chunk = __ulinkedlist_chunk_new(list);
+        if (chunk == NULL) {return NULL;}
+        dlinkedlist_add_head(&(list->_chunks), &(chunk->_link), NULL);
+        c = &(chunk->_link);
+    }
+    return __ulinkedlist_chunk_insert(list, __ulinkedlist_chunk(c), 0, elem);
+}
+
+/**
+ *  Adds a new element after list's last element
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ *  \param elem Element copied into the list. NULL permitted to leave the
+ *              element uninitialized
+ *  \return Element in the list. NULL iff no memory is available
+ */
+static inline void* ulinkedlist_add_tail(struct ulinkedlist* list,
+                                         const void* elem) {
+    ASSERT(list != NULL)
+    struct dlinkedlist_node* c = list->_chunks.prev;
+    if (c == &(list->_chunks) || __ulinkedlist_chunk(c)->_count == list->_capacity) {
+        struct ulinkedlist_chunk* chunk = __ulinkedlist_chunk_new(list);
+        if (chunk == NULL) {return NULL;}
+        dlinkedlist_add_tail(&(list->_chunks), &(chunk->_link), NULL);
+        c = &(chunk->_link);
+    }
+    struct ulinkedlist_chunk* chunk = __ulinkedlist_chunk(c);
+    return __ulinkedlist_chunk_insert(list, chunk, chunk->_count, elem);
+}
+
+/**
+ *  Moves a cursor onto list's first element (past the last element iff
+ *  the list is empty)
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param cursor Cursor
+ */
+static inline void ulinkedlist_cursor_first(struct ulinkedlist* list,
+                                            struct ulinkedlist_cursor* cursor) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    cursor->_chunk = list->_chunks.next;
+    cursor->_index = 0;
+}
+
+/**
+ *  Moves a cursor onto list's last element (past the last element iff
+ *  the list is empty)
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param cursor Cursor
+ */
+static inline void ulinkedlist_cursor_last(struct ulinkedlist* list,
+                                           struct ulinkedlist_cursor* cursor) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    cursor->_chunk = list->_chunks.prev;
+    cursor->_index = 0;
+    if (cursor->_chunk != &(list->_chunks)) {
+        cursor->_index = __ulinkedlist_chunk(cursor->_chunk)->_count - 1;
+    }
+}
+
+/**
+ *  Gets the element a cursor is on
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param cursor Cursor
+ *  \return Element. NULL iff cursor is past the last element
+ */
+static inline void* ulinkedlist_cursor_get(struct ulinkedlist* list,
+                                           const struct ulinkedlist_cursor* cursor) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    if (cursor->_chunk == &(list->_chunks)) {return NULL;}
+    return __ulinkedlist_element(list, __ulinkedlist_chunk(cursor->_chunk),
+                                 cursor->_index);
+}
+
+/**
+ *  Moves a cursor onto the next element. Past the last element, the cursor
+ *  moves onto the first element.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param cursor Cursor
+ *  \return Element. NULL iff cursor is past the last element
+ */
+static inline void* ulinkedlist_cursor_next(struct ulinkedlist* list,
+                                            struct ulinkedlist_cursor* cursor) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    if (cursor->_chunk == &(list->_chunks)) {
+        ulinkedlist_cursor_first(list, cursor);
+    } else if (++cursor->_index == __ulinkedlist_chunk(cursor->_chunk)->_count) {
+        cursor->_chunk = cursor->_chunk->next;
+        cursor->_index = 0;
+    }
+    return ulinkedlist_cursor_get(list, cursor);
+}
+
+/**
+ *  Moves a cursor onto the previous element. Before the first element, the
+ *  cursor is past the last element. Past the last element, the cursor moves
+ *  onto the last element.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List
+ *  \param cursor Cursor
+ *  \return Element. NULL iff cursor is past the last element
+ */
+static inline void* ulinkedlist_cursor_prev(struct ulinkedlist* list,
+                                            struct ulinkedlist_cursor* cursor) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    if (cursor->_chunk == &(list->_chunks)) {
+        ulinkedlist_cursor_last(list, cursor);
+    } else if (cursor->_index == 0) {
+        cursor->_chunk = cursor->_chunk->prev;
+        if (cursor->_chunk != &(list->_chunks)) {
+            cursor->_index = __ulinkedlist_chunk(cursor->_chunk)->_count - 1;
+        }
+    } else {
+        cursor->_index--;
+    }
+    return ulinkedlist_cursor_get(list, cursor);
+}
+
+/**
+ *  Adds a new element before the element a cursor is on. Full chunks are
+ *  split in two halves.
+ *
+ *  Time Complexity:    O(b) where b is the number of elements per chunk
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ *  \param cursor Cursor. Past the last element appends to the list. Moved
+ *                onto the new element.
+ *  \param elem Element copied into the list. NULL permitted to leave the
+ *              element uninitialized
+ *  \return Element in the list. NULL iff no memory is available
+ */
+static inline void* ulinkedlist_add_before(struct ulinkedlist* list,
+                                           struct ulinkedlist_cursor* cursor,
+                                           const void* elem) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    if (cursor->_chunk == &(list->_chunks)) {
+        void* slot = ulinkedlist_add_tail(list, elem);
+        if (slot != NULL) {ulinkedlist_cursor_last(list, cursor);}
+        return slot;
+    }
+    struct ulinkedlist_chunk* chunk = __ulinkedlist_chunk(cursor->_chunk);
+    if (chunk->_count == list->_capacity) {
+        struct ulinkedlist_chunk* upper = __ulinkedlist_chunk_new(list);
+        if (upper == NULL) {return NULL;}
+        size_t half = chunk->_count / 2;
+        upper->_count = chunk->_count - half;
+        memcpy(ulinkedlist_chunk_data(upper), __ulinkedlist_element(list, chunk, half),
+               upper->_count * list->_elemsize);
+        chunk->_count = half;
+        dlinkedlist_add_after(&(chunk->_link), &(upper->_link), NULL);
+        if (cursor->_index > half) {
+            cursor->_chunk = &(upper->_link);
+            cursor->_index -= half;
+            chunk = upper;
+        }
+    }
+    return __ulinkedlist_chunk_insert(list, chunk, cursor->_index, elem);
+}
+
+/**
+ *  Removes the element a cursor is on. A chunk is merged with a neighbour
+ *  chunk when both fit in a single chunk.
+ *
+ *  Time Complexity:    O(b) where b is the number of elements per chunk
+ *  Space Complexity:   O(1)
+ *
+ *  \param list List
+ *  \param cursor Cursor. Must NOT be past the last element. Moved onto
+ *                the element following the removed one.
+ */
+static inline void ulinkedlist_remove(struct ulinkedlist* list,
+                                      struct ulinkedlist_cursor* cursor) {
+    ASSERT(list != NULL)
+    ASSERT(cursor != NULL)
+    ASSERT(cursor->_chunk != &(list->_chunks))
+    struct ulinkedlist_chunk* chunk = __ulinkedlist_chunk(cursor->_chunk);
+    ASSERT(cursor->_index < chunk->_count)
+    char* slot = __ulinkedlist_element(list, chunk, cursor->_index);
+    chunk->_count--;
+    list->_size--;
+    memmove(slot, slot + list->_elemsize,
+            (chunk->_count - cursor->_index) * list->_elemsize);
+
+    if (chunk->_count == 0) {
+        cursor->_chunk = chunk->_link.next;
+        cursor->_index = 0;
+        dlinkedlist_remove(&(chunk->_link), NULL);
+        free(chunk);
+        return;
+    }
+    struct dlinkedlist_node* p = chunk->_link.prev;
+    struct dlinkedlist_node* n = chunk->_link.next;
+    if (p != &(list->_chunks)
+            && __ulinkedlist_chunk(p)->_count + chunk->_count <= list->_capacity) {
+        // Merge chunk into the previous one
+        struct ulinkedlist_chunk* prev = __ulinkedlist_chunk(p);
+        memcpy(__ulinkedlist_element(list, prev, prev->_count),
+               ulinkedlist_chunk_data(chunk), chunk->_count * list->_elemsize);
+        cursor->_chunk = p;
+        cursor->_index += prev->_count;
+        prev->_count += chunk->_count;
+        dlinkedlist_remove(&(chunk->_link), NULL);
+        free(chunk);
+        chunk = prev;
+    } else if (n != &(list->_chunks)
+            && chunk->_count + __ulinkedlist_chunk(n)->_count <= list->_capacity) {
+        // Merge the next chunk into chunk
+        struct ulinkedlist_chunk* next = __ulinkedlist_chunk(n);
+        memcpy(__ulinkedlist_element(list, chunk, chunk->_count),
+               ulinkedlist_chunk_data(next), next->_count * list->_elemsize);
+        chunk->_count += next->_count;
+        dlinkedlist_remove(n, NULL);
+        free(next);
+    }
+    if (cursor->_index == chunk->_count) {
+        cursor->_chunk = chunk->_link.next;
+        cursor->_index = 0;
+    }
+}
+
+/**
+ *  Joins two lists together. list's elements are inserted before head's
+ *  first element. list is empty afterwards. Both lists MUST have been
+ *  initialized with the same element and chunk sizes.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param list List to add
+ *  \param head List to prepend to
+ */
+static inline void ulinkedlist_splice(struct ulinkedlist* list,
+                                      struct ulinkedlist* head) {
+    ASSERT(list != NULL)
+    ASSERT(head != NULL)
+    ASSERT(list->_elemsize == head->_elemsize)
+    ASSERT(list->_capacity == head->_capacity)
+    if (list->_size == 0) {return;}
+    dlinkedlist_splice(&(list->_chunks), &(head->_chunks), NULL, NULL);
+    head->_size += list->_size;
+    list->_size = 0;
+}
+
+/**
+ *  Iterates over list's chunks
+ *
+ *  \param list List
+ *  \param chunk struct ulinkedlist_chunk* to use as a loop cursor
+ */
+#define ulinkedlist_for_each_chunk(list, chunk)                                \
+    for (chunk = __ulinkedlist_chunk((list)->_chunks.next);                    \
+         &((chunk)->_link) != &((list)->_chunks);                              \
+         chunk = __ulinkedlist_chunk((chunk)->_link.next))
+
+/**
+ *  Iterates over list's elements
+ *
+ *  \param list List
+ *  \param cursor struct ulinkedlist_cursor to use as a loop cursor
+ *  \param elem Pointer to use as the current element
+ */
+#define ulinkedlist_for_each(list, cursor, elem)                               \
+    for (ulinkedlist_cursor_first(list, &(cursor));                            \
+         ((elem) = ulinkedlist_cursor_get(list, &(cursor))) != NULL;           \
+         ulinkedlist_cursor_next(list, &(cursor)))
+
+/**
+ *  Iterates over list's elements backward
+ *
+ *  \param list List
+ *  \param cursor struct ulinkedlist_cursor to use as a loop cursor
+ *  \param elem Pointer to use as the current element
+ */
+#define ulinkedlist_for_each_prev(list, cursor, elem)                          \
+    for (ulinkedlist_cursor_last(list, &(cursor));                             \
+         ((elem) = ulinkedlist_cursor_get(list, &(cursor))) != NULL;           \
+         ulinkedlist_cursor_prev(list, &(cursor)))
+
+/**
+ *  Iterator on list's elements. Starts before the first element.
+ */
+struct iterator_ulinkedlist {
+    struct iterator _base;
+    struct ulinkedlist* _list;
+    struct ulinkedlist_cursor _cursor;
+};
+
+static inline void* __ulinkedlist_iterator_next (struct iterator* iterator) {
+    if (iterator == NULL) {
+        return NULL;
+    }
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    return ulinkedlist_cursor_next(iterator2->_list, &(iterator2->_cursor));
+}
+
+static inline void* __ulinkedlist_iterator_prev (struct iterator* iterator) {
+    if (iterator == NULL) {
+        return NULL;
+    }
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    return ulinkedlist_cursor_prev(iterator2->_list, &(iterator2->_cursor));
+}
+
+static inline void* __ulinkedlist_iterator_current (struct iterator* iterator) {
+    if (iterator == NULL) {
+        return NULL;
+    }
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    return ulinkedlist_cursor_get(iterator2->_list, &(iterator2->_cursor));
+}
+
+static inline void* __ulinkedlist_iterator_begin (struct iterator* iterator) {
+    if (iterator == NULL) {
+        return NULL;
+    }
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    struct ulinkedlist_cursor cursor;
+    ulinkedlist_cursor_first(iterator2->_list, &cursor);
+    return ulinkedlist_cursor_get(iterator2->_list, &cursor);
+}
+
+static inline void* __ulinkedlist_iterator_end (struct iterator* iterator) {
+    if (iterator == NULL) {
+        return NULL;
+    }
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    struct ulinkedlist_cursor cursor;
+    ulinkedlist_cursor_last(iterator2->_list, &cursor);
+    return ulinkedlist_cursor_get(iterator2->_list, &cursor);
+}
+
+/**
+ *  Rebinds an iterator onto a list and moves it back before the first
+ *  element.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param iterator The iterator
+ *  \param list The list. NULL permitted to rewind the iterator onto the list
+ *              it is already bound to.
+ */
+static inline void ulinkedlist_iterator_reset(struct iterator* iterator,
+                                              struct ulinkedlist* list) {
+    ASSERT(iterator != NULL)
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    if (list == NULL) {
+        list = iterator2->_list;
+    }
+    ASSERT(list != NULL)
+    iterator2->_list = list;
+    iterator2->_cursor._chunk = &(list->_chunks);
+    iterator2->_cursor._index = 0;
+}
+
+/**
+ *  Initializes an iterator on a list within caller provided storage
+ *  (eg: on the stack). No memory is allocated.
+ *
+ *  ALL iterator methods returns a pointer to the element, NULL past the last
+ *  element.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param iterator Storage for the iterator
+ *  \param list The list
+ *  \return The iterator, to be released with ulinkedlist_iterator_deinit
+ */
+static inline struct iterator* ulinkedlist_iterator_init(
+                                    struct iterator_ulinkedlist* iterator,
+                                    struct ulinkedlist* list) {
+    ASSERT(iterator != NULL)
+    ASSERT(list != NULL)
+    iterator->_base._mode = ITERATOR_ACCESS_MODE_FORWARD | ITERATOR_ACCESS_MODE_BACKWARD;
+    iterator->_base.begin = __ulinkedlist_iterator_begin;
+    iterator->_base.end = __ulinkedlist_iterator_end;
+    iterator->_base.next = __ulinkedlist_iterator_next;
+    iterator->_base.prev = __ulinkedlist_iterator_prev;
+    iterator->_base.current = __ulinkedlist_iterator_current;
+    iterator->_base._first = NULL;
+    iterator->_base._last = NULL;
+    ulinkedlist_iterator_reset(&(iterator->_base), list);
+    return &(iterator->_base);
+}
+
+/**
+ *  Deinitializes an iterator initialized with ulinkedlist_iterator_init.
+ *  Caller provided storage is NOT freed.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param iterator The iterator
+ */
+static inline void ulinkedlist_iterator_deinit(struct iterator* iterator) {
+    if (iterator == NULL) {
+        return;
+    }
+    struct iterator_ulinkedlist* iterator2 = (struct iterator_ulinkedlist*) iterator;
+    iterator2->_list = NULL;
+    iterator2->_cursor._chunk = NULL;
+}
+
+/**
+ *  Get an iterator on a list
+ *
+ *  ALL iterator methods returns a pointer to the element, NULL past the last
+ *  element.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param list The list
+ *  \return The iterator, to be released with ulinkedlist_iterator_free.
+ *          NULL iff no memory is available
+ */
+static inline struct iterator* ulinkedlist_iterator_get(struct ulinkedlist* list) {
+    ASSERT(list != NULL)
+    struct iterator_ulinkedlist* iterator = (struct iterator_ulinkedlist*)
+                                    malloc(sizeof(struct iterator_ulinkedlist));
+    if (iterator == NULL) {
+        return NULL;
+    }
+    return ulinkedlist_iterator_init(iterator, list);
+}
+
+/**
+ *  Free iterator
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param iterator The iterator
+ */
+static inline void ulinkedlist_iterator_free(struct iterator* iterator) {
+    ulinkedlist_iterator_deinit(iterator);
+    free(iterator);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_LIST_ULINKEDLIST_H_
@@ -29,4 +29,65 @@
     #define ASSERT(x)
 #endif
 
+/*
+ * Operations statistics (see datastructure/list/dlinkedlist_stats.h).
+ * Compiled out unless DATASTRUCTURE_STATS is defined.
+ */
+#ifdef DATASTRUCTURE_STATS
+    #define STATS(x)    x;
+#else
+    #define STATS(x)
+#endif
+
+/*
+ * Most restrictive alignment of standard types
+ */
+union __max_align {
+    long double _ld;
+    long long _ll;
+    void* _p;
+    void (*_fp)(void);
+};
+#define MAX_ALIGN   sizeof(union __max_align)
+
+/*
+ * Rounds size up to a multiple of alignment
+ */
+#define ALIGN_UP(size, alignment)                                              \
+    ((((size) + (alignment) - 1) / (alignment)) * (alignment))
+
+/*
+ * Assumed size of a processor's cache line
+ */
+#ifndef CACHE_LINE_SIZE
+    #define CACHE_LINE_SIZE 64
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    /*
+     * Hints the processor to fetch the cache line holding x for reading.
+     * Never faults.
+     */
+    #define PREFETCH(x) __builtin_prefetch((x))
+#else
+    #define PREFETCH(x) ((void)(x))
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    /*
+     * Atomic operations on naturally aligned pointers/integers.
+     * Defined iff supported by the compiler.
+     */
+    #define ATOMIC_LOAD_RELAXED(p)      __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define ATOMIC_LOAD_ACQUIRE(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE_RELAXED(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+    #define ATOMIC_STORE_RELEASE(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define ATOMIC_EXCHANGE(p, v)       __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+    #define ATOMIC_FETCH_ADD(p, v)      __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+    #define ATOMIC_COMPARE_EXCHANGE(p, expected, v)                            \
+        __atomic_compare_exchange_n((p), (expected), (v), 0,                   \
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+    #define ATOMIC_THREAD_FENCE()       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
 #endif  // INCLUDE_DATASTRUCTURE_MACROS_H_
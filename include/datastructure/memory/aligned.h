@@ -0,0 +1,67 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Cache line aligned memory allocation.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_MEMORY_ALIGNED_H_
+#define INCLUDE_DATASTRUCTURE_MEMORY_ALIGNED_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "datastructure/macros.h"
+
+EXTERN_C_BEGIN
+
+/*
+ * Allocates size bytes starting on a cache line boundary, so that
+ * CACHE_LINE_SIZE padded items of an array never share a cache line.
+ * Strict C99 has no aligned allocator: malloc's block is over allocated and
+ * its address is kept right before the aligned one. Returns NULL iff no
+ * memory is available. Freed with __cache_aligned_free.
+ */
+static inline void* __cache_aligned_malloc(size_t size) {
+    char* block = (char*) malloc(size + sizeof(void*) + CACHE_LINE_SIZE - 1);
+    if (block == NULL) {return NULL;}
+    char* aligned = block + sizeof(void*);
+    aligned += (CACHE_LINE_SIZE - (uintptr_t) aligned % CACHE_LINE_SIZE)
+                    % CACHE_LINE_SIZE;
+    ((void**) aligned)[-1] = block;
+    return aligned;
+}
+
+/*
+ * Frees memory allocated by __cache_aligned_malloc. NULL permitted.
+ */
+static inline void __cache_aligned_free(void* p) {
+    if (p != NULL) {free(((void**) p)[-1]);}
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_MEMORY_ALIGNED_H_
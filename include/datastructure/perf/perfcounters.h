@@ -0,0 +1,311 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Hardware performance counters (Linux perf_event_open)
+ *
+ *  Counts, for the calling thread and in user space only, events telling
+ *  whether a workload (eg: a list traversal) is bound by cycles spent on
+ *  cache/TLB misses or on branch mispredictions:
+ *  cycles, instructions, L1 data cache read misses, last level cache misses,
+ *  data TLB read misses and branch misses.
+ *
+ *  Counters are opened as one group, led by the first available counter,
+ *  so that the kernel schedules them together and their ratios (eg: misses
+ *  per instruction) are measured over the same time. Those the processor,
+ *  the kernel (see /proc/sys/kernel/perf_event_paranoid) or a virtual
+ *  machine do not support, or that do not fit in the group, are reported
+ *  as PERFCOUNTERS_UNAVAILABLE while the others keep counting. When perf_event_open is not available at all (non Linux
+ *  platforms, strict ISO C builds without _GNU_SOURCE/_DEFAULT_SOURCE,
+ *  PERFCOUNTERS_DISABLE defined), every counter is unavailable and every
+ *  function is a no-op.
+ *
+ *  Usage:
+ *      struct perfcounters pc;
+ *      perfcounters_open(&pc);
+ *      perfcounters_start(&pc);
+ *      dlinkedlist_for_each(head, node) {...}
+ *      perfcounters_stop(&pc);
+ *      perfcounters_value(&pc, PERFCOUNTERS_L1D_MISSES) / size;
+ *      perfcounters_close(&pc);
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_PERF_PERFCOUNTERS_H_
+#define INCLUDE_DATASTRUCTURE_PERF_PERFCOUNTERS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "datastructure/macros.h"
+
+#if defined(__linux__) && !defined(PERFCOUNTERS_DISABLE)                      \
+    && (defined(_GNU_SOURCE) || defined(_DEFAULT_SOURCE)                       \
+        || defined(_BSD_SOURCE) || !defined(__STRICT_ANSI__))
+    #define __PERFCOUNTERS_PERF_EVENT 1
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <linux/perf_event.h>
+#endif
+
+/** Counters */
+#define PERFCOUNTERS_CYCLES             0
+#define PERFCOUNTERS_INSTRUCTIONS       1
+#define PERFCOUNTERS_L1D_MISSES         2
+#define PERFCOUNTERS_LLC_MISSES         3
+#define PERFCOUNTERS_DTLB_MISSES        4
+#define PERFCOUNTERS_BRANCH_MISSES      5
+/** Number of counters */
+#define PERFCOUNTERS_COUNT              6
+
+/** Value of a counter that could not be opened */
+#define PERFCOUNTERS_UNAVAILABLE        UINT64_MAX
+
+/**
+ *  A set of counters
+ */
+struct perfcounters {
+    int _fds[PERFCOUNTERS_COUNT];           /** -1 iff unavailable */
+    int _leader;                            /** Group leader. -1 iff none */
+    uint64_t _values[PERFCOUNTERS_COUNT];   /** Counted so far */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Counter name
+ *
+ *  \param counter PERFCOUNTERS_*
+ *  \return Name
+ */
+static inline const char* perfcounters_name(int counter) {
+    static const char* const names[PERFCOUNTERS_COUNT] = {
+        "cycles", "instructions", "L1d-misses", "LLC-misses", "dTLB-misses",
+        "branch-misses"
+    };
+    ASSERT(counter >= 0 && counter < PERFCOUNTERS_COUNT)
+    return names[counter];
+}
+
+#ifdef __PERFCOUNTERS_PERF_EVENT
+/**
+ *  Opens one counter for the calling thread. A leader is opened disabled;
+ *  group members follow their leader.
+ *
+ *  \param counter PERFCOUNTERS_*
+ *  \param leader Group leader's file descriptor. -1 to open a leader
+ *  \return File descriptor. -1 iff unavailable
+ */
+static inline int __perfcounters_open(int counter, int leader) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = leader < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP
+                       | PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.type = PERF_TYPE_HW_CACHE;
+    switch (counter) {
+    case PERFCOUNTERS_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PERFCOUNTERS_INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERFCOUNTERS_L1D_MISSES:
+        attr.config = PERF_COUNT_HW_CACHE_L1D
+                      | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case PERFCOUNTERS_LLC_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case PERFCOUNTERS_DTLB_MISSES:
+        attr.config = PERF_COUNT_HW_CACHE_DTLB
+                      | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    default:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    }
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+#endif
+
+/**
+ *  Opens every counter supported by the platform. Counters are stopped and
+ *  zeroed.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(1)
+ *
+ *  \param pc Counters
+ *  \return Number of available counters. 0 iff none
+ */
+static inline int perfcounters_open(struct perfcounters* pc) {
+    ASSERT(pc != NULL)
+    int available = 0;
+    pc->_leader = -1;
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+#ifdef __PERFCOUNTERS_PERF_EVENT
+        pc->_fds[i] = __perfcounters_open(i, pc->_leader);
+        if (pc->_leader < 0) {pc->_leader = pc->_fds[i];}
+#else
+        pc->_fds[i] = -1;
+#endif
+        pc->_values[i] = 0;
+        if (pc->_fds[i] >= 0) {available++;}
+    }
+    return available;
+}
+
+/**
+ *  Closes every counter
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pc Counters
+ */
+static inline void perfcounters_close(struct perfcounters* pc) {
+    ASSERT(pc != NULL)
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+#ifdef __PERFCOUNTERS_PERF_EVENT
+        if (pc->_fds[i] >= 0) {close(pc->_fds[i]);}
+#endif
+        pc->_fds[i] = -1;
+    }
+    pc->_leader = -1;
+}
+
+/**
+ *  Indicates if a counter is available
+ *
+ *  \param pc Counters
+ *  \param counter PERFCOUNTERS_*
+ *  \return 0 iff unavailable
+ */
+static inline int perfcounters_available(const struct perfcounters* pc,
+                                         int counter) {
+    ASSERT(pc != NULL)
+    ASSERT(counter >= 0 && counter < PERFCOUNTERS_COUNT)
+    return pc->_fds[counter] >= 0;
+}
+
+/**
+ *  Starts counting. Events are added to the values counted so far.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pc Counters
+ */
+static inline void perfcounters_start(struct perfcounters* pc) {
+    ASSERT(pc != NULL)
+#ifdef __PERFCOUNTERS_PERF_EVENT
+    if (pc->_leader < 0) {return;}
+    ioctl(pc->_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(pc->_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    (void) pc;
+#endif
+}
+
+/**
+ *  Stops counting. Values are scaled up when the kernel had to multiplex
+ *  counters.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pc Counters
+ */
+static inline void perfcounters_stop(struct perfcounters* pc) {
+    ASSERT(pc != NULL)
+#ifdef __PERFCOUNTERS_PERF_EVENT
+    // counters count, time enabled, time running, values in opening order
+    uint64_t data[3 + PERFCOUNTERS_COUNT];
+    if (pc->_leader < 0) {return;}
+    ioctl(pc->_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    ssize_t length = read(pc->_leader, data, sizeof(data));
+    if (length < (ssize_t) (3 * sizeof(uint64_t))) {return;}
+    uint64_t v = 0;
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        if (pc->_fds[i] < 0) {continue;}
+        if (v >= data[0] || length < (ssize_t) ((4 + v) * sizeof(uint64_t))) {
+            break;
+        }
+        uint64_t value = data[3 + v];
+        v++;
+        if (data[2] != 0 && data[2] < data[1]) {
+            value = (uint64_t) ((double) value * data[1] / data[2]);
+        }
+        pc->_values[i] += value;
+    }
+#else
+    (void) pc;
+#endif
+}
+
+/**
+ *  Zeroes every counted value
+ *
+ *  \param pc Counters. MUST be stopped
+ */
+static inline void perfcounters_reset(struct perfcounters* pc) {
+    ASSERT(pc != NULL)
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        pc->_values[i] = 0;
+    }
+}
+
+/**
+ *  Counted value
+ *
+ *  \param pc Counters
+ *  \param counter PERFCOUNTERS_*
+ *  \return Events counted between every start/stop pair since open/reset.
+ *          PERFCOUNTERS_UNAVAILABLE iff the counter is unavailable
+ */
+static inline uint64_t perfcounters_value(const struct perfcounters* pc,
+                                          int counter) {
+    ASSERT(pc != NULL)
+    ASSERT(counter >= 0 && counter < PERFCOUNTERS_COUNT)
+    if (pc->_fds[counter] < 0) {return PERFCOUNTERS_UNAVAILABLE;}
+    return pc->_values[counter];
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_PERF_PERFCOUNTERS_H_
@@ -0,0 +1,178 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+/**
+ *  Lock free intrusive multi producers / single consumer FIFO queue
+ *  (D. Vyukov's algorithm)
+ *
+ *  Items embed a struct dlinkedlist_node. While queued, only the node's next
+ *  link is used. Pushing is wait free: one atomic exchange and one store.
+ *  Popping is lock free and MUST be done by one thread at a time.
+ *
+ *  A push is only visible to the consumer once completed: while a producer
+ *  is preempted in the middle of a push, the consumer may see the queue as
+ *  empty (or stop before the items pushed after it).
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_QUEUE_MPSCQUEUE_H_
+#define INCLUDE_DATASTRUCTURE_QUEUE_MPSCQUEUE_H_
+
+#include <stddef.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+#ifndef ATOMIC_EXCHANGE
+    #error "mpscqueue requires atomic operations (see macros.h)"
+#endif
+
+/**
+ *  A queue. Producers and consumer fields live on distinct cache lines.
+ */
+struct mpscqueue {
+    struct dlinkedlist_node* _head;     /** Last pushed node (producers) */
+    char _pad[CACHE_LINE_SIZE - sizeof(struct dlinkedlist_node*)];
+    struct dlinkedlist_node* _tail;     /** Next node to pop (consumer) */
+    struct dlinkedlist_node _stub;      /** Keeps the queue never empty */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ *  Initializes an empty queue
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param queue Queue
+ */
+static inline void mpscqueue_init(struct mpscqueue* queue) {
+    ASSERT(queue != NULL)
+    queue->_stub.next = NULL;
+    queue->_stub.prev = NULL;
+    queue->_head = &(queue->_stub);
+    queue->_tail = &(queue->_stub);
+}
+
+/**
+ *  Pushes a node. Safe to call from any number of threads concurrently.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param queue Queue
+ *  \param node Node to push. MUST NOT be in a list or in a queue
+ */
+static inline void mpscqueue_push(struct mpscqueue* queue,
+                                  struct dlinkedlist_node* node) {
+    ASSERT(queue != NULL)
+    ASSERT(node != NULL)
+    ATOMIC_STORE_RELAXED(&(node->next), (struct dlinkedlist_node*) NULL);
+    struct dlinkedlist_node* prev = ATOMIC_EXCHANGE(&(queue->_head), node);
+    ATOMIC_STORE_RELEASE(&(prev->next), node);
+}
+
+/**
+ *  Pops the oldest node. Consumer only.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param queue Queue
+ *  \return Node. NULL iff the queue is empty or the oldest node's push is
+ *          not completed yet
+ */
+static inline struct dlinkedlist_node* mpscqueue_pop(struct mpscqueue* queue) {
+    ASSERT(queue != NULL)
+    struct dlinkedlist_node* tail = queue->_tail;
+    struct dlinkedlist_node* next = ATOMIC_LOAD_ACQUIRE(&(tail->next));
+    if (tail == &(queue->_stub)) {
+        if (next == NULL) {return NULL;}
+        queue->_tail = next;
+        tail = next;
+        next = ATOMIC_LOAD_ACQUIRE(&(tail->next));
+    }
+    if (next != NULL) {
+        queue->_tail = next;
+        return tail;
+    }
+    if (tail != ATOMIC_LOAD_ACQUIRE(&(queue->_head))) {
+        // A push is in progress after tail
+        return NULL;
+    }
+    // tail is the last node: put the stub behind it to release tail
+    mpscqueue_push(queue, &(queue->_stub));
+    next = ATOMIC_LOAD_ACQUIRE(&(tail->next));
+    if (next != NULL) {
+        queue->_tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+/**
+ *  Indicates if the queue is empty. Consumer only.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param queue Queue
+ *  \return 0 if not empty. Pushes in progress are not accounted for.
+ */
+static inline int mpscqueue_empty(struct mpscqueue* queue) {
+    ASSERT(queue != NULL)
+    return queue->_tail == &(queue->_stub)
+        && ATOMIC_LOAD_ACQUIRE(&(queue->_stub.next)) == NULL;
+}
+
+/**
+ *  Pops every node whose push is completed and adds them, oldest first,
+ *  after head's tail. Consumer only.
+ *
+ *  Time Complexity:    O(k), k being the number of popped nodes
+ *  Space Complexity:   O(0)
+ *
+ *  \param queue Queue
+ *  \param head List head popped nodes are added to
+ *  \param headSize head parameter's size - updated only iff headSize is NOT NULL. NULL permitted.
+ *  \return Number of popped nodes
+ */
+static inline size_t mpscqueue_take_all(struct mpscqueue* queue,
+                                        struct dlinkedlist_node* head,
+                                        _INT_LEAST_32_T* headSize) {
+    ASSERT(queue != NULL)
+    ASSERT(head != NULL)
+    size_t count = 0;
+    struct dlinkedlist_node* node;
+    while ((node = mpscqueue_pop(queue)) != NULL) {
+        dlinkedlist_add_tail(head, node, headSize);
+        count++;
+    }
+    return count;
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_QUEUE_MPSCQUEUE_H_
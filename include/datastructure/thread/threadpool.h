@@ -0,0 +1,400 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Work stealing thread pool (POSIX threads)
+ *
+ *  Tasks are intrusive: callers embed a struct threadpool_task in their own
+ *  job struct and get it back with dlinkedlist_entry-like pointer
+ *  arithmetic (see threadpool_task_entry). Submitting never allocates.
+ *
+ *  Each worker owns a deque of tasks. Submitted tasks are dealt round robin
+ *  to workers' deques. A worker runs its own deque's newest task first and,
+ *  once it is empty, steals the oldest task of the other deques. Threads
+ *  waiting for a group of tasks (see threadpool_wait) steal and run tasks
+ *  too, so the calling thread is never idle while its work is pending.
+ *
+ *  Idle workers sleep until a task is submitted. Waiting threads with no
+ *  task to steal sleep until one is submitted or their group completes.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_THREAD_THREADPOOL_H_
+#define INCLUDE_DATASTRUCTURE_THREAD_THREADPOOL_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "datastructure/macros.h"
+#include "datastructure/memory/aligned.h"
+#include "datastructure/list/dlinkedlist.h"
+
+#ifndef ATOMIC_FETCH_ADD
+    #error "threadpool requires atomic operations (see macros.h)"
+#endif
+
+struct threadpool;
+struct threadpool_task;
+
+/**
+ *  Runs a task
+ *
+ *  \param task Task
+ */
+typedef void (*threadpool_run)(struct threadpool_task* task);
+
+/**
+ *  Group of tasks waited for together
+ */
+struct threadpool_group {
+    size_t _pending;                    /** Submitted tasks not completed */
+};
+
+/**
+ *  A task. MUST stay valid until its group is waited for.
+ */
+struct threadpool_task {
+    struct dlinkedlist_node _node;      /** Links the task in a deque */
+    threadpool_run _run;                /** Task's body */
+    struct threadpool_group* _group;    /** Task's group */
+    struct threadpool* _pool;           /** Pool the task is submitted to */
+};
+
+/**
+ *  A worker and its deque
+ */
+struct __threadpool_worker {
+    pthread_mutex_t _lock;
+    struct dlinkedlist_node _tasks;
+    struct threadpool* _pool;
+    pthread_t _thread;
+};
+
+/**
+ *  A worker padded to a multiple of the cache line size. Workers are
+ *  allocated on a cache line boundary, so that distinct workers' deques do
+ *  not share a cache line.
+ */
+union __threadpool_slot {
+    struct __threadpool_worker _worker;
+    char _pad[ALIGN_UP(sizeof(struct __threadpool_worker), CACHE_LINE_SIZE)];
+};
+
+/**
+ *  A thread pool
+ */
+struct threadpool {
+    union __threadpool_slot* _workers;      /** Workers */
+    unsigned int _count;                    /** Number of workers */
+    size_t _queued;                         /** Tasks in deques */
+    size_t _next;                           /** Next deque to submit to */
+    int _stop;                              /** Non 0 iff stopping */
+    size_t _waiting;                        /** Threads blocked on _done */
+    pthread_mutex_t _lock;                  /** Guards _stop, _waiting,
+                                                idle workers and waiters */
+    pthread_cond_t _wake;                   /** Wakes idle workers up */
+    pthread_cond_t _done;                   /** Wakes threads waiting for a
+                                                group up */
+};
+
+/**
+ *  Gets a pointer to the struct a task is embedded in
+ *
+ *  \param task struct threadpool_task pointer
+ *  \param type Type of the struct the task is embedded in
+ *  \param member Name of the task within the struct
+ */
+#define threadpool_task_entry(task, type, member)                              \
+    ((type*) ((char*) (task) - offsetof(type, member)))
+
+EXTERN_C_BEGIN
+
+/**
+ *  Takes a task: the newest of worker first's deque, else the oldest of
+ *  the other deques.
+ *
+ *  \param pool Pool
+ *  \param first Index of the deque taken from first
+ *  \return NULL iff every deque is empty
+ */
+static inline struct threadpool_task* __threadpool_take(
+                                                    struct threadpool* pool,
+                                                    unsigned int first) {
+    for (unsigned int i = 0; i < pool->_count; i++) {
+        struct __threadpool_worker* worker =
+                    &(pool->_workers[(first + i) % pool->_count]._worker);
+        struct dlinkedlist_node* node = NULL;
+        pthread_mutex_lock(&(worker->_lock));
+        if (!dlinkedlist_empty(&(worker->_tasks))) {
+            node = (i == 0) ? worker->_tasks.prev : worker->_tasks.next;
+            dlinkedlist_remove(node, NULL);
+        }
+        pthread_mutex_unlock(&(worker->_lock));
+        if (node != NULL) {
+            ATOMIC_FETCH_ADD(&(pool->_queued), (size_t) -1);
+            return dlinkedlist_entry(node, struct threadpool_task, _node);
+        }
+    }
+    return NULL;
+}
+
+/**
+ *  Runs a task then marks it completed. The task is not accessed anymore
+ *  once completed. Completing a group's last task wakes up threads waiting
+ *  for a group.
+ */
+static inline void __threadpool_execute(struct threadpool_task* task) {
+    struct threadpool_group* group = task->_group;
+    struct threadpool* pool = task->_pool;
+    task->_run(task);
+    if (ATOMIC_FETCH_ADD(&(group->_pending), (size_t) -1) == 1) {
+        // Waiters check _pending with _lock held: no wake up can be missed
+        pthread_mutex_lock(&(pool->_lock));
+        if (pool->_waiting != 0) {pthread_cond_broadcast(&(pool->_done));}
+        pthread_mutex_unlock(&(pool->_lock));
+    }
+}
+
+static inline void* __threadpool_work(void* arg) {
+    struct __threadpool_worker* worker = (struct __threadpool_worker*) arg;
+    struct threadpool* pool = worker->_pool;
+    unsigned int self = (unsigned int) (
+                (union __threadpool_slot*) worker - pool->_workers);
+    for (;;) {
+        struct threadpool_task* task = __threadpool_take(pool, self);
+        if (task != NULL) {
+            __threadpool_execute(task);
+            continue;
+        }
+        int stop;
+        pthread_mutex_lock(&(pool->_lock));
+        while (ATOMIC_LOAD_ACQUIRE(&(pool->_queued)) == 0 && !pool->_stop) {
+            pthread_cond_wait(&(pool->_wake), &(pool->_lock));
+        }
+        stop = pool->_stop && ATOMIC_LOAD_ACQUIRE(&(pool->_queued)) == 0;
+        pthread_mutex_unlock(&(pool->_lock));
+        if (stop) {break;}
+    }
+    return NULL;
+}
+
+/**
+ *  Stops and joins the first count workers, then frees pool's memory.
+ */
+static inline void __threadpool_destroy(struct threadpool* pool,
+                                        unsigned int count) {
+    pthread_mutex_lock(&(pool->_lock));
+    pool->_stop = 1;
+    pthread_cond_broadcast(&(pool->_wake));
+    pthread_mutex_unlock(&(pool->_lock));
+    for (unsigned int i = 0; i < count; i++) {
+        pthread_join(pool->_workers[i]._worker._thread, NULL);
+    }
+    for (unsigned int i = 0; i < pool->_count; i++) {
+        pthread_mutex_destroy(&(pool->_workers[i]._worker._lock));
+    }
+    pthread_cond_destroy(&(pool->_done));
+    pthread_cond_destroy(&(pool->_wake));
+    pthread_mutex_destroy(&(pool->_lock));
+    __cache_aligned_free(pool->_workers);
+    pool->_workers = NULL;
+    pool->_count = 0;
+}
+
+/**
+ *  Initializes a pool and starts its workers
+ *
+ *  Time Complexity:    O(t)
+ *  Space Complexity:   O(t)
+ *
+ *  \param pool Pool
+ *  \param threads Number of workers. 0 starts one worker per online
+ *                 processor but one, the thread waiting for tasks being
+ *                 expected to run tasks too
+ *  \return 0 iff no memory is available or a worker cannot be started
+ */
+static inline int threadpool_init(struct threadpool* pool,
+                                  unsigned int threads) {
+    ASSERT(pool != NULL)
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 1 ? (unsigned int) (online - 1) : 0;
+    }
+    pool->_workers = NULL;
+    pool->_count = threads;
+    pool->_queued = 0;
+    pool->_next = 0;
+    pool->_stop = 0;
+    pool->_waiting = 0;
+    if (threads > 0) {
+        pool->_workers = (union __threadpool_slot*) __cache_aligned_malloc(
+                                threads * sizeof(union __threadpool_slot));
+        if (pool->_workers == NULL) {
+            pool->_count = 0;
+            return 0;
+        }
+    }
+    pthread_mutex_init(&(pool->_lock), NULL);
+    pthread_cond_init(&(pool->_wake), NULL);
+    pthread_cond_init(&(pool->_done), NULL);
+    for (unsigned int i = 0; i < threads; i++) {
+        struct __threadpool_worker* worker = &(pool->_workers[i]._worker);
+        pthread_mutex_init(&(worker->_lock), NULL);
+        dlinkedlist_init_head(&(worker->_tasks), NULL);
+        worker->_pool = pool;
+    }
+    for (unsigned int i = 0; i < threads; i++) {
+        struct __threadpool_worker* worker = &(pool->_workers[i]._worker);
+        if (pthread_create(&(worker->_thread), NULL, __threadpool_work,
+                           worker) != 0) {
+            __threadpool_destroy(pool, i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ *  Runs the remaining tasks, stops the workers and frees pool's memory.
+ *  No task may be submitted anymore.
+ *
+ *  Time Complexity:    O(t)
+ *  Space Complexity:   O(1)
+ *
+ *  \param pool Pool
+ */
+static inline void threadpool_free(struct threadpool* pool) {
+    ASSERT(pool != NULL)
+    __threadpool_destroy(pool, pool->_count);
+}
+
+/**
+ *  Gets the number of workers
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool
+ *  \return Number of workers
+ */
+static inline unsigned int threadpool_thread_count(
+                                                const struct threadpool* pool) {
+    ASSERT(pool != NULL)
+    return pool->_count;
+}
+
+/**
+ *  Initializes an empty group
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param group Group
+ */
+static inline void threadpool_group_init(struct threadpool_group* group) {
+    ASSERT(group != NULL)
+    group->_pending = 0;
+}
+
+/**
+ *  Submits a task. Safe to call from any thread, tasks included. Pools
+ *  without workers run the task before returning.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool
+ *  \param group Group the task belongs to
+ *  \param task Task. MUST NOT be pending
+ *  \param run Task's body. Called once, from any thread
+ */
+static inline void threadpool_submit(struct threadpool* pool,
+                                     struct threadpool_group* group,
+                                     struct threadpool_task* task,
+                                     threadpool_run run) {
+    ASSERT(pool != NULL)
+    ASSERT(group != NULL)
+    ASSERT(task != NULL)
+    ASSERT(run != NULL)
+    task->_run = run;
+    task->_group = group;
+    task->_pool = pool;
+    ATOMIC_FETCH_ADD(&(group->_pending), (size_t) 1);
+    if (pool->_count == 0) {
+        __threadpool_execute(task);
+        return;
+    }
+    struct __threadpool_worker* worker = &(pool->_workers[
+        ATOMIC_FETCH_ADD(&(pool->_next), (size_t) 1) % pool->_count]._worker);
+    pthread_mutex_lock(&(worker->_lock));
+    dlinkedlist_add_tail(&(worker->_tasks), &(task->_node), NULL);
+    pthread_mutex_unlock(&(worker->_lock));
+    ATOMIC_FETCH_ADD(&(pool->_queued), (size_t) 1);
+
+    // Idle workers and waiters check _queued with _lock held: no wake up
+    // can be missed
+    pthread_mutex_lock(&(pool->_lock));
+    pthread_cond_signal(&(pool->_wake));
+    if (pool->_waiting != 0) {pthread_cond_broadcast(&(pool->_done));}
+    pthread_mutex_unlock(&(pool->_lock));
+}
+
+/**
+ *  Waits for every task submitted to a group, running pending tasks (of
+ *  any group) in the meantime. Blocks while no task is pending.
+ *
+ *  Time Complexity:    O(k), k being the number of tasks run
+ *  Space Complexity:   O(0)
+ *
+ *  \param pool Pool
+ *  \param group Group
+ */
+static inline void threadpool_wait(struct threadpool* pool,
+                                   struct threadpool_group* group) {
+    ASSERT(pool != NULL)
+    ASSERT(group != NULL)
+    unsigned int first = 0;
+    while (ATOMIC_LOAD_ACQUIRE(&(group->_pending)) != 0) {
+        struct threadpool_task* task = __threadpool_take(pool, first++);
+        if (task != NULL) {
+            __threadpool_execute(task);
+            continue;
+        }
+        pthread_mutex_lock(&(pool->_lock));
+        pool->_waiting++;
+        while (ATOMIC_LOAD_ACQUIRE(&(group->_pending)) != 0
+               && ATOMIC_LOAD_ACQUIRE(&(pool->_queued)) == 0) {
+            pthread_cond_wait(&(pool->_done), &(pool->_lock));
+        }
+        pool->_waiting--;
+        pthread_mutex_unlock(&(pool->_lock));
+    }
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_THREAD_THREADPOOL_H_
@@ -0,0 +1,417 @@
+/**************************************************************************
+ * MIT LICENSE
+ *
+ * Copyright (c) 2014, David Andreoletti <http://davidandreoletti.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **************************************************************************/
+
+
+/**
+ *  Hierarchical timing wheel (G. Varghese and T. Lauck)
+ *
+ *  Timers embed a struct timerwheel_timer and expire at an absolute tick.
+ *  The wheel has TIMERWHEEL_LEVELS levels of 2^TIMERWHEEL_LEVEL_BITS
+ *  slots, each slot being a struct dlinkedlist_node list head. Level l
+ *  slots span 2^(l * TIMERWHEEL_LEVEL_BITS) ticks: a timer is put in the
+ *  lowest level whose range covers its remaining delay. Whenever level l-1
+ *  wraps around, the next level l slot is cascaded: its timers are put
+ *  back into lower levels. Level 0 slots due are spliced as a whole into
+ *  the caller's list of expired timers.
+ *
+ *  - arming a timer is O(1)
+ *  - cancelling a timer is O(1): a dlinkedlist_remove
+ *  - advancing is O(expired timers + cascaded timers + levels per visited
+ *    tick). Each level keeps a bitmap of its non empty slots, so that only
+ *    ticks where a slot is due are visited. Each timer is cascaded at most
+ *    TIMERWHEEL_LEVELS - 1 times.
+ *
+ *  Delays beyond the wheel's range are capped while the timer waits on the
+ *  last level, then re-evaluated as it cascades.
+ *
+ *  All functions/macros not starting with __ or _ are Public API.
+ */
+
+#ifndef INCLUDE_DATASTRUCTURE_TIMER_TIMERWHEEL_H_
+#define INCLUDE_DATASTRUCTURE_TIMER_TIMERWHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "datastructure/macros.h"
+#include "datastructure/list/dlinkedlist.h"
+
+/**
+ *  log2 of the number of slots per level. At most 6 (64 slots)
+ */
+#ifndef TIMERWHEEL_LEVEL_BITS
+    #define TIMERWHEEL_LEVEL_BITS 6
+#endif
+
+#if TIMERWHEEL_LEVEL_BITS > 6
+    #error "TIMERWHEEL_LEVEL_BITS must be at most 6"
+#endif
+
+/**
+ *  Number of levels. Wheel covers delays up to
+ *  2^(TIMERWHEEL_LEVELS * TIMERWHEEL_LEVEL_BITS) - 1 ticks.
+ */
+#ifndef TIMERWHEEL_LEVELS
+    #define TIMERWHEEL_LEVELS 6
+#endif
+
+#define __TIMERWHEEL_SLOTS (1 << TIMERWHEEL_LEVEL_BITS)
+#define __TIMERWHEEL_MASK ((uint64_t) __TIMERWHEEL_SLOTS - 1)
+#define __TIMERWHEEL_RANGE                                                     \
+    ((uint64_t) 1 << (TIMERWHEEL_LEVELS * TIMERWHEEL_LEVEL_BITS))
+
+/**
+ *  A timer
+ */
+struct timerwheel_timer {
+    struct dlinkedlist_node _link;      /** Slot or expired list link */
+    uint64_t _expires;                  /** Expiry tick */
+};
+
+/**
+ *  A timing wheel
+ */
+struct timerwheel {
+    struct dlinkedlist_node _slots[TIMERWHEEL_LEVELS][__TIMERWHEEL_SLOTS];
+    uint64_t _used[TIMERWHEEL_LEVELS];  /** Non empty slots bitmaps */
+    uint64_t _now;                      /** Next tick to process */
+    _UINT_LEAST_64_T _size;             /** Number of pending timers */
+};
+
+EXTERN_C_BEGIN
+
+/**
+ * Get the struc for this entry
+ *
+ * Time Complexity: O(1)
+ * Space Complexity: O(0)
+ *
+ * \param ptr Pointer to the struct timerwheel_timer
+ * \param containertype Type of the struct ptr is embedded in
+ * \param member Name of the struct timerwheel_timer within containertype
+ */
+#define timerwheel_entry(ptr, containertype, member)                           \
+    __dlinkedlist_container_of(ptr, containertype, member)
+
+/**
+ *  Initializes an empty wheel
+ *
+ *  Time Complexity:    O(levels * slots)
+ *  Space Complexity:   O(0)
+ *
+ *  \param wheel Wheel
+ *  \param now First tick to process: timers expiring at now or before
+ *             expire on the first timerwheel_advance
+ */
+static inline void timerwheel_init(struct timerwheel* wheel, uint64_t now) {
+    ASSERT(wheel != NULL)
+    for (int l = 0; l < TIMERWHEEL_LEVELS; l++) {
+        for (int s = 0; s < __TIMERWHEEL_SLOTS; s++) {
+            dlinkedlist_init_head(&(wheel->_slots[l][s]), NULL);
+        }
+        wheel->_used[l] = 0;
+    }
+    wheel->_now = now;
+    wheel->_size = 0;
+}
+
+/**
+ *  Gets the number of pending timers
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param wheel Wheel
+ *  \return size
+ */
+static inline _UINT_LEAST_64_T timerwheel_size(const struct timerwheel* wheel) {
+    ASSERT(wheel != NULL)
+    return wheel->_size;
+}
+
+/**
+ *  Initializes a timer as not pending
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param timer Timer
+ */
+static inline void timerwheel_timer_init(struct timerwheel_timer* timer) {
+    ASSERT(timer != NULL)
+    dlinkedlist_init_head(&(timer->_link), NULL);
+    timer->_expires = 0;
+}
+
+/**
+ *  Indicates if a timer is armed and not expired yet
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param timer Timer initialized by timerwheel_timer_init
+ *  \return 0 if not pending
+ */
+static inline int timerwheel_timer_pending(const struct timerwheel_timer* timer) {
+    ASSERT(timer != NULL)
+    return !dlinkedlist_empty(&(timer->_link));
+}
+
+/**
+ *  Gets a timer's expiry tick
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param timer Timer
+ *  \return Expiry tick
+ */
+static inline uint64_t timerwheel_timer_expires(
+                                        const struct timerwheel_timer* timer) {
+    ASSERT(timer != NULL)
+    return timer->_expires;
+}
+
+/**
+ *  Puts a timer in the slot covering its remaining delay
+ */
+static inline void __timerwheel_place(struct timerwheel* wheel,
+                                      struct timerwheel_timer* timer) {
+    uint64_t expires = timer->_expires;
+    if (expires < wheel->_now) {expires = wheel->_now;}
+    uint64_t delta = expires - wheel->_now;
+    if (delta >= __TIMERWHEEL_RANGE) {
+        delta = __TIMERWHEEL_RANGE - 1;
+        expires = wheel->_now + delta;
+    }
+    int level = 0;
+    while (delta >> ((level + 1) * TIMERWHEEL_LEVEL_BITS) != 0) {level++;}
+    size_t slot = (size_t) ((expires >> (level * TIMERWHEEL_LEVEL_BITS))
+                            & __TIMERWHEEL_MASK);
+    dlinkedlist_add_tail(&(wheel->_slots[level][slot]), &(timer->_link), NULL);
+    wheel->_used[level] |= (uint64_t) 1 << slot;
+}
+
+/**
+ *  Takes a pending timer out of its slot, clearing the slot's bit if the
+ *  slot is left empty
+ */
+static inline void __timerwheel_unlink(struct timerwheel* wheel,
+                                       struct timerwheel_timer* timer) {
+    struct dlinkedlist_node* next = timer->_link.next;
+    dlinkedlist_remove(&(timer->_link), NULL);
+    if (next == timer->_link.prev) {
+        // next is the slot's head
+        size_t index = (size_t) (next - &(wheel->_slots[0][0]));
+        wheel->_used[index >> TIMERWHEEL_LEVEL_BITS] &=
+                            ~((uint64_t) 1 << (index & __TIMERWHEEL_MASK));
+    }
+}
+
+/**
+ *  Arms a timer, cancelling it first if pending.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param wheel Wheel
+ *  \param timer Timer initialized by timerwheel_timer_init. MUST NOT be in
+ *               an expired list
+ *  \param expires Expiry tick. Ticks already processed expire on the next
+ *                 timerwheel_advance
+ */
+static inline void timerwheel_arm(struct timerwheel* wheel,
+                                  struct timerwheel_timer* timer,
+                                  uint64_t expires) {
+    ASSERT(wheel != NULL)
+    ASSERT(timer != NULL)
+    if (timerwheel_timer_pending(timer)) {
+        __timerwheel_unlink(wheel, timer);
+    } else {
+        wheel->_size++;
+    }
+    timer->_expires = expires;
+    __timerwheel_place(wheel, timer);
+}
+
+/**
+ *  Cancels a timer
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param wheel Wheel
+ *  \param timer Timer initialized by timerwheel_timer_init. MUST NOT be in
+ *               an expired list
+ *  \return 0 iff the timer was not pending
+ */
+static inline int timerwheel_cancel(struct timerwheel* wheel,
+                                    struct timerwheel_timer* timer) {
+    ASSERT(wheel != NULL)
+    ASSERT(timer != NULL)
+    if (!timerwheel_timer_pending(timer)) {return 0;}
+    __timerwheel_unlink(wheel, timer);
+    dlinkedlist_init_head(&(timer->_link), NULL);
+    wheel->_size--;
+    return 1;
+}
+
+/**
+ *  Puts every timer of a level slot back into lower levels
+ */
+static inline void __timerwheel_cascade(struct timerwheel* wheel,
+                                        int level,
+                                        size_t slot) {
+    struct dlinkedlist_node pending;
+    dlinkedlist_init_head(&pending, NULL);
+    dlinkedlist_splice(&(wheel->_slots[level][slot]), &pending, NULL, NULL);
+    wheel->_used[level] &= ~((uint64_t) 1 << slot);
+    while (!dlinkedlist_empty(&pending)) {
+        struct dlinkedlist_node* node = pending.next;
+        dlinkedlist_remove(node, NULL);
+        __timerwheel_place(wheel, dlinkedlist_entry(node,
+                                                    struct timerwheel_timer,
+                                                    _link));
+    }
+}
+
+/**
+ *  Counts trailing zero bits of a non zero value
+ */
+static inline int __timerwheel_ctz(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ *  Gets the first tick, from the next tick to process on, where a non empty
+ *  slot is due: expired for level 0, cascaded for upper levels.
+ *
+ *  \return UINT64_MAX iff the wheel is empty
+ */
+static inline uint64_t __timerwheel_next_tick(const struct timerwheel* wheel) {
+    uint64_t next = UINT64_MAX;
+    for (int l = 0; l < TIMERWHEEL_LEVELS; l++) {
+        uint64_t used = wheel->_used[l];
+        if (used == 0) {continue;}
+        // Level l slots are due every unit ticks, in index order
+        int shift = l * TIMERWHEEL_LEVEL_BITS;
+        uint64_t unit = (uint64_t) 1 << shift;
+        uint64_t first = (wheel->_now + unit - 1) & ~(unit - 1);
+        int start = (int) ((first >> shift) & __TIMERWHEEL_MASK);
+        if (start != 0) {
+            used = (used >> start)
+                 | (used << (__TIMERWHEEL_SLOTS - start));
+            used &= ~(uint64_t) 0 >> (64 - __TIMERWHEEL_SLOTS);
+        }
+        uint64_t tick = first + ((uint64_t) __timerwheel_ctz(used) << shift);
+        if (tick < next) {next = tick;}
+    }
+    return next;
+}
+
+/**
+ *  Processes every tick up to now (included): timers expiring at or
+ *  before now are moved, in expiry order, after expired's tail. Take them
+ *  out of expired with timerwheel_take.
+ *
+ *  Time Complexity:    O(l * t + k + c), l being the number of levels, t the
+ *                      number of ticks where a slot is due, k the number
+ *                      of expired timers, c the number of cascaded timers
+ *  Space Complexity:   O(1)
+ *
+ *  \param wheel Wheel
+ *  \param now Last tick to process
+ *  \param expired Head of the list receiving expired timers
+ *  \return Number of expired timers
+ */
+static inline size_t timerwheel_advance(struct timerwheel* wheel,
+                                        uint64_t now,
+                                        struct dlinkedlist_node* expired) {
+    ASSERT(wheel != NULL)
+    ASSERT(expired != NULL)
+    size_t count = 0;
+    while (wheel->_now <= now) {
+        // Skip ticks where no slot is due
+        uint64_t next = __timerwheel_next_tick(wheel);
+        if (next > now) {
+            wheel->_now = now + 1;
+            break;
+        }
+        wheel->_now = next;
+        size_t slot = (size_t) (wheel->_now & __TIMERWHEEL_MASK);
+        for (int l = 1; slot == 0 && l < TIMERWHEEL_LEVELS; l++) {
+            // Level l - 1 wrapped around
+            slot = (size_t) ((wheel->_now >> (l * TIMERWHEEL_LEVEL_BITS))
+                             & __TIMERWHEEL_MASK);
+            __timerwheel_cascade(wheel, l, slot);
+        }
+        struct dlinkedlist_node* due =
+                        &(wheel->_slots[0][wheel->_now & __TIMERWHEEL_MASK]);
+        if (!dlinkedlist_empty(due)) {
+            size_t k = 0;
+            struct dlinkedlist_node* node;
+            dlinkedlist_for_each(due, node) {k++;}
+            dlinkedlist_splice_range(due->next, due->prev, expired->prev, k,
+                                     NULL, NULL);
+            wheel->_used[0] &= ~((uint64_t) 1 << (wheel->_now
+                                                  & __TIMERWHEEL_MASK));
+            wheel->_size -= k;
+            count += k;
+        }
+        wheel->_now++;
+    }
+    return count;
+}
+
+/**
+ *  Takes the first timer out of an expired list. The timer is left not
+ *  pending, ready to be armed again.
+ *
+ *  Time Complexity:    O(1)
+ *  Space Complexity:   O(0)
+ *
+ *  \param expired Head of the list of expired timers
+ *  \return Timer. NULL iff expired is empty
+ */
+static inline struct timerwheel_timer* timerwheel_take(
+                                        struct dlinkedlist_node* expired) {
+    ASSERT(expired != NULL)
+    if (dlinkedlist_empty(expired)) {return NULL;}
+    struct dlinkedlist_node* node = expired->next;
+    dlinkedlist_remove_from(expired, node, NULL);
+    dlinkedlist_init_head(node, NULL);
+    return dlinkedlist_entry(node, struct timerwheel_timer, _link);
+}
+
+EXTERN_C_END
+
+#endif  // INCLUDE_DATASTRUCTURE_TIMER_TIMERWHEEL_H_
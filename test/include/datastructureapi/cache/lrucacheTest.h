@@ -0,0 +1,13 @@
+//
+//  lrucacheTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_LRUCACHETEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_LRUCACHETEST_H_
+
+int run_unit_tests_lrucache();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_LRUCACHETEST_H_
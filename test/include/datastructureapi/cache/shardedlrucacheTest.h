@@ -0,0 +1,13 @@
+//
+//  shardedlrucacheTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_SHARDEDLRUCACHETEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_SHARDEDLRUCACHETEST_H_
+
+int run_unit_tests_shardedlrucache();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_SHARDEDLRUCACHETEST_H_
@@ -0,0 +1,13 @@
+//
+//  twoqcacheTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_TWOQCACHETEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_TWOQCACHETEST_H_
+
+int run_unit_tests_twoqcache();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_CACHE_TWOQCACHETEST_H_
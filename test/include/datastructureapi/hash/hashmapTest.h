@@ -0,0 +1,13 @@
+//
+//  hashmapTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_HASH_HASHMAPTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_HASH_HASHMAPTEST_H_
+
+int run_unit_tests_hashmap();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_HASH_HASHMAPTEST_H_
@@ -0,0 +1,13 @@
+//
+//  dlinkedlistParallelTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTPARALLELTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTPARALLELTEST_H_
+
+int run_unit_tests_dlinkedlist_parallel();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTPARALLELTEST_H_
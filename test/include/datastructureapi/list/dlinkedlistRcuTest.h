@@ -0,0 +1,13 @@
+//
+//  dlinkedlistRcuTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTRCUTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTRCUTEST_H_
+
+int run_unit_tests_dlinkedlist_rcu();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTRCUTEST_H_
@@ -0,0 +1,13 @@
+//
+//  dlinkedlistSortTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTSORTTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTSORTTEST_H_
+
+int run_unit_tests_dlinkedlist_sort();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_LIST_DLINKEDLISTSORTTEST_H_
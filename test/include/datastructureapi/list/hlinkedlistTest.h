@@ -0,0 +1,13 @@
+//
+//  hlinkedlistTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_LIST_HLINKEDLISTTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_LIST_HLINKEDLISTTEST_H_
+
+int run_unit_tests_hlinkedlist();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_LIST_HLINKEDLISTTEST_H_
@@ -0,0 +1,13 @@
+//
+//  intrusiveListTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_LIST_INTRUSIVELISTTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_LIST_INTRUSIVELISTTEST_H_
+
+int run_unit_tests_intrusive_list();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_LIST_INTRUSIVELISTTEST_H_
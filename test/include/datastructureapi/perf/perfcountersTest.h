@@ -0,0 +1,13 @@
+//
+//  perfcountersTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_PERF_PERFCOUNTERSTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_PERF_PERFCOUNTERSTEST_H_
+
+int run_unit_tests_perfcounters();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_PERF_PERFCOUNTERSTEST_H_
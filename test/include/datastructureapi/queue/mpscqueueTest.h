@@ -0,0 +1,13 @@
+//
+//  mpscqueueTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_QUEUE_MPSCQUEUETEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_QUEUE_MPSCQUEUETEST_H_
+
+int run_unit_tests_mpscqueue();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_QUEUE_MPSCQUEUETEST_H_
@@ -0,0 +1,13 @@
+//
+//  threadpoolTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_THREAD_THREADPOOLTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_THREAD_THREADPOOLTEST_H_
+
+int run_unit_tests_threadpool();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_THREAD_THREADPOOLTEST_H_
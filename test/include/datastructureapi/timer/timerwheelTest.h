@@ -0,0 +1,13 @@
+//
+//  timerwheelTest.h
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#ifndef TEST_INCLUDE_DATASTRUCTUREAPI_TIMER_TIMERWHEELTEST_H_
+#define TEST_INCLUDE_DATASTRUCTUREAPI_TIMER_TIMERWHEELTEST_H_
+
+int run_unit_tests_timerwheel();
+
+#endif  // TEST_INCLUDE_DATASTRUCTUREAPI_TIMER_TIMERWHEELTEST_H_
@@ -7,7 +7,45 @@
 
 #include "TestRunner.h"
 #include "datastructureapi/list/dlinkedlistTest.h"
+#include "datastructureapi/list/dlinkedlistPoolTest.h"
+#include "datastructureapi/list/dlinkedlistCountedTest.h"
+#include "datastructureapi/list/dlinkedlistSortTest.h"
+#include "datastructureapi/list/dlinkedlistRcuTest.h"
+#include "datastructureapi/list/ulinkedlistTest.h"
+#include "datastructureapi/list/ilinkedlistTest.h"
+#include "datastructureapi/list/hlinkedlistTest.h"
+#include "datastructureapi/queue/mpscqueueTest.h"
+#include "datastructureapi/hash/hashtableTest.h"
+#include "datastructureapi/hash/hashmapTest.h"
+#include "datastructureapi/cache/lrucacheTest.h"
+#include "datastructureapi/cache/shardedlrucacheTest.h"
+#include "datastructureapi/cache/twoqcacheTest.h"
+#include "datastructureapi/timer/timerwheelTest.h"
+#include "datastructureapi/perf/perfcountersTest.h"
+#include "datastructureapi/list/dlinkedlistStatsTest.h"
+#include "datastructureapi/thread/threadpoolTest.h"
+#include "datastructureapi/list/dlinkedlistParallelTest.h"
+#include "datastructureapi/list/intrusiveListTest.h"
 
 int run_unit_tests_all() {
-    return run_unit_tests_dlinkedlist();
+    return run_unit_tests_dlinkedlist()
+        && run_unit_tests_dlinkedlist_pool()
+        && run_unit_tests_dlinkedlist_counted()
+        && run_unit_tests_dlinkedlist_sort()
+        && run_unit_tests_dlinkedlist_rcu()
+        && run_unit_tests_ulinkedlist()
+        && run_unit_tests_ilinkedlist()
+        && run_unit_tests_hlinkedlist()
+        && run_unit_tests_mpscqueue()
+        && run_unit_tests_hashtable()
+        && run_unit_tests_hashmap()
+        && run_unit_tests_lrucache()
+        && run_unit_tests_shardedlrucache()
+        && run_unit_tests_twoqcache()
+        && run_unit_tests_timerwheel()
+        && run_unit_tests_perfcounters()
+        && run_unit_tests_dlinkedlist_stats()
+        && run_unit_tests_threadpool()
+        && run_unit_tests_dlinkedlist_parallel()
+        && run_unit_tests_intrusive_list();
 }
@@ -0,0 +1,195 @@
+//
+//  lrucacheTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/cache/lrucacheTest.h"
+#include "datastructure/cache/lrucache.h"
+#include "datastructure/hash/hashtable.h"
+#include <stdlib.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT 8
+#define CAPACITY 4
+
+struct item {
+    int key;
+    int evicted;
+    struct lrucache_node cache;
+};
+
+struct fixture {
+    struct item items[ITEM_COUNT];
+    struct lrucache c;
+    int evictions[ITEM_COUNT * 2];  /** Evicted keys, in eviction order */
+    int evictionCount;
+};
+
+static int item_match(const struct lrucache_node* node, const void* key) {
+    return lrucache_entry(node, struct item, cache)->key == *(const int*) key;
+}
+
+static void item_evict(struct lrucache_node* node, void* ctx) {
+    struct fixture* f = (struct fixture*) ctx;
+    struct item* item = lrucache_entry(node, struct item, cache);
+    item->evicted++;
+    f->evictions[f->evictionCount++] = item->key;
+}
+
+static uint64_t key_hash(int key) {
+    return hashtable_hash_u64((uint64_t) key);
+}
+
+static void item_put(struct fixture* f, int i, _UINT_LEAST_64_T charge) {
+    lrucache_put(&(f->c), &(f->items[i].cache), key_hash(f->items[i].key),
+                 &(f->items[i].key), charge);
+}
+
+static struct item* item_get(struct fixture* f, int key) {
+    struct lrucache_node* node = lrucache_get(&(f->c), key_hash(key), &key);
+    return node == NULL ? NULL : lrucache_entry(node, struct item, cache);
+}
+
+// Checks cache holds keys[0..count-1], most recently used first
+static void require_keys(struct lrucache* c, const int* keys, int count) {
+    struct dlinkedlist_node* node;
+    int i = 0;
+    REQUIRE_EQUAL(lrucache_size(c), (_UINT_LEAST_64_T) count);
+    lrucache_for_each(c, node) {
+        REQUIRE_EQUAL(lrucache_entry(lrucache_node(node), struct item,
+                                     cache)->key, keys[i]);
+        i++;
+    }
+    REQUIRE_EQUAL(i, count);
+}
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].key = i;
+        f->items[i].evicted = 0;
+    }
+    f->evictionCount = 0;
+    REQUIRE(lrucache_init(&(f->c), CAPACITY, 0, item_match, item_evict, f));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    lrucache_free(&(f->c));
+}
+
+void lrucache_get_put0(struct fixture* f) {
+    REQUIRE(item_get(f, 0) == NULL);
+    for (int i = 0; i < CAPACITY; i++) {item_put(f, i, 1);}
+    int k0[] = {3, 2, 1, 0};
+    require_keys(&(f->c), k0, CAPACITY);
+
+    // Hits move entries to the front, peeking does not
+    REQUIRE(item_get(f, 1) == &(f->items[1]));
+    REQUIRE(item_get(f, 3) == &(f->items[3]));
+    REQUIRE(lrucache_peek(&(f->c), key_hash(0), &(f->items[0].key))
+            == &(f->items[0].cache));
+    int k1[] = {3, 1, 2, 0};
+    require_keys(&(f->c), k1, CAPACITY);
+    REQUIRE_EQUAL(lrucache_stats(&(f->c))->hits, 2);
+    REQUIRE_EQUAL(lrucache_stats(&(f->c))->misses, 1);
+
+    // Least recently used entries are evicted
+    item_put(f, 4, 1);
+    item_put(f, 5, 1);
+    int k2[] = {5, 4, 3, 1};
+    require_keys(&(f->c), k2, CAPACITY);
+    REQUIRE_EQUAL(f->evictionCount, 2);
+    REQUIRE_EQUAL(f->evictions[0], 0);
+    REQUIRE_EQUAL(f->evictions[1], 2);
+    REQUIRE_EQUAL(lrucache_stats(&(f->c))->evictions, 2);
+    REQUIRE(item_get(f, 0) == NULL);
+    REQUIRE_EQUAL(lrucache_stats(&(f->c))->misses, 2);
+
+    lrucache_stats_reset(&(f->c));
+    REQUIRE_EQUAL(lrucache_stats(&(f->c))->hits, 0);
+
+    // Removing does not evict
+    lrucache_remove(&(f->c), &(f->items[4].cache));
+    int k3[] = {5, 3, 1};
+    require_keys(&(f->c), k3, 3);
+    REQUIRE_EQUAL(f->items[4].evicted, 0);
+}
+
+void lrucache_replace0(struct fixture* f) {
+    item_put(f, 0, 1);
+    item_put(f, 1, 1);
+    // Another container with key 0 replaces the first one
+    f->items[7].key = 0;
+    item_put(f, 7, 1);
+    REQUIRE_EQUAL(f->items[0].evicted, 1);
+    REQUIRE_EQUAL(lrucache_size(&(f->c)), 2);
+    REQUIRE(item_get(f, 0) == &(f->items[7]));
+}
+
+void lrucache_budget0(struct fixture* f) {
+    lrucache_resize(&(f->c), 0, 10);
+    item_put(f, 0, 4);
+    item_put(f, 1, 4);
+    REQUIRE_EQUAL(lrucache_charge(&(f->c)), 8);
+    item_put(f, 2, 4);
+    int k0[] = {2, 1};
+    require_keys(&(f->c), k0, 2);
+    REQUIRE_EQUAL(lrucache_charge(&(f->c)), 8);
+
+    // An entry larger than the budget stays alone
+    item_put(f, 3, 20);
+    int k1[] = {3};
+    require_keys(&(f->c), k1, 1);
+    REQUIRE_EQUAL(lrucache_charge(&(f->c)), 20);
+
+    // Shrinking evicts right away
+    lrucache_resize(&(f->c), 0, 0);
+    item_put(f, 4, 1);
+    item_put(f, 5, 1);
+    lrucache_resize(&(f->c), 1, 0);
+    int k2[] = {5};
+    require_keys(&(f->c), k2, 1);
+
+    // Remaining entries are evicted when the cache is freed
+    lrucache_free(&(f->c));
+    REQUIRE_EQUAL(f->items[5].evicted, 1);
+    REQUIRE(lrucache_init(&(f->c), CAPACITY, 0, item_match, item_evict, f));
+}
+
+void lrucache_promotion0(struct fixture* f) {
+    lrucache_set_promotion(&(f->c), 2);
+    for (int i = 0; i < CAPACITY; i++) {item_put(f, i, 1);}
+
+    // Entries among the 2 most recently moved ones stay in place
+    REQUIRE(item_get(f, 2) == &(f->items[2]));
+    REQUIRE(item_get(f, 1) == &(f->items[1]));
+    int k0[] = {3, 2, 1, 0};
+    require_keys(&(f->c), k0, CAPACITY);
+
+    // Older ones are moved
+    REQUIRE(item_get(f, 0) == &(f->items[0]));
+    int k1[] = {0, 3, 2, 1};
+    require_keys(&(f->c), k1, CAPACITY);
+    REQUIRE(item_get(f, 3) == &(f->items[3]));
+    REQUIRE(item_get(f, 1) == &(f->items[1]));
+    int k2[] = {1, 0, 3, 2};
+    require_keys(&(f->c), k2, CAPACITY);
+    REQUIRE_EQUAL(lrucache_stats(&(f->c))->hits, 5);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_lrucache() {
+    struct fixture f;
+    TEST_CASE(lrucache_get_put0, &f)
+    TEST_CASE(lrucache_replace0, &f)
+    TEST_CASE(lrucache_budget0, &f)
+    TEST_CASE(lrucache_promotion0, &f)
+    return 1;
+}
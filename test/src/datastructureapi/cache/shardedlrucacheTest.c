@@ -0,0 +1,192 @@
+//
+//  shardedlrucacheTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/cache/shardedlrucacheTest.h"
+#include "datastructure/cache/shardedlrucache.h"
+#include "datastructure/hash/hashtable.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define SHARD_COUNT     8
+#define THREAD_COUNT    4
+#define ITEM_COUNT      2000    /** Per thread */
+#define CAPACITY        (SHARD_COUNT * 64)
+
+struct item {
+    int key;
+    int evicted;
+    int visited;
+    struct lrucache_node cache;
+};
+
+struct fixture {
+    struct item items[THREAD_COUNT][ITEM_COUNT];
+    struct shardedlrucache c;
+};
+
+struct worker {
+    struct fixture* f;
+    int thread;
+};
+
+static int item_match(const struct lrucache_node* node, const void* key) {
+    return lrucache_entry(node, struct item, cache)->key == *(const int*) key;
+}
+
+static void item_evict(struct lrucache_node* node, void* ctx) {
+    (void) ctx;
+    lrucache_entry(node, struct item, cache)->evicted++;
+}
+
+static void item_visit(struct lrucache_node* node, void* arg) {
+    (void) arg;
+    lrucache_entry(node, struct item, cache)->visited++;
+}
+
+static uint64_t key_hash(int key) {
+    return hashtable_hash_u64((uint64_t) key);
+}
+
+static void fixture_setup(struct fixture* f) {
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            f->items[t][i].key = t * ITEM_COUNT + i;
+            f->items[t][i].evicted = 0;
+            f->items[t][i].visited = 0;
+        }
+    }
+    REQUIRE(shardedlrucache_init(&(f->c), SHARD_COUNT - 1, CAPACITY, 0,
+                                 item_match, item_evict, NULL));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    shardedlrucache_free(&(f->c));
+}
+
+void shardedlrucache_init0(struct fixture* f) {
+    REQUIRE_EQUAL(shardedlrucache_shard_count(&(f->c)), SHARD_COUNT);
+    REQUIRE_EQUAL(shardedlrucache_size(&(f->c)), 0);
+    for (int i = 0; i < SHARD_COUNT; i++) {
+        REQUIRE_EQUAL(f->c._shards[i]._shard._cache._capacity, CAPACITY / SHARD_COUNT);
+        REQUIRE_EQUAL((uintptr_t) &(f->c._shards[i]) % CACHE_LINE_SIZE, 0);
+    }
+    REQUIRE_EQUAL(sizeof(union __shardedlrucache_slot) % CACHE_LINE_SIZE, 0);
+    REQUIRE(sizeof(union __shardedlrucache_slot)
+                < sizeof(struct __shardedlrucache_shard) + CACHE_LINE_SIZE);
+}
+
+void shardedlrucache_get_put0(struct fixture* f) {
+    struct item* items = f->items[0];
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        shardedlrucache_put(&(f->c), &(items[i].cache), key_hash(items[i].key),
+                            &(items[i].key), 1);
+    }
+    // Every shard is full: entries spread over shards
+    REQUIRE_EQUAL(shardedlrucache_size(&(f->c)), CAPACITY);
+    int cached = 0;
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        int hit = shardedlrucache_get(&(f->c), key_hash(items[i].key),
+                                      &(items[i].key), item_visit, NULL);
+        REQUIRE_EQUAL(hit, (items[i].evicted == 0));
+        REQUIRE_EQUAL(items[i].visited, hit);
+        cached += hit;
+    }
+    REQUIRE_EQUAL(cached, CAPACITY);
+
+    struct lrucache_stats stats;
+    shardedlrucache_stats(&(f->c), &stats);
+    REQUIRE_EQUAL(stats.hits, CAPACITY);
+    REQUIRE_EQUAL(stats.misses, ITEM_COUNT - CAPACITY);
+    REQUIRE_EQUAL(stats.evictions, ITEM_COUNT - CAPACITY);
+
+    int key = items[ITEM_COUNT - 1].key;
+    REQUIRE(shardedlrucache_erase(&(f->c), key_hash(key), &key));
+    REQUIRE(!shardedlrucache_erase(&(f->c), key_hash(key), &key));
+    REQUIRE_EQUAL(items[ITEM_COUNT - 1].evicted, 1);
+
+    // Direct access to a locked shard
+    struct lrucache* shard = shardedlrucache_lock(&(f->c), key_hash(key));
+    REQUIRE(lrucache_peek(shard, key_hash(key), &key) == NULL);
+    shardedlrucache_unlock(&(f->c), key_hash(key));
+}
+
+void shardedlrucache_hash32_0(struct fixture* f) {
+    struct item* items = f->items[0];
+    // Identity hashes only use their 32 low bits
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        shardedlrucache_put(&(f->c), &(items[i].cache),
+                            (uint64_t) items[i].key, &(items[i].key), 1);
+    }
+    // Every shard is full: entries spread over shards
+    REQUIRE_EQUAL(shardedlrucache_size(&(f->c)), CAPACITY);
+}
+
+static void* worker_run(void* arg) {
+    struct worker* w = (struct worker*) arg;
+    struct item* items = w->f->items[w->thread];
+    struct shardedlrucache* c = &(w->f->c);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        shardedlrucache_put(c, &(items[i].cache), key_hash(items[i].key),
+                            &(items[i].key), 1);
+        // Hit recent entries of this thread
+        int j = i / 2;
+        shardedlrucache_get(c, key_hash(items[j].key), &(items[j].key),
+                            item_visit, NULL);
+        if (i % 4 == 3) {
+            shardedlrucache_erase(c, key_hash(items[i].key), &(items[i].key));
+        }
+    }
+    return NULL;
+}
+
+void shardedlrucache_concurrent0(struct fixture* f) {
+    pthread_t threads[THREAD_COUNT];
+    struct worker workers[THREAD_COUNT];
+    shardedlrucache_set_promotion(&(f->c), CAPACITY / 4);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        workers[t].f = f;
+        workers[t].thread = t;
+        REQUIRE_EQUAL(pthread_create(&(threads[t]), NULL, worker_run,
+                                     &(workers[t])), 0);
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // Each entry was put once: it is either still cached or evicted once
+    _UINT_LEAST_64_T cached = 0;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            REQUIRE(f->items[t][i].evicted <= 1);
+            cached += (f->items[t][i].evicted == 0);
+        }
+    }
+    REQUIRE_EQUAL(shardedlrucache_size(&(f->c)), cached);
+    REQUIRE(cached <= CAPACITY);
+
+    struct lrucache_stats stats;
+    shardedlrucache_stats(&(f->c), &stats);
+    REQUIRE_EQUAL(stats.hits + stats.misses, THREAD_COUNT * ITEM_COUNT);
+    REQUIRE_EQUAL(stats.evictions, THREAD_COUNT * ITEM_COUNT - cached);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_shardedlrucache() {
+    static struct fixture f;
+    TEST_CASE(shardedlrucache_init0, &f)
+    TEST_CASE(shardedlrucache_get_put0, &f)
+    TEST_CASE(shardedlrucache_hash32_0, &f)
+    TEST_CASE(shardedlrucache_concurrent0, &f)
+    return 1;
+}
@@ -0,0 +1,177 @@
+//
+//  twoqcacheTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/cache/twoqcacheTest.h"
+#include "datastructure/cache/twoqcache.h"
+#include "datastructure/cache/lrucache.h"
+#include "datastructure/hash/hashtable.h"
+#include <stdlib.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define CAPACITY    100
+#define HOT_COUNT   50      /** Keys 0..HOT_COUNT-1 */
+#define SCAN_COUNT  2000    /** Keys HOT_COUNT..HOT_COUNT+SCAN_COUNT-1 */
+#define ITEM_COUNT  (HOT_COUNT + SCAN_COUNT)
+
+struct item {
+    int key;
+    int cached;
+    struct twoqcache_node q;
+    struct lrucache_node lru;
+};
+
+struct fixture {
+    struct item items[ITEM_COUNT];
+    struct twoqcache c;
+};
+
+static int item_match(const struct twoqcache_node* node, const void* key) {
+    return twoqcache_entry(node, struct item, q)->key == *(const int*) key;
+}
+
+static int item_match_lru(const struct lrucache_node* node, const void* key) {
+    return lrucache_entry(node, struct item, lru)->key == *(const int*) key;
+}
+
+static void item_evict(struct twoqcache_node* node, void* ctx) {
+    (void) ctx;
+    twoqcache_entry(node, struct item, q)->cached = 0;
+}
+
+static void item_evict_lru(struct lrucache_node* node, void* ctx) {
+    (void) ctx;
+    lrucache_entry(node, struct item, lru)->cached = 0;
+}
+
+static uint64_t key_hash(int key) {
+    return hashtable_hash_u64((uint64_t) key);
+}
+
+// Looks a key up, putting its entry on a miss. Returns 1 on a hit
+static int access_2q(struct fixture* f, int key) {
+    if (twoqcache_get(&(f->c), key_hash(key), &key) != NULL) {return 1;}
+    f->items[key].cached = 1;
+    twoqcache_put(&(f->c), &(f->items[key].q), key_hash(key), &key);
+    return 0;
+}
+
+static int access_lru(struct fixture* f, struct lrucache* c, int key) {
+    if (lrucache_get(c, key_hash(key), &key) != NULL) {return 1;}
+    f->items[key].cached = 1;
+    lrucache_put(c, &(f->items[key].lru), key_hash(key), &key, 1);
+    return 0;
+}
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].key = i;
+        f->items[i].cached = 0;
+    }
+    REQUIRE(twoqcache_init(&(f->c), CAPACITY, item_match, item_evict, NULL));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    twoqcache_free(&(f->c));
+}
+
+void twoqcache_queues0(struct fixture* f) {
+    // First put goes to in, hits leave it there
+    REQUIRE_EQUAL(access_2q(f, 0), 0);
+    REQUIRE_EQUAL(access_2q(f, 0), 1);
+    REQUIRE(!twoqcache_in_main(&(f->items[0].q)));
+
+    // Filling the cache evicts in's oldest entries, leaving ghosts
+    for (int i = 1; i <= CAPACITY; i++) {access_2q(f, i);}
+    REQUIRE_EQUAL(twoqcache_size(&(f->c)), CAPACITY);
+    REQUIRE_EQUAL(f->items[0].cached, 0);
+    REQUIRE_EQUAL(f->c._outsize, 1);
+
+    // A ghost admits the key to main
+    REQUIRE_EQUAL(access_2q(f, 0), 0);
+    REQUIRE(twoqcache_in_main(&(f->items[0].q)));
+    REQUIRE_EQUAL(twoqcache_stats(&(f->c))->ghosthits, 1);
+    REQUIRE_EQUAL(f->c._outsize, 1);
+    REQUIRE_EQUAL(twoqcache_size(&(f->c)), CAPACITY);
+
+    // Ghosts are bounded
+    for (int i = CAPACITY + 1; i < ITEM_COUNT; i++) {access_2q(f, i);}
+    REQUIRE_EQUAL(f->c._outsize, CAPACITY / TWOQCACHE_OUT_DIVISOR);
+    REQUIRE_EQUAL(twoqcache_size(&(f->c)), CAPACITY);
+
+    // Replacing keeps the queue
+    struct item other = f->items[0];
+    twoqcache_put(&(f->c), &(other.q), key_hash(0), &(other.key));
+    REQUIRE(twoqcache_in_main(&(other.q)));
+    REQUIRE_EQUAL(f->items[0].cached, 0);
+    twoqcache_remove(&(f->c), &(other.q));
+    REQUIRE_EQUAL(twoqcache_size(&(f->c)), CAPACITY - 1);
+}
+
+void twoqcache_capacity_one0(struct fixture* f) {
+    twoqcache_free(&(f->c));
+    REQUIRE(twoqcache_init(&(f->c), 1, item_match, item_evict, NULL));
+
+    // Ghost hit at capacity 1: the cold entry is evicted, not the new one
+    access_2q(f, 0);
+    access_2q(f, 1);
+    REQUIRE_EQUAL(f->items[0].cached, 0);
+    REQUIRE_EQUAL(access_2q(f, 0), 0);
+    REQUIRE(twoqcache_in_main(&(f->items[0].q)));
+    REQUIRE_EQUAL(f->items[0].cached, 1);
+    REQUIRE_EQUAL(f->items[1].cached, 0);
+    REQUIRE_EQUAL(twoqcache_size(&(f->c)), 1);
+    REQUIRE_EQUAL(access_2q(f, 0), 1);
+}
+
+void twoqcache_scan0(struct fixture* f) {
+    struct lrucache lru;
+    REQUIRE(lrucache_init(&lru, CAPACITY, 0, item_match_lru, item_evict_lru,
+                          NULL));
+    // Hot keys are seen repeatedly, each round interleaved with cold keys
+    // seen once
+    int cold = HOT_COUNT;
+    for (int round = 0; round < 4; round++) {
+        for (int k = 0; k < HOT_COUNT; k++) {
+            access_2q(f, k);
+            access_2q(f, cold++);
+        }
+    }
+    // Scan
+    for (int k = cold; k < ITEM_COUNT; k++) {access_2q(f, k);}
+    int hits = 0;
+    for (int k = 0; k < HOT_COUNT; k++) {hits += access_2q(f, k);}
+    REQUIRE_EQUAL(hits, HOT_COUNT);
+
+    // A plain LRU cache is flushed by the scan
+    cold = HOT_COUNT;
+    for (int round = 0; round < 4; round++) {
+        for (int k = 0; k < HOT_COUNT; k++) {
+            access_lru(f, &lru, k);
+            access_lru(f, &lru, cold++);
+        }
+    }
+    for (int k = cold; k < ITEM_COUNT; k++) {access_lru(f, &lru, k);}
+    hits = 0;
+    for (int k = 0; k < HOT_COUNT; k++) {hits += access_lru(f, &lru, k);}
+    REQUIRE_EQUAL(hits, 0);
+    lrucache_free(&lru);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_twoqcache() {
+    static struct fixture f;
+    TEST_CASE(twoqcache_queues0, &f)
+    TEST_CASE(twoqcache_scan0, &f)
+    TEST_CASE(twoqcache_capacity_one0, &f)
+    return 1;
+}
@@ -0,0 +1,143 @@
+//
+//  hashmapTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/hash/hashmapTest.h"
+#include "datastructure/hash/hashmap.h"
+#include "datastructure/hash/hashtable.h"
+#include <stdlib.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT 1000
+
+struct item {
+    uint64_t key;
+    struct hashmap_node hash;
+};
+
+struct fixture {
+    struct item items[ITEM_COUNT];
+    struct hashmap m;
+};
+
+static int item_match(const struct hashmap_node* node, const void* key) {
+    return hashmap_entry(node, struct item, hash)->key == *(const uint64_t*) key;
+}
+
+static struct item* item_find(struct hashmap* m, uint64_t key) {
+    struct hashmap_node* node = hashmap_find(m, hashtable_hash_u64(key),
+                                             item_match, &key);
+    return node == NULL ? NULL : hashmap_entry(node, struct item, hash);
+}
+
+static void item_add(struct hashmap* m, struct item* item) {
+    hashmap_add(m, &(item->hash), hashtable_hash_u64(item->key));
+}
+
+// Counts containers reached by hashmap_for_each
+static int count_all(struct hashmap* m) {
+    size_t bucket;
+    struct hashmap_node* node;
+    int count = 0;
+    hashmap_for_each(m, bucket, node) {count++;}
+    return count;
+}
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].key = (uint64_t) i * 3 + 1;
+    }
+    REQUIRE(hashmap_init(&(f->m), 4));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    hashmap_free(&(f->m));
+}
+
+void hashmap_init0(struct fixture* f) {
+    REQUIRE_EQUAL(f->m._mask, 3);
+    REQUIRE(hashmap_empty(&(f->m)));
+    REQUIRE(!hashmap_growing(&(f->m)));
+    REQUIRE(item_find(&(f->m), 1) == NULL);
+    REQUIRE_EQUAL(hashmap_migrate(&(f->m), 1), 0);
+    REQUIRE_EQUAL(count_all(&(f->m)), 0);
+}
+
+void hashmap_grow0(struct fixture* f) {
+    int grown = 0;
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        size_t migrated = f->m._migrated;
+        int growing = hashmap_growing(&(f->m));
+        item_add(&(f->m), &(f->items[i]));
+        // Each add migrates a bounded number of buckets
+        if (growing && hashmap_growing(&(f->m))) {
+            REQUIRE(f->m._migrated - migrated <= HASHMAP_MIGRATE_STEP);
+        }
+        if (!growing && hashmap_growing(&(f->m))) {
+            REQUIRE_EQUAL(f->m._migrated, 0);
+            grown++;
+        }
+        // Containers are reachable whether their bucket is migrated or not
+        for (int j = 0; j <= i; j += 1 + i / 16) {
+            REQUIRE(item_find(&(f->m), f->items[j].key) == &(f->items[j]));
+        }
+        REQUIRE(item_find(&(f->m), 0) == NULL);
+    }
+    REQUIRE_EQUAL(hashmap_size(&(f->m)), ITEM_COUNT);
+    REQUIRE(grown >= 8);
+    REQUIRE(f->m._mask + 1 >= ITEM_COUNT / 2);
+    REQUIRE_EQUAL(count_all(&(f->m)), ITEM_COUNT);
+
+    // Migration may be completed on demand
+    while (hashmap_migrate(&(f->m), 1)) {}
+    REQUIRE(!hashmap_growing(&(f->m)));
+    REQUIRE_EQUAL(count_all(&(f->m)), ITEM_COUNT);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        REQUIRE(item_find(&(f->m), f->items[i].key) == &(f->items[i]));
+    }
+}
+
+void hashmap_remove0(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        item_add(&(f->m), &(f->items[i]));
+        // Remove every 3rd container, during and outside growth alike
+        if (i % 3 == 2) {
+            hashmap_remove(&(f->m), &(f->items[i - 1].hash));
+        }
+    }
+    REQUIRE_EQUAL(hashmap_size(&(f->m)), ITEM_COUNT - ITEM_COUNT / 3);
+    REQUIRE_EQUAL(count_all(&(f->m)), ITEM_COUNT - ITEM_COUNT / 3);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        struct item* item = item_find(&(f->m), f->items[i].key);
+        if (i % 3 == 1 && i + 1 < ITEM_COUNT) {
+            REQUIRE(item == NULL);
+        } else {
+            REQUIRE(item == &(f->items[i]));
+        }
+    }
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        if (item_find(&(f->m), f->items[i].key) != NULL) {
+            hashmap_remove(&(f->m), &(f->items[i].hash));
+        }
+    }
+    REQUIRE(hashmap_empty(&(f->m)));
+    REQUIRE_EQUAL(count_all(&(f->m)), 0);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_hashmap() {
+    static struct fixture f;
+    TEST_CASE(hashmap_init0, &f)
+    TEST_CASE(hashmap_grow0, &f)
+    TEST_CASE(hashmap_remove0, &f)
+    return 1;
+}
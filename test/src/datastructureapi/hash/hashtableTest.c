@@ -0,0 +1,123 @@
+//
+//  hashtableTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/hash/hashtableTest.h"
+#include "datastructure/hash/hashtable.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT 1000
+#define BUCKET_COUNT 100
+
+struct item {
+    uint64_t key;
+    struct hlinkedlist_node hash;
+};
+
+struct fixture {
+    struct item items[ITEM_COUNT];
+    struct hashtable t;
+};
+
+static int item_match(const struct hlinkedlist_node* node, const void* key) {
+    return hlinkedlist_entry(node, struct item, hash)->key
+        == *(const uint64_t*) key;
+}
+
+static struct item* item_find(struct hashtable* t, uint64_t key) {
+    struct hlinkedlist_node* node = hashtable_find(t, hashtable_hash_u64(key),
+                                                   item_match, &key);
+    return node == NULL ? NULL : hlinkedlist_entry(node, struct item, hash);
+}
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].key = (uint64_t) i * 7;
+    }
+    REQUIRE(hashtable_init(&(f->t), BUCKET_COUNT));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    hashtable_free(&(f->t));
+}
+
+void hashtable_init0(struct fixture* f) {
+    REQUIRE_EQUAL(hashtable_bucket_count(&(f->t)), 128);
+    REQUIRE(hashtable_empty(&(f->t)));
+    REQUIRE(item_find(&(f->t), 7) == NULL);
+
+    struct hashtable t;
+    REQUIRE(hashtable_init(&t, 0));
+    REQUIRE_EQUAL(hashtable_bucket_count(&t), 1);
+    hashtable_free(&t);
+}
+
+void hashtable_add_find_remove0(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        hashtable_add(&(f->t), &(f->items[i].hash),
+                      hashtable_hash_u64(f->items[i].key));
+    }
+    REQUIRE_EQUAL(hashtable_size(&(f->t)), ITEM_COUNT);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        REQUIRE(item_find(&(f->t), (uint64_t) i * 7) == &(f->items[i]));
+        REQUIRE(item_find(&(f->t), (uint64_t) i * 7 + 1) == NULL);
+    }
+
+    // Every container is reached exactly once, in its own bucket
+    size_t bucket;
+    struct hlinkedlist_node* node;
+    int count = 0;
+    hashtable_for_each(&(f->t), bucket, node) {
+        struct item* item = hlinkedlist_entry(node, struct item, hash);
+        REQUIRE(hashtable_bucket(&(f->t), hashtable_hash_u64(item->key))
+                == &(f->t._buckets[bucket]));
+        count++;
+    }
+    REQUIRE_EQUAL(count, ITEM_COUNT);
+
+    // Keys are spread over buckets
+    size_t longest = 0;
+    for (bucket = 0; bucket < hashtable_bucket_count(&(f->t)); bucket++) {
+        size_t length = (size_t) hlinkedlist_size(&(f->t._buckets[bucket]));
+        if (length > longest) {longest = length;}
+    }
+    REQUIRE(longest < 4 * ITEM_COUNT / hashtable_bucket_count(&(f->t)));
+
+    for (int i = 0; i < ITEM_COUNT; i += 2) {
+        hashtable_remove(&(f->t), &(f->items[i].hash));
+    }
+    REQUIRE_EQUAL(hashtable_size(&(f->t)), ITEM_COUNT / 2);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        REQUIRE((item_find(&(f->t), (uint64_t) i * 7) == NULL) == (i % 2 == 0));
+    }
+}
+
+void hashtable_hash0(struct fixture* f) {
+    (void) f;
+    const char* s = "datastructure";
+    REQUIRE_EQUAL(hashtable_hash_bytes(s, strlen(s)),
+                  hashtable_hash_bytes("datastructure", 13));
+    REQUIRE(hashtable_hash_bytes(s, strlen(s)) != hashtable_hash_bytes(s, 4));
+    REQUIRE(hashtable_hash_u64(1) != hashtable_hash_u64(2));
+    REQUIRE_EQUAL(hashtable_hash_ptr(s), hashtable_hash_u64((uintptr_t) s));
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_hashtable() {
+    static struct fixture f;
+    TEST_CASE(hashtable_init0, &f)
+    TEST_CASE(hashtable_add_find_remove0, &f)
+    TEST_CASE(hashtable_hash0, &f)
+    return 1;
+}
@@ -0,0 +1,173 @@
+//
+//  dlinkedlistCountedTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/dlinkedlistCountedTest.h"
+#include "datastructure/list/dlinkedlist_counted.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define NODE_COUNT  8
+
+struct fixture {
+    struct dlinkedlist_counted l;
+    struct dlinkedlist_counted l2;
+    struct dlinkedlist_node nodes[NODE_COUNT];
+};
+
+static void fixture_setup(struct fixture* f) {
+    dlinkedlist_counted_init(&(f->l));
+    dlinkedlist_counted_init(&(f->l2));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    dlinkedlist_counted_init(&(f->l));
+    dlinkedlist_counted_init(&(f->l2));
+}
+
+static _UINT_LEAST_64_T walk_size(struct dlinkedlist_counted* l) {
+    return (_UINT_LEAST_64_T) dlinkedlist_size(&(l->head));
+}
+
+static int dlinkedlist_counted_free_num;
+static void* dlinkedlist_counted_free_node(struct dlinkedlist_node* n) {
+    dlinkedlist_counted_free_num++;
+    return n;
+}
+
+void dlinkedlist_counted_init0(struct fixture* f) {
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), 0);
+    REQUIRE(dlinkedlist_counted_empty(&(f->l)));
+    REQUIRE(dlinkedlist_empty(&(f->l.head)));
+}
+
+void dlinkedlist_counted_add0(struct fixture* f) {
+    dlinkedlist_counted_add_head(&(f->l), &(f->nodes[1]));
+    dlinkedlist_counted_add_tail(&(f->l), &(f->nodes[3]));
+    dlinkedlist_counted_add_head(&(f->l), &(f->nodes[0]));
+    dlinkedlist_counted_add_after(&(f->l), &(f->nodes[1]), &(f->nodes[2]));
+    dlinkedlist_counted_add_before(&(f->l), &(f->l.head), &(f->nodes[4]));
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), 5);
+    REQUIRE_EQUAL(walk_size(&(f->l)), 5);
+    struct dlinkedlist_node* n;
+    int i = 0;
+    dlinkedlist_for_each(&(f->l.head), n) {
+        REQUIRE_EQUAL(n, &(f->nodes[i]));
+        i++;
+    }
+}
+
+void dlinkedlist_counted_remove0(struct fixture* f) {
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_counted_add_tail(&(f->l), &(f->nodes[i]));
+    }
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_counted_remove(&(f->l), &(f->nodes[i]));
+        REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), NODE_COUNT - i - 1);
+        REQUIRE_EQUAL(walk_size(&(f->l)), NODE_COUNT - i - 1);
+    }
+    REQUIRE(dlinkedlist_counted_empty(&(f->l)));
+}
+
+void dlinkedlist_counted_splice0(struct fixture* f) {
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_counted_add_tail(i < 3 ? &(f->l) : &(f->l2), &(f->nodes[i]));
+    }
+    dlinkedlist_counted_splice(&(f->l), &(f->l2));
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), 0);
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l2)), NODE_COUNT);
+    REQUIRE_EQUAL(walk_size(&(f->l2)), NODE_COUNT);
+    REQUIRE(dlinkedlist_empty(&(f->l.head)));
+    REQUIRE_EQUAL(f->l2.head.next, &(f->nodes[0]));
+
+    // Splicing an empty list is harmless
+    dlinkedlist_counted_splice(&(f->l), &(f->l2));
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l2)), NODE_COUNT);
+}
+
+void dlinkedlist_counted_split0(struct fixture* f) {
+    for (int s = 0; s < NODE_COUNT; s++) {
+        dlinkedlist_counted_init(&(f->l));
+        dlinkedlist_counted_init(&(f->l2));
+        for (int i = 0; i < NODE_COUNT; i++) {
+            dlinkedlist_counted_add_tail(&(f->l), &(f->nodes[i]));
+        }
+        dlinkedlist_counted_split(&(f->l), &(f->l2), &(f->nodes[s]));
+        REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), s);
+        REQUIRE_EQUAL(walk_size(&(f->l)), s);
+        REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l2)), NODE_COUNT - s);
+        REQUIRE_EQUAL(walk_size(&(f->l2)), NODE_COUNT - s);
+        REQUIRE_EQUAL(f->l2.head.next, &(f->nodes[s]));
+    }
+
+    // Separator is the head: nothing moves
+    dlinkedlist_counted_init(&(f->l));
+    dlinkedlist_counted_init(&(f->l2));
+    dlinkedlist_counted_add_tail(&(f->l), &(f->nodes[0]));
+    dlinkedlist_counted_split(&(f->l), &(f->l2), &(f->l.head));
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), 1);
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l2)), 0);
+}
+
+void dlinkedlist_counted_free0(struct fixture* f) {
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_counted_add_tail(&(f->l), &(f->nodes[i]));
+    }
+    dlinkedlist_counted_free_num = 0;
+    dlinkedlist_counted_free(&(f->l), dlinkedlist_counted_free_node);
+    REQUIRE_EQUAL(dlinkedlist_counted_free_num, NODE_COUNT);
+    REQUIRE(dlinkedlist_counted_empty(&(f->l)));
+    REQUIRE(dlinkedlist_empty(&(f->l.head)));
+}
+
+// ctx is the nodes array: odd nodes match
+static int dlinkedlist_counted_is_odd(const struct dlinkedlist_node* n, void* ctx) {
+    return (int) (n - (const struct dlinkedlist_node*) ctx) % 2;
+}
+
+void dlinkedlist_counted_bulk0(struct fixture* f) {
+    struct dlinkedlist_node* nodes[NODE_COUNT];
+    for (int i = 0; i < NODE_COUNT; i++) {
+        nodes[i] = &(f->nodes[i]);
+    }
+    dlinkedlist_counted_add_tail_bulk(&(f->l), nodes + 3, NODE_COUNT - 3);
+    dlinkedlist_counted_add_head_bulk(&(f->l), nodes, 3);
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), NODE_COUNT);
+    REQUIRE_EQUAL(walk_size(&(f->l)), NODE_COUNT);
+
+    REQUIRE_EQUAL(dlinkedlist_counted_remove_if(&(f->l), dlinkedlist_counted_is_odd,
+                                                f->nodes, &(f->l2)), NODE_COUNT / 2);
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l)), NODE_COUNT / 2);
+    REQUIRE_EQUAL(walk_size(&(f->l)), NODE_COUNT / 2);
+    REQUIRE_EQUAL(dlinkedlist_counted_size(&(f->l2)), NODE_COUNT / 2);
+    REQUIRE_EQUAL(walk_size(&(f->l2)), NODE_COUNT / 2);
+    struct dlinkedlist_node* n;
+    int i = 1;
+    dlinkedlist_for_each(&(f->l2.head), n) {
+        REQUIRE_EQUAL(n, &(f->nodes[i]));
+        i += 2;
+    }
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_dlinkedlist_counted() {
+    struct fixture f;
+    TEST_CASE(dlinkedlist_counted_init0, &f)
+    TEST_CASE(dlinkedlist_counted_add0, &f)
+    TEST_CASE(dlinkedlist_counted_remove0, &f)
+    TEST_CASE(dlinkedlist_counted_splice0, &f)
+    TEST_CASE(dlinkedlist_counted_split0, &f)
+    TEST_CASE(dlinkedlist_counted_free0, &f)
+    TEST_CASE(dlinkedlist_counted_bulk0, &f)
+    return 1;
+}
@@ -0,0 +1,211 @@
+//
+//  dlinkedlistParallelTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#define DLINKEDLIST_PARALLEL_MIN_SEGMENT 16
+
+#include "datastructureapi/list/dlinkedlistParallelTest.h"
+#include "datastructure/list/dlinkedlist_parallel.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define THREAD_COUNT    3
+#define ITEM_COUNT      100000
+
+/** Testing data structure */
+struct item {
+    int value;
+    int visits;
+    struct dlinkedlist_node list;
+};
+
+struct fixture {
+    struct threadpool pool;
+    struct dlinkedlist_node h;
+    struct item items[ITEM_COUNT];
+};
+
+/** Reduction checking that segments are combined in list order */
+struct range {
+    int first;
+    int last;
+    int count;
+    int64_t sum;
+};
+
+static void fixture_setup(struct fixture* f) {
+    REQUIRE(threadpool_init(&(f->pool), THREAD_COUNT));
+    dlinkedlist_init_head(&(f->h), NULL);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].value = i;
+        f->items[i].visits = 0;
+    }
+}
+
+static void fixture_teardown(struct fixture* f) {
+    threadpool_free(&(f->pool));
+    dlinkedlist_init_head(&(f->h), NULL);
+}
+
+static void link_items(struct fixture* f, int count) {
+    dlinkedlist_init_head(&(f->h), NULL);
+    for (int i = 0; i < count; i++) {
+        dlinkedlist_add_tail(&(f->h), &(f->items[i].list), NULL);
+    }
+}
+
+static void visit_count(struct dlinkedlist_node* node, void* ctx, void* acc) {
+    (void) ctx;
+    (void) acc;
+    dlinkedlist_entry(node, struct item, list)->visits++;
+}
+
+static void visit_range(struct dlinkedlist_node* node, void* ctx, void* acc) {
+    struct range* r = (struct range*) acc;
+    int value = dlinkedlist_entry(node, struct item, list)->value;
+    (void) ctx;
+    if (r->count == 0) {r->first = value;}
+    REQUIRE(r->count == 0 || r->last + 1 == value);
+    r->last = value;
+    r->count++;
+    r->sum += value;
+}
+
+static void combine_range(void* result, const void* acc, void* ctx) {
+    struct range* r = (struct range*) result;
+    const struct range* a = (const struct range*) acc;
+    (*(int*) ctx)++;
+    REQUIRE_EQUAL((uintptr_t) acc % CACHE_LINE_SIZE, 0);
+    if (a->count == 0) {return;}
+    if (r->count == 0) {
+        r->first = a->first;
+    } else {
+        REQUIRE_EQUAL(r->last + 1, a->first);
+    }
+    r->last = a->last;
+    r->count += a->count;
+    r->sum += a->sum;
+}
+
+void dlinkedlist_segments_init0(struct fixture* f) {
+    static const int sizes[] = {0, 1, 15, 16, 17, 100, 1000, ITEM_COUNT};
+    struct dlinkedlist_segments s;
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        int size = sizes[k];
+        link_items(f, size);
+        for (size_t count = 1; count <= 10; count++) {
+            REQUIRE(dlinkedlist_segments_init(&s, &(f->h), count));
+            size_t segments = dlinkedlist_segments_count(&s);
+            REQUIRE(segments <= count);
+            REQUIRE(segments <= (size_t) (size + 15) / 16);
+            REQUIRE_EQUAL((segments == 0), (size == 0));
+            REQUIRE_EQUAL(dlinkedlist_segments_first(&s, segments), &(f->h));
+            if (segments == 0) {
+                dlinkedlist_segments_free(&s);
+                continue;
+            }
+            REQUIRE_EQUAL(dlinkedlist_segments_first(&s, 0), f->h.next);
+
+            // Segments are consecutive and balanced
+            int average = size / (int) segments;
+            for (size_t i = 0; i < segments; i++) {
+                struct dlinkedlist_node* n = dlinkedlist_segments_first(&s, i);
+                int length = 0;
+                while (n != dlinkedlist_segments_first(&s, i + 1)) {
+                    REQUIRE(n != &(f->h));
+                    n = n->next;
+                    length++;
+                }
+                REQUIRE(length > 0);
+                REQUIRE(abs(length - average) <= average / 8 + 1);
+            }
+            dlinkedlist_segments_free(&s);
+        }
+    }
+}
+
+void dlinkedlist_parallel_for_each0(struct fixture* f) {
+    for (int round = 0; round < 3; round++) {
+        link_items(f, ITEM_COUNT - round * 1001);
+        dlinkedlist_parallel_for_each(&(f->pool), &(f->h), visit_count, NULL);
+    }
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        int expected = (i < ITEM_COUNT - 2002) ? 3
+                            : (i < ITEM_COUNT - 1001) ? 2 : 1;
+        REQUIRE_EQUAL(f->items[i].visits, expected);
+    }
+
+    // Empty list
+    dlinkedlist_init_head(&(f->h), NULL);
+    dlinkedlist_parallel_for_each(&(f->pool), &(f->h), visit_count, NULL);
+}
+
+void dlinkedlist_parallel_reduce0(struct fixture* f) {
+    static const int sizes[] = {0, 1, 100, ITEM_COUNT};
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        struct range r = {0, 0, 0, 0};
+        int combined = 0;
+        link_items(f, sizes[k]);
+        dlinkedlist_parallel_reduce(&(f->pool), &(f->h), visit_range,
+                                    combine_range, &combined, &r, sizeof(r));
+        REQUIRE_EQUAL(r.count, sizes[k]);
+        REQUIRE_EQUAL(r.sum, (int64_t) sizes[k] * (sizes[k] - 1) / 2);
+        if (sizes[k] > 0) {
+            REQUIRE_EQUAL(r.first, 0);
+            REQUIRE_EQUAL(r.last, sizes[k] - 1);
+        }
+        if (sizes[k] == ITEM_COUNT) {
+            REQUIRE_EQUAL(combined, (THREAD_COUNT + 1)
+                                        * DLINKEDLIST_PARALLEL_SEGMENTS_PER_THREAD);
+        }
+    }
+}
+
+void dlinkedlist_parallel_reduce_segments0(struct fixture* f) {
+    struct dlinkedlist_segments s;
+    link_items(f, ITEM_COUNT);
+    REQUIRE(dlinkedlist_segments_init(&s, &(f->h), 64));
+    REQUIRE_EQUAL(dlinkedlist_segments_count(&s), 64);
+
+    // Index is reused across traversals
+    for (int round = 0; round < 3; round++) {
+        struct range r = {0, 0, 0, 0};
+        int combined = 0;
+        dlinkedlist_parallel_reduce_segments(&(f->pool), &s, visit_range,
+                                             combine_range, &combined, &r,
+                                             sizeof(r));
+        REQUIRE_EQUAL(combined, 64);
+        REQUIRE_EQUAL(r.count, ITEM_COUNT);
+        REQUIRE_EQUAL(r.last, ITEM_COUNT - 1);
+    }
+
+    // Nodes added at the tail join the last segment
+    dlinkedlist_remove(&(f->items[ITEM_COUNT - 1].list), NULL);
+    dlinkedlist_add_tail(&(f->h), &(f->items[ITEM_COUNT - 1].list), NULL);
+    dlinkedlist_parallel_reduce_segments(&(f->pool), &s, visit_count, NULL,
+                                         NULL, NULL, 0);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        REQUIRE_EQUAL(f->items[i].visits, 1);
+    }
+    dlinkedlist_segments_free(&s);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_dlinkedlist_parallel() {
+    static struct fixture f;
+    TEST_CASE(dlinkedlist_segments_init0, &f)
+    TEST_CASE(dlinkedlist_parallel_for_each0, &f)
+    TEST_CASE(dlinkedlist_parallel_reduce0, &f)
+    TEST_CASE(dlinkedlist_parallel_reduce_segments0, &f)
+    return 1;
+}
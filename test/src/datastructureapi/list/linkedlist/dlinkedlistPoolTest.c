@@ -0,0 +1,127 @@
+//
+//  dlinkedlistPoolTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/dlinkedlistPoolTest.h"
+#include "datastructure/list/dlinkedlist_pool.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define SLAB_OBJS   4
+
+/** Testing data structure */
+struct foo {
+    int bar;
+    struct dlinkedlist_node list;
+    char baz;
+};
+
+struct fixture {
+    struct dlinkedlist_pool pool;
+};
+
+static void fixture_setup(struct fixture* f) {
+    dlinkedlist_pool_init_type(&(f->pool), struct foo, list, SLAB_OBJS);
+}
+
+static void fixture_teardown(struct fixture* f) {
+    dlinkedlist_pool_free(&(f->pool));
+}
+
+static int pool_slab_count(struct dlinkedlist_pool* pool) {
+    struct dlinkedlist_node* n;
+    int count = 0;
+    dlinkedlist_for_each(&(pool->_slabs), n) {count++;}
+    return count;
+}
+
+void dlinkedlist_pool_alloc0(struct fixture* f) {
+    struct foo* foos[SLAB_OBJS * 3];
+    for (int i = 0; i < SLAB_OBJS * 3; i++) {
+        struct dlinkedlist_node* n = dlinkedlist_pool_alloc(&(f->pool));
+        REQUIRE(n != NULL);
+        foos[i] = dlinkedlist_entry(n, struct foo, list);
+        foos[i]->bar = i;
+        foos[i]->baz = (char) i;
+    }
+    REQUIRE_EQUAL(pool_slab_count(&(f->pool)), 3);
+    // Containers of a slab are contiguous
+    REQUIRE_EQUAL(foos[1], foos[0] + 1);
+    REQUIRE_EQUAL(foos[SLAB_OBJS - 1], foos[0] + SLAB_OBJS - 1);
+    for (int i = 0; i < SLAB_OBJS * 3; i++) {
+        REQUIRE_EQUAL(foos[i]->bar, i);
+        REQUIRE_EQUAL(foos[i]->baz, (char) i);
+    }
+}
+
+void dlinkedlist_pool_release0(struct fixture* f) {
+    struct dlinkedlist_node* n0 = dlinkedlist_pool_alloc(&(f->pool));
+    struct dlinkedlist_node* n1 = dlinkedlist_pool_alloc(&(f->pool));
+    dlinkedlist_pool_release(&(f->pool), n0);
+    dlinkedlist_pool_release(&(f->pool), n1);
+    // Last released first reused
+    REQUIRE_EQUAL(dlinkedlist_pool_alloc(&(f->pool)), n1);
+    REQUIRE_EQUAL(dlinkedlist_pool_alloc(&(f->pool)), n0);
+    REQUIRE_EQUAL(pool_slab_count(&(f->pool)), 1);
+}
+
+void dlinkedlist_pool_release_list0(struct fixture* f) {
+    struct dlinkedlist_node head;
+    int_least32_t size;
+    dlinkedlist_init_head(&head, &size);
+    for (int i = 0; i < SLAB_OBJS * 2; i++) {
+        dlinkedlist_add_tail(&head, dlinkedlist_pool_alloc(&(f->pool)), &size);
+    }
+    REQUIRE_EQUAL(size, SLAB_OBJS * 2);
+    struct dlinkedlist_node* first = head.next;
+
+    dlinkedlist_pool_release_list(&(f->pool), &head, &size);
+    REQUIRE_EQUAL(size, 0);
+    REQUIRE(dlinkedlist_empty(&head));
+
+    // Released containers are reused before any new slab is allocated
+    REQUIRE_EQUAL(dlinkedlist_pool_alloc(&(f->pool)), first);
+    for (int i = 1; i < SLAB_OBJS * 2; i++) {
+        REQUIRE(dlinkedlist_pool_alloc(&(f->pool)) != NULL);
+    }
+    REQUIRE_EQUAL(pool_slab_count(&(f->pool)), 2);
+
+    // Releasing an empty list is harmless
+    dlinkedlist_pool_release_list(&(f->pool), &head, &size);
+    REQUIRE_EQUAL(size, 0);
+}
+
+void dlinkedlist_pool_reset0(struct fixture* f) {
+    struct dlinkedlist_node* first = dlinkedlist_pool_alloc(&(f->pool));
+    for (int i = 1; i < SLAB_OBJS * 2; i++) {
+        dlinkedlist_pool_alloc(&(f->pool));
+    }
+    REQUIRE_EQUAL(pool_slab_count(&(f->pool)), 2);
+
+    dlinkedlist_pool_reset(&(f->pool));
+    REQUIRE_EQUAL(dlinkedlist_pool_alloc(&(f->pool)), first);
+    for (int i = 1; i < SLAB_OBJS * 2; i++) {
+        dlinkedlist_pool_alloc(&(f->pool));
+    }
+    REQUIRE_EQUAL(pool_slab_count(&(f->pool)), 2);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_dlinkedlist_pool() {
+    struct fixture f;
+    TEST_CASE(dlinkedlist_pool_alloc0, &f)
+    TEST_CASE(dlinkedlist_pool_release0, &f)
+    TEST_CASE(dlinkedlist_pool_release_list0, &f)
+    TEST_CASE(dlinkedlist_pool_reset0, &f)
+    return 1;
+}
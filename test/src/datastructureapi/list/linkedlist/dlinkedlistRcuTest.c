@@ -0,0 +1,179 @@
+//
+//  dlinkedlistRcuTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/dlinkedlistRcuTest.h"
+#include "datastructure/list/dlinkedlist_rcu.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT      64
+#define READER_COUNT    2
+#define WRITER_ROUNDS   2000
+
+/** Testing data structure */
+struct item {
+    int alive;  // 0 once freed
+    int linked; // 1 iff in the list (writer only)
+    struct dlinkedlist_node list;
+};
+
+struct fixture {
+    struct dlinkedlist_rcu rcu;
+    struct dlinkedlist_node h;
+    int_least32_t size;
+    struct item items[ITEM_COUNT];
+    int stop;
+};
+
+static void fixture_setup(struct fixture* f) {
+    dlinkedlist_rcu_init(&(f->rcu));
+    dlinkedlist_init_head(&(f->h), &(f->size));
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].alive = 1;
+    }
+    f->stop = 0;
+}
+
+static void fixture_teardown(struct fixture* f) {
+    dlinkedlist_init_head(&(f->h), &(f->size));
+}
+
+static void* dlinkedlist_rcu_free_item(struct dlinkedlist_node* n) {
+    ATOMIC_STORE_RELAXED(&(dlinkedlist_entry(n, struct item, list)->alive), 0);
+    return n;
+}
+
+void dlinkedlist_rcu_add_remove0(struct fixture* f) {
+    dlinkedlist_add_tail_rcu(&(f->h), &(f->items[1].list), &(f->size));
+    dlinkedlist_add_head_rcu(&(f->h), &(f->items[0].list), &(f->size));
+    dlinkedlist_add_tail_rcu(&(f->h), &(f->items[3].list), &(f->size));
+    dlinkedlist_add_before_rcu(&(f->items[3].list), &(f->items[2].list), &(f->size));
+    REQUIRE_EQUAL(f->size, 4);
+    REQUIRE_EQUAL(dlinkedlist_size(&(f->h)), 4);
+    struct dlinkedlist_node* n;
+    int i = 0;
+    dlinkedlist_for_each_rcu(&(f->h), n) {
+        REQUIRE_EQUAL(n, &(f->items[i].list));
+        i++;
+    }
+    i = 4;
+    dlinkedlist_for_each_prev(&(f->h), n) {
+        i--;
+        REQUIRE_EQUAL(n, &(f->items[i].list));
+    }
+
+    // Removed node still leads readers back into the list
+    dlinkedlist_remove_rcu(&(f->items[1].list), &(f->size));
+    REQUIRE_EQUAL(f->size, 3);
+    REQUIRE_EQUAL(f->items[0].list.next, &(f->items[2].list));
+    REQUIRE_EQUAL(f->items[2].list.prev, &(f->items[0].list));
+    REQUIRE_EQUAL(f->items[1].list.next, &(f->items[2].list));
+}
+
+void dlinkedlist_rcu_reclaim0(struct fixture* f) {
+    int reader = dlinkedlist_rcu_register(&(f->rcu));
+    REQUIRE_EQUAL(reader, 0);
+    REQUIRE_EQUAL(dlinkedlist_rcu_register(&(f->rcu)), 1);
+    dlinkedlist_rcu_unregister(&(f->rcu), 1);
+    for (int i = 0; i < 4; i++) {
+        dlinkedlist_add_tail_rcu(&(f->h), &(f->items[i].list), &(f->size));
+    }
+
+    // Nothing is freed while a reader may see the node
+    dlinkedlist_rcu_read_lock(&(f->rcu), reader);
+    dlinkedlist_remove_rcu(&(f->items[1].list), &(f->size));
+    dlinkedlist_rcu_retire(&(f->rcu), &(f->items[1].list));
+    REQUIRE_EQUAL(dlinkedlist_rcu_try_reclaim(&(f->rcu), dlinkedlist_rcu_free_item), 0);
+    REQUIRE_EQUAL(f->items[1].alive, 1);
+    dlinkedlist_rcu_read_unlock(&(f->rcu), reader);
+    REQUIRE_EQUAL(dlinkedlist_rcu_try_reclaim(&(f->rcu), dlinkedlist_rcu_free_item), 1);
+    REQUIRE_EQUAL(f->items[1].alive, 0);
+
+    // Grace period elapses once readers are gone
+    dlinkedlist_remove_rcu(&(f->items[2].list), &(f->size));
+    dlinkedlist_rcu_retire(&(f->rcu), &(f->items[2].list));
+    dlinkedlist_remove_rcu(&(f->items[3].list), &(f->size));
+    dlinkedlist_rcu_retire(&(f->rcu), &(f->items[3].list));
+    REQUIRE_EQUAL(dlinkedlist_rcu_reclaim(&(f->rcu), dlinkedlist_rcu_free_item), 2);
+    REQUIRE_EQUAL(f->items[2].alive, 0);
+    REQUIRE_EQUAL(f->items[3].alive, 0);
+    REQUIRE_EQUAL(dlinkedlist_rcu_reclaim(&(f->rcu), dlinkedlist_rcu_free_item), 0);
+    REQUIRE_EQUAL(f->size, 1);
+    dlinkedlist_rcu_unregister(&(f->rcu), reader);
+}
+
+static void* dlinkedlist_rcu_read(void* arg) {
+    struct fixture* f = (struct fixture*) arg;
+    int reader = dlinkedlist_rcu_register(&(f->rcu));
+    REQUIRE(reader >= 0);
+    while (!ATOMIC_LOAD_ACQUIRE(&(f->stop))) {
+        struct dlinkedlist_node* n;
+        dlinkedlist_rcu_read_lock(&(f->rcu), reader);
+        dlinkedlist_for_each_rcu(&(f->h), n) {
+            REQUIRE(ATOMIC_LOAD_RELAXED(&(dlinkedlist_entry(n, struct item, list)->alive)));
+        }
+        dlinkedlist_rcu_read_unlock(&(f->rcu), reader);
+    }
+    dlinkedlist_rcu_unregister(&(f->rcu), reader);
+    return NULL;
+}
+
+void dlinkedlist_rcu_concurrent0(struct fixture* f) {
+    pthread_t threads[READER_COUNT];
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].linked = 1;
+        dlinkedlist_add_tail_rcu(&(f->h), &(f->items[i].list), &(f->size));
+    }
+    for (int t = 0; t < READER_COUNT; t++) {
+        REQUIRE_EQUAL(pthread_create(&(threads[t]), NULL, dlinkedlist_rcu_read, f), 0);
+    }
+
+    // Recycle nodes: remove, retire, reclaim, then publish again
+    unsigned int seed = 42;
+    for (int round = 0; round < WRITER_ROUNDS; round++) {
+        seed = seed * 1103515245u + 12345u;
+        struct item* item = &(f->items[(seed >> 16) % ITEM_COUNT]);
+        if (item->linked) {
+            item->linked = 0;
+            dlinkedlist_remove_rcu(&(item->list), &(f->size));
+            dlinkedlist_rcu_retire(&(f->rcu), &(item->list));
+        }
+        if (round % 16 == 0) {
+            dlinkedlist_rcu_reclaim(&(f->rcu), dlinkedlist_rcu_free_item);
+            for (int i = 0; i < ITEM_COUNT; i++) {
+                if (!f->items[i].alive) {
+                    f->items[i].alive = 1;
+                    f->items[i].linked = 1;
+                    dlinkedlist_add_tail_rcu(&(f->h), &(f->items[i].list), &(f->size));
+                }
+            }
+        }
+    }
+    ATOMIC_STORE_RELEASE(&(f->stop), 1);
+    for (int t = 0; t < READER_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    dlinkedlist_rcu_reclaim(&(f->rcu), dlinkedlist_rcu_free_item);
+    REQUIRE_EQUAL(dlinkedlist_size(&(f->h)), f->size);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_dlinkedlist_rcu() {
+    static struct fixture f;
+    TEST_CASE(dlinkedlist_rcu_add_remove0, &f)
+    TEST_CASE(dlinkedlist_rcu_reclaim0, &f)
+    TEST_CASE(dlinkedlist_rcu_concurrent0, &f)
+    return 1;
+}
@@ -0,0 +1,153 @@
+//
+//  dlinkedlistSortTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/dlinkedlistSortTest.h"
+#include "datastructure/list/dlinkedlist_sort.h"
+#define DLINKEDLIST_PARALLEL_SORT_MIN_SEGMENT 16
+#include "datastructure/list/dlinkedlist_parallel_sort.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT  1000
+
+/** Testing data structure */
+struct item {
+    int key;
+    int seq;    // Insertion order, to check stability
+    struct dlinkedlist_node list;
+};
+
+struct fixture {
+    struct dlinkedlist_node h;
+    struct dlinkedlist_node h2;
+    int_least32_t size;
+    int_least32_t size2;
+    struct item items[ITEM_COUNT];
+};
+
+static int compare_items(const struct dlinkedlist_node* a,
+                         const struct dlinkedlist_node* b,
+                         void* ctx) {
+    const struct item* ia = dlinkedlist_entry(a, const struct item, list);
+    const struct item* ib = dlinkedlist_entry(b, const struct item, list);
+    if (ctx != NULL) {(*(int*) ctx)++;}
+    return (ia->key > ib->key) - (ia->key < ib->key);
+}
+
+static void fixture_setup(struct fixture* f) {
+    dlinkedlist_init_head(&(f->h), &(f->size));
+    dlinkedlist_init_head(&(f->h2), &(f->size2));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    dlinkedlist_init_head(&(f->h), &(f->size));
+    dlinkedlist_init_head(&(f->h2), &(f->size2));
+}
+
+static void add_items(struct fixture* f, struct dlinkedlist_node* head,
+                      int_least32_t* size, int from, int count, int keymod) {
+    for (int i = from; i < from + count; i++) {
+        f->items[i].key = rand() % keymod;
+        f->items[i].seq = i;
+        dlinkedlist_add_tail(head, &(f->items[i].list), size);
+    }
+}
+
+// Checks list is sorted, stable, and prev/next links are consistent
+static void require_sorted(struct dlinkedlist_node* head, int count) {
+    struct dlinkedlist_node* n;
+    struct dlinkedlist_node* prev = head;
+    int num = 0;
+    dlinkedlist_for_each(head, n) {
+        REQUIRE_EQUAL(n->prev, prev);
+        if (prev != head) {
+            struct item* a = dlinkedlist_entry(prev, struct item, list);
+            struct item* b = dlinkedlist_entry(n, struct item, list);
+            REQUIRE(a->key <= b->key);
+            REQUIRE(a->key != b->key || a->seq < b->seq);
+        }
+        prev = n;
+        num++;
+    }
+    REQUIRE_EQUAL(head->prev, prev);
+    REQUIRE_EQUAL(num, count);
+}
+
+void dlinkedlist_sort0(struct fixture* f) {
+    // Empty and singular lists
+    dlinkedlist_sort(&(f->h), compare_items, NULL);
+    require_sorted(&(f->h), 0);
+    add_items(f, &(f->h), &(f->size), 0, 1, 10);
+    dlinkedlist_sort(&(f->h), compare_items, NULL);
+    require_sorted(&(f->h), 1);
+}
+
+void dlinkedlist_sort1(struct fixture* f) {
+    int counts[6] = {2, 3, 7, 64, 65, ITEM_COUNT};
+    for (int c = 0; c < 6; c++) {
+        dlinkedlist_init_head(&(f->h), &(f->size));
+        // Few distinct keys to exercise stability
+        add_items(f, &(f->h), &(f->size), 0, counts[c], 7);
+        int comparisons = 0;
+        dlinkedlist_sort(&(f->h), compare_items, &comparisons);
+        require_sorted(&(f->h), counts[c]);
+        REQUIRE(comparisons > 0);
+    }
+}
+
+void dlinkedlist_merge0(struct fixture* f) {
+    int counts[10] = {0, 0,   0, 5,   5, 0,   1, 1,   300, 700};
+    for (int c = 0; c < 5; c++) {
+        int n = counts[c * 2];
+        int n2 = counts[c * 2 + 1];
+        dlinkedlist_init_head(&(f->h), &(f->size));
+        dlinkedlist_init_head(&(f->h2), &(f->size2));
+        // head's items are inserted first: they must stay first on ties
+        add_items(f, &(f->h), &(f->size), 0, n, 13);
+        add_items(f, &(f->h2), &(f->size2), n, n2, 13);
+        dlinkedlist_sort(&(f->h), compare_items, NULL);
+        dlinkedlist_sort(&(f->h2), compare_items, NULL);
+
+        dlinkedlist_merge(&(f->h2), &(f->h), compare_items, NULL,
+                          &(f->size2), &(f->size));
+        REQUIRE_EQUAL(f->size, n + n2);
+        REQUIRE_EQUAL(f->size2, 0);
+        REQUIRE(dlinkedlist_empty(&(f->h2)));
+        require_sorted(&(f->h), n + n2);
+    }
+}
+
+void dlinkedlist_parallel_sort0(struct fixture* f) {
+    int counts[5] = {0, 1, 15, 100, ITEM_COUNT};
+    unsigned int threads[4] = {0, 1, 3, 8};
+    for (int c = 0; c < 5; c++) {
+        for (int t = 0; t < 4; t++) {
+            dlinkedlist_init_head(&(f->h), &(f->size));
+            add_items(f, &(f->h), &(f->size), 0, counts[c], 11);
+            dlinkedlist_parallel_sort(&(f->h), compare_items, NULL, threads[t]);
+            require_sorted(&(f->h), counts[c]);
+        }
+    }
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_dlinkedlist_sort() {
+    static struct fixture f;
+    srand(42);
+    TEST_CASE(dlinkedlist_sort0, &f)
+    TEST_CASE(dlinkedlist_sort1, &f)
+    TEST_CASE(dlinkedlist_merge0, &f)
+    TEST_CASE(dlinkedlist_parallel_sort0, &f)
+    return 1;
+}
@@ -0,0 +1,262 @@
+//
+//  dlinkedlistStatsTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Statistics are enabled for this translation unit only.
+//
+
+#ifndef DATASTRUCTURE_STATS
+    #define DATASTRUCTURE_STATS
+#endif
+
+#include "datastructureapi/list/dlinkedlistStatsTest.h"
+#include "datastructure/list/dlinkedlist.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define NODE_COUNT      100
+#define THREAD_COUNT    4
+#define WALK_COUNT      50      /** Per thread */
+
+DLINKEDLIST_STATS_DEFINE
+
+struct foo {
+    int bar;
+    struct dlinkedlist_node list;
+};
+
+struct fixture {
+    struct foo foos[NODE_COUNT];
+    struct foo own[THREAD_COUNT][NODE_COUNT];
+    struct dlinkedlist_node heads[THREAD_COUNT];
+    struct dlinkedlist_node head;
+    struct dlinkedlist_node list;
+};
+
+struct worker {
+    struct fixture* f;
+    int thread;
+};
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < NODE_COUNT; i++) {
+        f->foos[i].bar = i;
+    }
+    dlinkedlist_init_head(&(f->head), NULL);
+    dlinkedlist_init_head(&(f->list), NULL);
+    dlinkedlist_stats_reset();
+}
+
+static void fixture_teardown(struct fixture* f) {
+    (void) f;
+}
+
+// Merged statistics of head. Zeroed statistics iff head is unknown
+static struct dlinkedlist_stats stats_of(const void* head) {
+    struct dlinkedlist_stats result;
+    size_t count;
+    struct dlinkedlist_stats* stats = dlinkedlist_stats_collect(&count);
+    REQUIRE(stats != NULL);
+    memset(&result, 0, sizeof(result));
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            // Sorted, one entry per head
+            REQUIRE((uintptr_t) stats[i - 1].head < (uintptr_t) stats[i].head);
+        }
+        if (stats[i].head == head) {result = stats[i];}
+    }
+    free(stats);
+    return result;
+}
+
+static int is_odd(const struct dlinkedlist_node* node, void* ctx) {
+    (void) ctx;
+    return dlinkedlist_entry(node, struct foo, list)->bar % 2;
+}
+
+void dlinkedlist_stats_bucket0(struct fixture* f) {
+    (void) f;
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(0), 0);
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(1), 1);
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(2), 2);
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(3), 2);
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(4), 3);
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(100), 7);
+    REQUIRE_EQUAL(dlinkedlist_stats_bucket(UINT64_MAX),
+                  DLINKEDLIST_STATS_BUCKETS - 1);
+}
+
+void dlinkedlist_stats_operations0(struct fixture* f) {
+    struct dlinkedlist_node* nodes[10];
+    struct dlinkedlist_stats s;
+    struct dlinkedlist_stats unknown = stats_of(NULL);
+
+    for (int i = 0; i < 10; i++) {
+        dlinkedlist_add_tail(&(f->head), &(f->foos[i].list), NULL);
+    }
+    dlinkedlist_add_head(&(f->head), &(f->foos[10].list), NULL);
+    for (int i = 0; i < 10; i++) {
+        nodes[i] = &(f->foos[20 + i].list);
+    }
+    dlinkedlist_add_tail_bulk(&(f->head), nodes, 10, NULL);
+    // 21 nodes
+
+    // Operations given no head
+    dlinkedlist_add_after(&(f->foos[0].list), &(f->foos[11].list), NULL);
+    dlinkedlist_add_before(&(f->foos[0].list), &(f->foos[12].list), NULL);
+    dlinkedlist_remove(&(f->foos[11].list), NULL);
+    dlinkedlist_remove(&(f->foos[12].list), NULL);
+    s = stats_of(NULL);
+    REQUIRE_EQUAL(s.adds - unknown.adds, 2);
+    REQUIRE_EQUAL(s.removes - unknown.removes, 2);
+
+    // Same operations given their head
+    dlinkedlist_add_after_in(&(f->head), &(f->foos[0].list),
+                             &(f->foos[11].list), NULL);
+    dlinkedlist_add_before_in(&(f->head), &(f->foos[0].list),
+                              &(f->foos[12].list), NULL);
+    dlinkedlist_remove_from(&(f->head), &(f->foos[11].list), NULL);
+    dlinkedlist_remove_from(&(f->head), &(f->foos[12].list), NULL);
+    s = stats_of(NULL);
+    REQUIRE_EQUAL(s.adds - unknown.adds, 2);
+    REQUIRE_EQUAL(s.removes - unknown.removes, 2);
+
+    dlinkedlist_split(&(f->head), &(f->list), &(f->foos[5].list), NULL, NULL);
+    dlinkedlist_splice(&(f->list), &(f->head), NULL, NULL);
+    REQUIRE_EQUAL(dlinkedlist_size(&(f->head)), 21);
+
+    // 21 - 10 odd bars (1, 3, 5, 7, 9, 21, ..., 29)
+    REQUIRE_EQUAL(dlinkedlist_remove_if(&(f->head), is_odd, NULL, &(f->list),
+                                        NULL, NULL), 10);
+    s = stats_of(&(f->list));
+    REQUIRE_EQUAL(s.adds, 10);
+    REQUIRE_EQUAL(s.walks, 0);
+
+    s = stats_of(&(f->head));
+    REQUIRE_EQUAL(s.head, &(f->head));
+    REQUIRE_EQUAL(s.adds, 23);
+    REQUIRE_EQUAL(s.removes, 12);
+    REQUIRE_EQUAL(s.splits, 1);
+    REQUIRE_EQUAL(s.splices, 1);
+    REQUIRE_EQUAL(s.walks, 1);
+    REQUIRE_EQUAL(s.walked, 21);
+    REQUIRE_EQUAL(s.walklengths[dlinkedlist_stats_bucket(21)], 1);
+
+    dlinkedlist_init_head(&(f->list), NULL);
+    REQUIRE_EQUAL(dlinkedlist_cut_count(&(f->head), &(f->list), 1, NULL, NULL),
+                  1);
+    REQUIRE_EQUAL(stats_of(&(f->list)).splits, 0);
+    REQUIRE_EQUAL(stats_of(&(f->head)).splits, 2);
+
+    dlinkedlist_stats_reset();
+    s = stats_of(&(f->head));
+    REQUIRE_EQUAL(s.head, &(f->head));
+    REQUIRE_EQUAL(s.adds, 0);
+    REQUIRE_EQUAL(s.walks, 0);
+}
+
+void dlinkedlist_stats_walks0(struct fixture* f) {
+    struct dlinkedlist_node* node;
+    struct dlinkedlist_node* ahead;
+    struct foo* pos;
+    struct dlinkedlist_stats s;
+    int visited = 0;
+
+    // Empty list
+    dlinkedlist_for_each(&(f->head), node) {visited++;}
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_add_tail(&(f->head), &(f->foos[i].list), NULL);
+    }
+    dlinkedlist_for_each_prev(&(f->head), node) {visited++;}
+    dlinkedlist_for_each_prefetch(&(f->head), node, ahead, 4) {visited++;}
+    dlinkedlist_for_each_entry_prev_prefetch(&(f->head), pos, node, ahead,
+                                             struct foo, list, 4) {
+        visited += pos->bar >= 0;
+    }
+    REQUIRE_EQUAL(visited, 3 * NODE_COUNT);
+
+    // Left early on the 3rd node: recorded when the next traversal starts
+    dlinkedlist_for_each(&(f->head), node) {
+        if (dlinkedlist_entry(node, struct foo, list)->bar == 2) {break;}
+    }
+    s = stats_of(&(f->head));
+    REQUIRE_EQUAL(s.walks, 4);
+    REQUIRE_EQUAL(s.walked, 3 * NODE_COUNT);
+    dlinkedlist_for_each(&(f->head), node) {visited++;}
+
+    s = stats_of(&(f->head));
+    REQUIRE_EQUAL(s.walks, 6);
+    REQUIRE_EQUAL(s.walked, 4 * NODE_COUNT + 3);
+    REQUIRE_EQUAL(s.walklengths[0], 1);
+    REQUIRE_EQUAL(s.walklengths[dlinkedlist_stats_bucket(3)], 1);
+    REQUIRE_EQUAL(s.walklengths[dlinkedlist_stats_bucket(NODE_COUNT)], 4);
+}
+
+static void* worker_run(void* arg) {
+    struct worker* w = (struct worker*) arg;
+    struct fixture* f = w->f;
+    struct dlinkedlist_node* head = &(f->heads[w->thread]);
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_add_tail(head, &(f->own[w->thread][i].list), NULL);
+    }
+    for (int i = 0; i < WALK_COUNT; i++) {
+        REQUIRE_EQUAL(dlinkedlist_size(&(f->head)), NODE_COUNT);
+    }
+    return NULL;
+}
+
+void dlinkedlist_stats_threads0(struct fixture* f) {
+    pthread_t threads[THREAD_COUNT];
+    struct worker workers[THREAD_COUNT];
+    struct dlinkedlist_stats s;
+
+    // Shared read only list, one private list per thread
+    for (int i = 0; i < NODE_COUNT; i++) {
+        dlinkedlist_add_tail(&(f->head), &(f->foos[i].list), NULL);
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        dlinkedlist_init_head(&(f->heads[t]), NULL);
+        workers[t].f = f;
+        workers[t].thread = t;
+        REQUIRE_EQUAL(pthread_create(&(threads[t]), NULL, worker_run,
+                                     &(workers[t])), 0);
+    }
+    // Collecting while threads count
+    for (int i = 0; i < 10; i++) {
+        s = stats_of(&(f->head));
+        REQUIRE(s.walks <= THREAD_COUNT * WALK_COUNT);
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    s = stats_of(&(f->head));
+    REQUIRE_EQUAL(s.adds, NODE_COUNT);
+    REQUIRE_EQUAL(s.walks, THREAD_COUNT * WALK_COUNT);
+    REQUIRE_EQUAL(s.walked, (uint64_t) THREAD_COUNT * WALK_COUNT * NODE_COUNT);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        s = stats_of(&(f->heads[t]));
+        REQUIRE_EQUAL(s.adds, NODE_COUNT);
+        REQUIRE_EQUAL(s.walks, 0);
+    }
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_dlinkedlist_stats() {
+    static struct fixture f;
+    TEST_CASE(dlinkedlist_stats_bucket0, &f)
+    TEST_CASE(dlinkedlist_stats_operations0, &f)
+    TEST_CASE(dlinkedlist_stats_walks0, &f)
+    TEST_CASE(dlinkedlist_stats_threads0, &f)
+    return 1;
+}
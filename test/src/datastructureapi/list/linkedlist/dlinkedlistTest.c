@@ -7,6 +7,8 @@
 
 #include "datastructureapi/list/dlinkedlistTest.h"
 #include "datastructure/list/dlinkedlist.h"
+#include "datastructure/list/dlinkedlist_typed_iterator.h"
+#include "datastructure/list/dlinkedlist_interleave.h"
 #include <time.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -35,6 +37,8 @@ struct foo {
     struct dlinkedlist_node list;
 };
 
+DLINKEDLIST_DEFINE_TYPED_ITERATOR(foo_iterator, struct foo, list)
+
 void* freeNode(struct dlinkedlist_node* n) {
     FREE_NODE(n)
     return NULL;
@@ -377,6 +381,22 @@ void dlinkedlist_split0(struct fixture* f) {
     }
 }
 
+void dlinkedlist_split1(struct fixture* f) {
+    // headSize need not hold head's current size: both are recomputed
+    struct dlinkedlist_node* list = MALLOC_NODE();
+    struct dlinkedlist_node* list2 = MALLOC_NODE();
+    dlinkedlist_init_head(list, NULL);
+    dlinkedlist_init_head(list2, NULL);
+    ADD_NODES(list, 5, NULL)
+    int_least32_t listSize = 0;
+    int_least32_t listSize2 = 0;
+    dlinkedlist_split(list, list2, list->next->next, &listSize, &listSize2);
+    REQUIRE_EQUAL(listSize, 1);
+    REQUIRE_EQUAL(listSize2, 4);
+    dlinkedlist_free(list, &listSize, freeNode);
+    dlinkedlist_free(list2, &listSize2, freeNode);
+}
+
 #define DECALRE_LIST_SIZE_3(listhead) \
     struct foo baz = { \
         .bar = 10, \
@@ -464,6 +484,384 @@ void dlinkedlist_iterator_item_end0(struct fixture* f) {
     REQUIRE(bar = &baz3);
 }
 
+void dlinkedlist_iterator_init0(struct fixture* f) {
+    struct dlinkedlist_node* head;
+    DECALRE_LIST_SIZE_3(head);
+    // List order is: baz, baz3, baz2
+    struct iterator_dlinkedlist storage;
+    struct iterator* it = dlinkedlist_iterator_init(&storage, head, NULL);
+    REQUIRE_EQUAL(it, &(storage._base));
+    void* node = iterator_item_next(it);
+    REQUIRE_EQUAL(node, &(baz3.list));
+    node = iterator_item_next(it);
+    REQUIRE_EQUAL(node, &(baz2.list));
+    REQUIRE_EQUAL(iterator_item_begin(it), head);
+    dlinkedlist_iterator_deinit(it);
+}
+
+void dlinkedlist_iterator_reset0(struct fixture* f) {
+    struct dlinkedlist_node* head;
+    DECALRE_LIST_SIZE_3(head);
+    struct iterator_dlinkedlist storage;
+    struct iterator* it = dlinkedlist_iterator_init(&storage, head, NULL);
+    iterator_item_next(it);
+    iterator_item_next(it);
+    REQUIRE_EQUAL(iterator_item_current(it), &(baz2.list));
+
+    // Rewind
+    dlinkedlist_iterator_reset(it, NULL);
+    REQUIRE_EQUAL(iterator_item_current(it), head);
+    REQUIRE_EQUAL(iterator_item_next(it), &(baz3.list));
+
+    // Rebind
+    dlinkedlist_iterator_reset(it, f->h);
+    REQUIRE_EQUAL(iterator_item_current(it), f->h);
+    REQUIRE_EQUAL(iterator_item_begin(it), f->h);
+    dlinkedlist_iterator_deinit(it);
+}
+
+void dlinkedlist_typed_iterator0(struct fixture* f) {
+    struct dlinkedlist_node* head;
+    DECALRE_LIST_SIZE_3(head);
+    // List order is: baz, baz3, baz2
+    struct foo_iterator it;
+    foo_iterator_init(&it, head);
+    REQUIRE(foo_iterator_current(&it) == NULL);
+    REQUIRE(foo_iterator_next(&it) == &baz3);
+    REQUIRE(foo_iterator_next(&it) == &baz2);
+    REQUIRE(foo_iterator_next(&it) == NULL);
+    // Stays past the last entry
+    REQUIRE(foo_iterator_next(&it) == NULL);
+    REQUIRE(foo_iterator_current(&it) == NULL);
+    REQUIRE(foo_iterator_prev(&it) == &baz2);
+    REQUIRE(foo_iterator_prev(&it) == &baz3);
+    REQUIRE(foo_iterator_prev(&it) == NULL);
+    // Stays before the first entry
+    REQUIRE(foo_iterator_prev(&it) == NULL);
+    REQUIRE(foo_iterator_next(&it) == &baz3);
+    // begin/end do not move the iterator
+    REQUIRE(foo_iterator_begin(&it) == &baz3);
+    REQUIRE(foo_iterator_end(&it) == &baz2);
+    REQUIRE(foo_iterator_current(&it) == &baz3);
+
+    // Empty list
+    foo_iterator_init(&it, f->h);
+    REQUIRE(foo_iterator_begin(&it) == NULL);
+    REQUIRE(foo_iterator_end(&it) == NULL);
+    REQUIRE(foo_iterator_next(&it) == NULL);
+    REQUIRE(foo_iterator_prev(&it) == NULL);
+}
+
+void dlinkedlist_for_each_prefetch0(struct fixture* f) {
+    int max = 6;
+    struct foo foos[6];
+    for (int i = 0; i < max; i++) {
+        foos[i].bar = i;
+        dlinkedlist_add_tail(f->h, &(foos[i].list), &(f->size));
+    }
+    unsigned int distances[4] = {0, 1, 4, 100};
+    for (int d = 0; d < 4; d++) {
+        struct dlinkedlist_node* n;
+        struct dlinkedlist_node* ahead;
+        struct foo* pos;
+        int i = 0;
+        dlinkedlist_for_each_prefetch(f->h, n, ahead, distances[d]) {
+            REQUIRE_EQUAL(n, &(foos[i].list));
+            if (distances[d] == 0) {
+                // Nothing prefetched
+                REQUIRE_EQUAL(ahead, f->h);
+            }
+            i++;
+        }
+        REQUIRE_EQUAL(i, max);
+        dlinkedlist_for_each_prev_prefetch(f->h, n, ahead, distances[d]) {
+            i--;
+            REQUIRE_EQUAL(n, &(foos[i].list));
+        }
+        REQUIRE_EQUAL(i, 0);
+        dlinkedlist_for_each_entry_prefetch(f->h, pos, n, ahead,
+                                            struct foo, list, distances[d]) {
+            REQUIRE_EQUAL(pos->bar, i);
+            i++;
+        }
+        REQUIRE_EQUAL(i, max);
+        dlinkedlist_for_each_entry_prev_prefetch(f->h, pos, n, ahead,
+                                            struct foo, list, distances[d]) {
+            i--;
+            REQUIRE_EQUAL(pos->bar, i);
+        }
+        REQUIRE_EQUAL(i, 0);
+    }
+    // Nodes live on the stack
+    dlinkedlist_init_head(f->h, &(f->size));
+
+    // Empty list
+    struct dlinkedlist_node* n;
+    struct dlinkedlist_node* ahead;
+    dlinkedlist_for_each_prefetch(f->h, n, ahead, 2) {
+        REQUIRE(0);
+    }
+}
+
+#define INTERLEAVE_LISTS 5
+#define INTERLEAVE_NODES 12
+
+struct interleave_visits {
+    int count;
+    int last[INTERLEAVE_LISTS];     // Last bar visited per list
+};
+
+static void dlinkedlist_interleave_visit(struct dlinkedlist_node* node,
+                                         size_t list, void* ctx) {
+    struct interleave_visits* visits = (struct interleave_visits*) ctx;
+    struct foo* e = dlinkedlist_entry(node, struct foo, list);
+    // Nodes of a list are visited in order
+    REQUIRE_EQUAL(e->bar, visits->last[list] + 1);
+    visits->last[list] = e->bar;
+    visits->count++;
+}
+
+void dlinkedlist_interleave_for_each0(struct fixture* f) {
+    struct dlinkedlist_node heads[INTERLEAVE_LISTS];
+    struct dlinkedlist_node* headptrs[INTERLEAVE_LISTS];
+    struct foo foos[INTERLEAVE_NODES];
+    // List i holds i nodes (list 0 is empty)
+    int n = 0;
+    for (int i = 0; i < INTERLEAVE_LISTS; i++) {
+        dlinkedlist_init_head(&(heads[i]), NULL);
+        headptrs[i] = &(heads[i]);
+        for (int j = 0; j < i && n < INTERLEAVE_NODES; j++) {
+            foos[n].bar = j;
+            dlinkedlist_add_tail(&(heads[i]), &(foos[n].list), NULL);
+            n++;
+        }
+    }
+    unsigned int widths[4] = {0, 1, 2, 100};
+    for (int w = 0; w < 4; w++) {
+        struct interleave_visits visits;
+        visits.count = 0;
+        for (int i = 0; i < INTERLEAVE_LISTS; i++) {visits.last[i] = -1;}
+        dlinkedlist_interleave_for_each(headptrs, INTERLEAVE_LISTS, widths[w],
+                                        offsetof(struct foo, list),
+                                        dlinkedlist_interleave_visit, &visits);
+        REQUIRE_EQUAL(visits.count, n);
+        for (int i = 0; i < INTERLEAVE_LISTS; i++) {
+            REQUIRE_EQUAL(visits.last[i], i - 1);
+        }
+    }
+}
+
+#define BULK_NODES 10
+
+void dlinkedlist_add_bulk0(struct fixture* f) {
+    struct foo foos[BULK_NODES];
+    struct dlinkedlist_node* nodes[BULK_NODES];
+    struct dlinkedlist_node* h = f->h;
+    int_least32_t* size = &(f->size);
+    for (int i = 0; i < BULK_NODES; i++) {
+        foos[i].bar = i;
+        nodes[i] = &(foos[i].list);
+    }
+    dlinkedlist_add_tail_bulk(h, nodes, 0, size);
+    REQUIRE(dlinkedlist_empty(h));
+    dlinkedlist_add_tail_bulk(h, nodes + 4, 3, size);
+    dlinkedlist_add_head_bulk(h, nodes, 4, size);
+    dlinkedlist_add_tail_bulk(h, nodes + 7, 3, size);
+    REQUIRE_EQUAL(*size, BULK_NODES);
+    REQUIRE_EQUAL(dlinkedlist_size(h), BULK_NODES);
+    struct dlinkedlist_node* n;
+    int i = 0;
+    dlinkedlist_for_each(h, n) {
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, i);
+        i++;
+    }
+    dlinkedlist_for_each_prev(h, n) {
+        i--;
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, i);
+    }
+    // Nodes live on the stack: fixture_teardown must not free them
+    dlinkedlist_init_head(h, size);
+}
+
+static int dlinkedlist_is_odd_or_big(const struct dlinkedlist_node* n, void* ctx) {
+    int bar = dlinkedlist_entry(n, const struct foo, list)->bar;
+    return bar % 2 || bar >= *(int*) ctx;
+}
+
+void dlinkedlist_remove_if0(struct fixture* f) {
+    struct foo foos[BULK_NODES];
+    struct dlinkedlist_node h;
+    struct dlinkedlist_node removed;
+    int_least32_t size = 0;
+    int_least32_t removedSize = 0;
+    int big = 6;
+    dlinkedlist_init_head(&h, &size);
+    dlinkedlist_init_head(&removed, &removedSize);
+    for (int i = 0; i < BULK_NODES; i++) {
+        foos[i].bar = i;
+        dlinkedlist_add_tail(&h, &(foos[i].list), &size);
+    }
+    // Matches 1 3 5 6 7 8 9
+    REQUIRE_EQUAL(dlinkedlist_remove_if(&h, dlinkedlist_is_odd_or_big, &big,
+                                        &removed, &size, &removedSize), 7);
+    REQUIRE_EQUAL(size, 3);
+    REQUIRE_EQUAL(removedSize, 7);
+    REQUIRE_EQUAL(dlinkedlist_size(&h), 3);
+    REQUIRE_EQUAL(dlinkedlist_size(&removed), 7);
+    int kept[3] = {0, 2, 4};
+    int moved[7] = {1, 3, 5, 6, 7, 8, 9};
+    struct dlinkedlist_node* n;
+    int i = 0;
+    dlinkedlist_for_each(&h, n) {
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, kept[i]);
+        i++;
+    }
+    i = 0;
+    dlinkedlist_for_each(&removed, n) {
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, moved[i]);
+        i++;
+    }
+    i = 7;
+    dlinkedlist_for_each_prev(&removed, n) {
+        i--;
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, moved[i]);
+    }
+
+    // Everything matches
+    big = 0;
+    REQUIRE_EQUAL(dlinkedlist_remove_if(&h, dlinkedlist_is_odd_or_big, &big,
+                                        &removed, &size, &removedSize), 3);
+    REQUIRE(dlinkedlist_empty(&h));
+    REQUIRE_EQUAL(dlinkedlist_size(&removed), BULK_NODES);
+    REQUIRE_EQUAL(dlinkedlist_remove_if(&h, dlinkedlist_is_odd_or_big, &big,
+                                        &removed, &size, &removedSize), 0);
+}
+
+// Checks list's bars, both ways
+static void require_bars(struct dlinkedlist_node* h, const int* bars, int count) {
+    struct dlinkedlist_node* n;
+    int i = 0;
+    dlinkedlist_for_each(h, n) {
+        REQUIRE(i < count);
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, bars[i]);
+        i++;
+    }
+    REQUIRE_EQUAL(i, count);
+    dlinkedlist_for_each_prev(h, n) {
+        i--;
+        REQUIRE_EQUAL(dlinkedlist_entry(n, struct foo, list)->bar, bars[i]);
+    }
+}
+
+void dlinkedlist_splice_range0(struct fixture* f) {
+    struct foo foos[BULK_NODES];
+    struct dlinkedlist_node h;
+    struct dlinkedlist_node h2;
+    int_least32_t size = 0;
+    int_least32_t size2 = 0;
+    dlinkedlist_init_head(&h, &size);
+    dlinkedlist_init_head(&h2, &size2);
+    for (int i = 0; i < BULK_NODES; i++) {
+        foos[i].bar = i;
+        dlinkedlist_add_tail(&h, &(foos[i].list), &size);
+    }
+    // Range to another list, count unknown
+    dlinkedlist_splice_range(&(foos[2].list), &(foos[4].list), &h2, 0, &size, &size2);
+    int bars0[7] = {0, 1, 5, 6, 7, 8, 9};
+    int bars1[3] = {2, 3, 4};
+    require_bars(&h, bars0, 7);
+    require_bars(&h2, bars1, 3);
+    REQUIRE_EQUAL(size, 7);
+    REQUIRE_EQUAL(size2, 3);
+
+    // Range within the same list, count known
+    dlinkedlist_splice_range(&(foos[0].list), &(foos[1].list), &(foos[9].list), 2, NULL, NULL);
+    int bars2[7] = {5, 6, 7, 8, 9, 0, 1};
+    require_bars(&h, bars2, 7);
+
+    // After its own predecessor: nothing moves
+    dlinkedlist_splice_range(&(foos[6].list), &(foos[7].list), &(foos[5].list), 2, &size, &size);
+    require_bars(&h, bars2, 7);
+    REQUIRE_EQUAL(size, 7);
+
+    // Back in front of another list's nodes
+    dlinkedlist_splice_range(&(foos[0].list), &(foos[1].list), &h2, 2, &size, &size2);
+    int bars3[5] = {0, 1, 2, 3, 4};
+    require_bars(&h2, bars3, 5);
+    REQUIRE_EQUAL(size, 5);
+    REQUIRE_EQUAL(size2, 5);
+}
+
+void dlinkedlist_cut0(struct fixture* f) {
+    struct foo foos[BULK_NODES];
+    struct dlinkedlist_node h;
+    struct dlinkedlist_node h2;
+    int_least32_t size = 0;
+    int_least32_t size2 = 0;
+    dlinkedlist_init_head(&h, &size);
+    dlinkedlist_init_head(&h2, &size2);
+    for (int i = 0; i < BULK_NODES; i++) {
+        foos[i].bar = i;
+        dlinkedlist_add_tail(&h, &(foos[i].list), &size);
+    }
+    dlinkedlist_cut_position(&h, &h2, &h, &size, &size2);
+    REQUIRE(dlinkedlist_empty(&h2));
+    dlinkedlist_cut_position(&h, &h2, &(foos[2].list), &size, &size2);
+    int bars0[3] = {0, 1, 2};
+    require_bars(&h2, bars0, 3);
+    REQUIRE_EQUAL(size, 7);
+    REQUIRE_EQUAL(size2, 3);
+
+    // Destination must be empty
+    REQUIRE_EQUAL(dlinkedlist_cut_count(&h, &h2, 2, &size, &size2), 0);
+    dlinkedlist_init_head(&h2, &size2);
+    REQUIRE_EQUAL(dlinkedlist_cut_count(&h, &h2, 2, &size, &size2), 2);
+    int bars1[2] = {3, 4};
+    require_bars(&h2, bars1, 2);
+    dlinkedlist_init_head(&h2, &size2);
+    REQUIRE_EQUAL(dlinkedlist_cut_count(&h, &h2, 100, &size, &size2), 5);
+    REQUIRE(dlinkedlist_empty(&h));
+    REQUIRE_EQUAL(size, 0);
+    REQUIRE_EQUAL(size2, 5);
+    dlinkedlist_init_head(&h, &size);
+    REQUIRE_EQUAL(dlinkedlist_cut_count(&h2, &h, 0, &size2, &size), 0);
+}
+
+void dlinkedlist_rotate_reverse0(struct fixture* f) {
+    struct foo foos[4];
+    struct dlinkedlist_node h;
+    dlinkedlist_init_head(&h, NULL);
+    dlinkedlist_rotate_left(&h);
+    dlinkedlist_reverse(&h);
+    REQUIRE(dlinkedlist_empty(&h));
+    foos[0].bar = 0;
+    dlinkedlist_add_tail(&h, &(foos[0].list), NULL);
+    dlinkedlist_rotate_left(&h);
+    dlinkedlist_reverse(&h);
+    int bars[1] = {0};
+    require_bars(&h, bars, 1);
+    REQUIRE_EQUAL(h.next, &(foos[0].list));
+    REQUIRE_EQUAL(h.prev, &(foos[0].list));
+    REQUIRE_EQUAL(foos[0].list.next, &h);
+    REQUIRE_EQUAL(foos[0].list.prev, &h);
+    dlinkedlist_init_head(&h, NULL);
+    for (int i = 0; i < 4; i++) {
+        foos[i].bar = i;
+        dlinkedlist_add_tail(&h, &(foos[i].list), NULL);
+    }
+    dlinkedlist_rotate_left(&h);
+    int bars0[4] = {1, 2, 3, 0};
+    require_bars(&h, bars0, 4);
+    dlinkedlist_rotate_to_front(&(foos[3].list), &h);
+    int bars1[4] = {3, 0, 1, 2};
+    require_bars(&h, bars1, 4);
+    dlinkedlist_rotate_to_front(&(foos[3].list), &h);
+    require_bars(&h, bars1, 4);
+    dlinkedlist_reverse(&h);
+    int bars2[4] = {2, 1, 0, 3};
+    require_bars(&h, bars2, 4);
+}
+
 #define TEST_CASE(nameTest, fixture) \
     fixture_setup(fixture); \
     nameTest(fixture); \
@@ -485,6 +883,7 @@ int run_unit_tests_dlinkedlist() {
     TEST_CASE(dlinkedlist_splice0,&f)
     TEST_CASE(dlinkedlist_singular0,&f)
     TEST_CASE(dlinkedlist_split0,&f)
+    TEST_CASE(dlinkedlist_split1,&f)
     TEST_CASE(dlinkedlist_iterator_get0,&f)
     TEST_CASE(dlinkedlist_iterator_free0,&f)
     TEST_CASE(dlinkedlist_iterator_item_prev0,&f)
@@ -492,5 +891,15 @@ int run_unit_tests_dlinkedlist() {
     TEST_CASE(dlinkedlist_iterator_item_current0,&f)
     TEST_CASE(dlinkedlist_iterator_item_begin0,&f)
     TEST_CASE(dlinkedlist_iterator_item_end0,&f)
+    TEST_CASE(dlinkedlist_iterator_init0,&f)
+    TEST_CASE(dlinkedlist_iterator_reset0,&f)
+    TEST_CASE(dlinkedlist_typed_iterator0,&f)
+    TEST_CASE(dlinkedlist_for_each_prefetch0,&f)
+    TEST_CASE(dlinkedlist_interleave_for_each0,&f)
+    TEST_CASE(dlinkedlist_add_bulk0,&f)
+    TEST_CASE(dlinkedlist_remove_if0,&f)
+    TEST_CASE(dlinkedlist_splice_range0,&f)
+    TEST_CASE(dlinkedlist_cut0,&f)
+    TEST_CASE(dlinkedlist_rotate_reverse0,&f)
     return 1;
 }
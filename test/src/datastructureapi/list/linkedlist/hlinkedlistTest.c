@@ -0,0 +1,132 @@
+//
+//  hlinkedlistTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/hlinkedlistTest.h"
+#include "datastructure/list/hlinkedlist.h"
+#include <stdlib.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT 6
+
+struct item {
+    int value;
+    struct hlinkedlist_node list;
+};
+
+struct fixture {
+    struct item items[ITEM_COUNT];
+    struct hlinkedlist_head h;
+    struct hlinkedlist_head h2;
+    _INT_LEAST_32_T size;
+    _INT_LEAST_32_T size2;
+};
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].value = i;
+        hlinkedlist_init_node(&(f->items[i].list));
+    }
+    hlinkedlist_init_head(&(f->h), &(f->size));
+    hlinkedlist_init_head(&(f->h2), &(f->size2));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    (void) f;
+}
+
+// Checks list holds values[0..count-1] and back links are consistent
+static void require_values(struct hlinkedlist_head* h,
+                           const int* values,
+                           int count) {
+    struct hlinkedlist_node* node;
+    struct hlinkedlist_node** pprev = &(h->first);
+    int i = 0;
+    REQUIRE_EQUAL(hlinkedlist_size(h), count);
+    hlinkedlist_for_each(h, node) {
+        REQUIRE(node->pprev == pprev);
+        REQUIRE_EQUAL(hlinkedlist_entry(node, struct item, list)->value,
+                      values[i]);
+        pprev = &(node->next);
+        i++;
+    }
+    REQUIRE_EQUAL(i, count);
+}
+
+void hlinkedlist_init0(struct fixture* f) {
+    REQUIRE_EQUAL(sizeof(struct hlinkedlist_head), sizeof(void*));
+    REQUIRE(hlinkedlist_empty(&(f->h)));
+    REQUIRE_EQUAL(f->size, 0);
+    REQUIRE(hlinkedlist_unhashed(&(f->items[0].list)));
+}
+
+void hlinkedlist_add_remove0(struct fixture* f) {
+    struct item* it = f->items;
+    hlinkedlist_add_head(&(f->h), &(it[2].list), &(f->size));
+    hlinkedlist_add_head(&(f->h), &(it[0].list), &(f->size));
+    hlinkedlist_add_after(&(it[0].list), &(it[1].list), &(f->size));
+    hlinkedlist_add_after(&(it[2].list), &(it[4].list), &(f->size));
+    hlinkedlist_add_before(&(it[4].list), &(it[3].list), &(f->size));
+    hlinkedlist_add_before(&(it[0].list), &(it[5].list), &(f->size));
+    int v0[] = {5, 0, 1, 2, 3, 4};
+    require_values(&(f->h), v0, 6);
+    REQUIRE_EQUAL(f->size, 6);
+    REQUIRE(!hlinkedlist_unhashed(&(it[5].list)));
+
+    hlinkedlist_remove(&(it[5].list), &(f->size));
+    hlinkedlist_remove(&(it[4].list), &(f->size));
+    hlinkedlist_remove(&(it[2].list), &(f->size));
+    int v1[] = {0, 1, 3};
+    require_values(&(f->h), v1, 3);
+    REQUIRE_EQUAL(f->size, 3);
+    REQUIRE(hlinkedlist_unhashed(&(it[2].list)));
+
+    // Removal while iterating
+    struct hlinkedlist_node* node;
+    struct hlinkedlist_node* next;
+    hlinkedlist_for_each_safe(&(f->h), node, next) {
+        hlinkedlist_remove(node, &(f->size));
+    }
+    REQUIRE(hlinkedlist_empty(&(f->h)));
+    REQUIRE_EQUAL(f->size, 0);
+}
+
+void hlinkedlist_splice0(struct fixture* f) {
+    struct item* it = f->items;
+    hlinkedlist_add_head(&(f->h2), &(it[1].list), &(f->size2));
+    hlinkedlist_add_head(&(f->h2), &(it[0].list), &(f->size2));
+    hlinkedlist_splice(&(f->h2), &(f->h), &(f->size2), &(f->size));
+    int v0[] = {0, 1};
+    require_values(&(f->h), v0, 2);
+    REQUIRE(hlinkedlist_empty(&(f->h2)));
+    REQUIRE_EQUAL(f->size, 2);
+    REQUIRE_EQUAL(f->size2, 0);
+
+    hlinkedlist_add_head(&(f->h2), &(it[4].list), &(f->size2));
+    hlinkedlist_add_head(&(f->h2), &(it[3].list), &(f->size2));
+    hlinkedlist_splice(&(f->h2), &(f->h), &(f->size2), &(f->size));
+    int v1[] = {3, 4, 0, 1};
+    require_values(&(f->h), v1, 4);
+    REQUIRE_EQUAL(f->size, 4);
+
+    hlinkedlist_splice(&(f->h2), &(f->h), &(f->size2), &(f->size));
+    require_values(&(f->h), v1, 4);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_hlinkedlist() {
+    struct fixture f;
+    TEST_CASE(hlinkedlist_init0, &f)
+    TEST_CASE(hlinkedlist_add_remove0, &f)
+    TEST_CASE(hlinkedlist_splice0, &f)
+    return 1;
+}
@@ -0,0 +1,187 @@
+//
+//  ilinkedlistTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/ilinkedlistTest.h"
+#include "datastructure/list/ilinkedlist.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT 10
+
+struct item {
+    int value;
+    struct ilinkedlist_node list;
+};
+
+struct fixture {
+    struct item items[ITEM_COUNT];
+    struct ilinkedlist_arena arena;
+    struct ilinkedlist_head h;
+    struct ilinkedlist_head h2;
+    _INT_LEAST_32_T size;
+    _INT_LEAST_32_T size2;
+};
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {f->items[i].value = i;}
+    ilinkedlist_arena_init_type(&(f->arena), f->items, struct item, list,
+                                ITEM_COUNT);
+    ilinkedlist_init_head(&(f->h), &(f->size));
+    ilinkedlist_init_head(&(f->h2), &(f->size2));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    (void) f;
+}
+
+// Checks list holds values[0..count-1] both ways
+static void require_values(struct ilinkedlist_arena* arena,
+                           struct ilinkedlist_head* h,
+                           const int* values,
+                           int count) {
+    uint32_t index;
+    int i = 0;
+    REQUIRE_EQUAL(ilinkedlist_size(arena, h), count);
+    ilinkedlist_for_each(arena, h, index) {
+        REQUIRE_EQUAL(ilinkedlist_entry(arena, index, struct item)->value,
+                      values[i]);
+        i++;
+    }
+    REQUIRE_EQUAL(i, count);
+    ilinkedlist_for_each_prev(arena, h, index) {
+        i--;
+        REQUIRE_EQUAL(ilinkedlist_entry(arena, index, struct item)->value,
+                      values[i]);
+    }
+    REQUIRE_EQUAL(i, 0);
+}
+
+void ilinkedlist_init0(struct fixture* f) {
+    REQUIRE_EQUAL(sizeof(struct ilinkedlist_node), 8);
+    REQUIRE(ilinkedlist_empty(&(f->h)));
+    REQUIRE_EQUAL(f->size, 0);
+    REQUIRE_EQUAL(ilinkedlist_size(&(f->arena), &(f->h)), 0);
+    REQUIRE_EQUAL(ilinkedlist_index(&(f->arena), &(f->items[3])), 3);
+    REQUIRE(ilinkedlist_entry(&(f->arena), 3, struct item) == &(f->items[3]));
+    REQUIRE(ilinkedlist_node(&(f->arena), 3) == &(f->items[3].list));
+}
+
+void ilinkedlist_add_remove0(struct fixture* f) {
+    struct ilinkedlist_arena* a = &(f->arena);
+    ilinkedlist_add_tail(a, &(f->h), 2, &(f->size));
+    ilinkedlist_add_head(a, &(f->h), 0, &(f->size));
+    ilinkedlist_add_after(a, &(f->h), 0, 1, &(f->size));
+    ilinkedlist_add_tail(a, &(f->h), 4, &(f->size));
+    ilinkedlist_add_before(a, &(f->h), 4, 3, &(f->size));
+    int v0[] = {0, 1, 2, 3, 4};
+    require_values(a, &(f->h), v0, 5);
+    REQUIRE_EQUAL(f->size, 5);
+
+    ilinkedlist_remove(a, &(f->h), 0, &(f->size));
+    ilinkedlist_remove(a, &(f->h), 4, &(f->size));
+    ilinkedlist_remove(a, &(f->h), 2, &(f->size));
+    int v1[] = {1, 3};
+    require_values(a, &(f->h), v1, 2);
+    REQUIRE_EQUAL(f->size, 2);
+
+    ilinkedlist_remove(a, &(f->h), 1, &(f->size));
+    ilinkedlist_remove(a, &(f->h), 3, &(f->size));
+    REQUIRE(ilinkedlist_empty(&(f->h)));
+    REQUIRE_EQUAL(f->h.last, ILINKEDLIST_NIL);
+    REQUIRE_EQUAL(f->size, 0);
+}
+
+void ilinkedlist_splice0(struct fixture* f) {
+    struct ilinkedlist_arena* a = &(f->arena);
+    // Into an empty list
+    ilinkedlist_add_tail(a, &(f->h2), 5, &(f->size2));
+    ilinkedlist_add_tail(a, &(f->h2), 6, &(f->size2));
+    ilinkedlist_splice(a, &(f->h2), &(f->h), &(f->size2), &(f->size));
+    REQUIRE(ilinkedlist_empty(&(f->h2)));
+    REQUIRE_EQUAL(f->size2, 0);
+    int v0[] = {5, 6};
+    require_values(a, &(f->h), v0, 2);
+    REQUIRE_EQUAL(f->size, 2);
+
+    // Before a non empty list's first node
+    ilinkedlist_add_tail(a, &(f->h2), 1, &(f->size2));
+    ilinkedlist_add_tail(a, &(f->h2), 2, &(f->size2));
+    ilinkedlist_splice(a, &(f->h2), &(f->h), &(f->size2), &(f->size));
+    int v1[] = {1, 2, 5, 6};
+    require_values(a, &(f->h), v1, 4);
+    REQUIRE_EQUAL(f->size, 4);
+
+    // Empty list: no op
+    ilinkedlist_splice(a, &(f->h2), &(f->h), &(f->size2), &(f->size));
+    require_values(a, &(f->h), v1, 4);
+}
+
+void ilinkedlist_split0(struct fixture* f) {
+    struct ilinkedlist_arena* a = &(f->arena);
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        ilinkedlist_add_tail(a, &(f->h), i, &(f->size));
+    }
+    ilinkedlist_split(a, &(f->h), &(f->h2), 6, &(f->size), &(f->size2));
+    int v0[] = {0, 1, 2, 3, 4, 5};
+    int v1[] = {6, 7, 8, 9};
+    require_values(a, &(f->h), v0, 6);
+    require_values(a, &(f->h2), v1, 4);
+    REQUIRE_EQUAL(f->size, 6);
+    REQUIRE_EQUAL(f->size2, 4);
+
+    // Non empty destination: no op
+    ilinkedlist_split(a, &(f->h), &(f->h2), 3, &(f->size), &(f->size2));
+    require_values(a, &(f->h), v0, 6);
+
+    // Split at first node moves everything
+    ilinkedlist_splice(a, &(f->h2), &(f->h), &(f->size2), &(f->size));
+    ilinkedlist_split(a, &(f->h), &(f->h2), 6, &(f->size), &(f->size2));
+    int v2[] = {6, 7, 8, 9, 0, 1, 2, 3, 4, 5};
+    REQUIRE(ilinkedlist_empty(&(f->h)));
+    REQUIRE_EQUAL(f->size, 0);
+    require_values(a, &(f->h2), v2, ITEM_COUNT);
+    REQUIRE_EQUAL(f->size2, ITEM_COUNT);
+}
+
+void ilinkedlist_arena0(struct fixture* f) {
+    struct ilinkedlist_arena* a = &(f->arena);
+    uint32_t index;
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        index = ilinkedlist_arena_alloc(a);
+        REQUIRE_EQUAL(index, i);
+        ilinkedlist_add_tail(a, &(f->h), index, &(f->size));
+    }
+    REQUIRE_EQUAL(ilinkedlist_arena_alloc(a), ILINKEDLIST_NIL);
+
+    // Released containers are handed out again, last released first
+    ilinkedlist_remove(a, &(f->h), 2, &(f->size));
+    ilinkedlist_arena_release(a, 2);
+    ilinkedlist_remove(a, &(f->h), 7, &(f->size));
+    ilinkedlist_arena_release(a, 7);
+    REQUIRE_EQUAL(ilinkedlist_arena_alloc(a), 7);
+    REQUIRE_EQUAL(ilinkedlist_arena_alloc(a), 2);
+    REQUIRE_EQUAL(ilinkedlist_arena_alloc(a), ILINKEDLIST_NIL);
+    REQUIRE_EQUAL(f->size, ITEM_COUNT - 2);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_ilinkedlist() {
+    struct fixture f;
+    TEST_CASE(ilinkedlist_init0, &f)
+    TEST_CASE(ilinkedlist_add_remove0, &f)
+    TEST_CASE(ilinkedlist_splice0, &f)
+    TEST_CASE(ilinkedlist_split0, &f)
+    TEST_CASE(ilinkedlist_arena0, &f)
+    return 1;
+}
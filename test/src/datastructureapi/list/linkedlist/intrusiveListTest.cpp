@@ -0,0 +1,292 @@
+//
+//  intrusiveListTest.cpp
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+extern "C" {
+#include "datastructureapi/list/intrusiveListTest.h"
+}
+#include "datastructure/list/intrusive_list.hpp"
+#include <algorithm>
+#include <cassert>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ITEM_COUNT 8
+
+/** Testing data structure */
+struct item {
+    int key;
+    int seq;
+    struct dlinkedlist_node list;
+
+    bool operator<(const item& other) const { return key < other.key; }
+};
+
+typedef datastructure::intrusive_list<item, &item::list> item_list;
+
+struct greater_key {
+    bool operator()(const item& a, const item& b) const {
+        return a.key > b.key;
+    }
+};
+
+struct key_is {
+    int key;
+    bool operator()(const item& i) const { return i.key == key; }
+};
+
+struct fixture {
+    item items[ITEM_COUNT];
+};
+
+static void fixture_setup(fixture* f) {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].key = i;
+        f->items[i].seq = i;
+    }
+}
+
+static void fixture_teardown(fixture* f) {
+    (void) f;
+}
+
+/**
+ *  Checks list's keys, forwards then backwards
+ */
+static void require_keys(const item_list& list, const int* keys, int count) {
+    int i = 0;
+    for (item_list::const_iterator it = list.begin(); it != list.end(); ++it) {
+        REQUIRE(i < count);
+        REQUIRE_EQUAL(it->key, keys[i]);
+        i++;
+    }
+    REQUIRE_EQUAL(i, count);
+    for (item_list::const_reverse_iterator it = list.rbegin();
+         it != list.rend(); ++it) {
+        i--;
+        REQUIRE_EQUAL(it->key, keys[i]);
+    }
+    REQUIRE_EQUAL(i, 0);
+    REQUIRE_EQUAL(list.size(), (size_t) count);
+    REQUIRE_EQUAL(list.empty(), (count == 0));
+}
+
+static void link_items(fixture* f, item_list& list, int first, int last) {
+    for (int i = first; i < last; i++) {
+        list.push_back(f->items[i]);
+    }
+}
+
+void intrusive_list_push_pop0(fixture* f) {
+    item_list list;
+    require_keys(list, NULL, 0);
+    list.push_back(f->items[1]);
+    list.push_front(f->items[0]);
+    list.push_back(f->items[2]);
+    int keys0[] = {0, 1, 2};
+    require_keys(list, keys0, 3);
+    REQUIRE_EQUAL(&(list.front()), &(f->items[0]));
+    REQUIRE_EQUAL(&(list.back()), &(f->items[2]));
+    list.pop_front();
+    list.pop_back();
+    int keys1[] = {1};
+    require_keys(list, keys1, 1);
+    list.clear();
+    require_keys(list, NULL, 0);
+
+    // The head interoperates with the C API
+    dlinkedlist_add_tail(list.head(), &(f->items[3].list), NULL);
+    REQUIRE_EQUAL(&(list.front()), &(f->items[3]));
+}
+
+void intrusive_list_insert_erase0(fixture* f) {
+    item_list list;
+    link_items(f, list, 0, 4);
+    item_list::iterator it = list.erase(item_list::iterator_to(f->items[1]));
+    REQUIRE_EQUAL(&(*it), &(f->items[2]));
+    it = list.insert(it, f->items[5]);
+    REQUIRE_EQUAL(&(*it), &(f->items[5]));
+    int keys0[] = {0, 5, 2, 3};
+    require_keys(list, keys0, 4);
+
+    // Range erase
+    it = list.erase(item_list::iterator_to(f->items[5]),
+                    item_list::iterator_to(f->items[3]));
+    REQUIRE_EQUAL(&(*it), &(f->items[3]));
+    int keys1[] = {0, 3};
+    require_keys(list, keys1, 2);
+    it = list.erase(list.begin(), list.begin());
+    require_keys(list, keys1, 2);
+    list.erase(list.begin(), list.end());
+    require_keys(list, NULL, 0);
+}
+
+void intrusive_list_splice0(fixture* f) {
+    item_list a, b;
+    link_items(f, a, 0, 4);
+    link_items(f, b, 4, 8);
+
+    // Range
+    a.splice(item_list::iterator_to(f->items[1]), b,
+             item_list::iterator_to(f->items[5]),
+             item_list::iterator_to(f->items[7]));
+    int keys0[] = {0, 5, 6, 1, 2, 3};
+    int keys1[] = {4, 7};
+    require_keys(a, keys0, 6);
+    require_keys(b, keys1, 2);
+    a.splice(a.begin(), b, b.begin(), b.begin());
+    a.splice(item_list::iterator_to(f->items[1]), a,
+             item_list::iterator_to(f->items[5]),
+             item_list::iterator_to(f->items[1]));
+    require_keys(a, keys0, 6);
+
+    // One item
+    a.splice(a.end(), b, item_list::iterator_to(f->items[4]));
+    int keys2[] = {0, 5, 6, 1, 2, 3, 4};
+    require_keys(a, keys2, 7);
+    a.splice(item_list::iterator_to(f->items[1]), a,
+             item_list::iterator_to(f->items[6]));
+    a.splice(item_list::iterator_to(f->items[6]), a,
+             item_list::iterator_to(f->items[6]));
+    require_keys(a, keys2, 7);
+    a.splice(a.begin(), a, item_list::iterator_to(f->items[4]));
+    int keys3[] = {4, 0, 5, 6, 1, 2, 3};
+    require_keys(a, keys3, 7);
+
+    // Whole list
+    a.splice(item_list::iterator_to(f->items[0]), b);
+    int keys4[] = {4, 7, 0, 5, 6, 1, 2, 3};
+    require_keys(a, keys4, 8);
+    require_keys(b, NULL, 0);
+    a.splice(a.begin(), b);
+    require_keys(a, keys4, 8);
+}
+
+void intrusive_list_swap_reverse0(fixture* f) {
+    item_list a, b;
+    link_items(f, a, 0, 3);
+    a.swap(b);
+    int keys0[] = {0, 1, 2};
+    require_keys(a, NULL, 0);
+    require_keys(b, keys0, 3);
+    link_items(f, a, 3, 5);
+    a.swap(b);
+    int keys1[] = {3, 4};
+    require_keys(a, keys0, 3);
+    require_keys(b, keys1, 2);
+    a.reverse();
+    int keys2[] = {2, 1, 0};
+    require_keys(a, keys2, 3);
+    int sum = 0;
+    for (item_list::reverse_iterator it = a.rbegin(); it != a.rend(); ++it) {
+        sum = sum * 10 + it->key;
+    }
+    REQUIRE_EQUAL(sum, 12);
+}
+
+void intrusive_list_sort0(fixture* f) {
+    item_list list;
+    list.sort();
+    require_keys(list, NULL, 0);
+    list.push_back(f->items[0]);
+    list.sort();
+    int keys0[] = {0};
+    require_keys(list, keys0, 1);
+    list.clear();
+
+    // Equivalent items keep their order
+    static const int keys[ITEM_COUNT] = {3, 1, 3, 0, 1, 3, 2, 0};
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        f->items[i].key = keys[i];
+    }
+    link_items(f, list, 0, ITEM_COUNT);
+    list.sort();
+    int keys1[] = {0, 0, 1, 1, 2, 3, 3, 3};
+    require_keys(list, keys1, ITEM_COUNT);
+    int seq = -1, key = -1;
+    for (item_list::iterator it = list.begin(); it != list.end(); ++it) {
+        if (it->key == key) {REQUIRE(it->seq > seq);}
+        key = it->key;
+        seq = it->seq;
+    }
+    list.sort(greater_key());
+    int keys2[] = {3, 3, 3, 2, 1, 1, 0, 0};
+    require_keys(list, keys2, ITEM_COUNT);
+    REQUIRE_EQUAL(list.front().seq, 0);
+    REQUIRE_EQUAL(list.back().seq, 7);
+
+    // STL algorithms
+    key_is three = {3};
+    REQUIRE_EQUAL(std::count_if(list.begin(), list.end(), three), 3);
+    REQUIRE_EQUAL(&(*std::find_if(list.begin(), list.end(), three)),
+                  &(f->items[0]));
+}
+
+void intrusive_list_move0(fixture* f) {
+#if __cplusplus >= 201103L
+    item_list a;
+    link_items(f, a, 0, 3);
+    item_list b(std::move(a));
+    int keys0[] = {0, 1, 2};
+    require_keys(a, NULL, 0);
+    require_keys(b, keys0, 3);
+    item_list c;
+    link_items(f, c, 3, 5);
+    c = std::move(b);
+    require_keys(b, NULL, 0);
+    require_keys(c, keys0, 3);
+    c = std::move(c);
+    require_keys(c, keys0, 3);
+    int sum = 0;
+    for (const item& i : c) {
+        sum += i.key;
+    }
+    REQUIRE_EQUAL(sum, 3);
+#else
+    (void) f;
+#endif
+}
+
+#if __cplusplus >= 201103L
+/** Over-aligned testing data structure */
+struct alignas(64) aligned_item {
+    char pad;
+    struct dlinkedlist_node list;
+};
+#endif
+
+void intrusive_list_aligned0(fixture* f) {
+    (void) f;
+#if __cplusplus >= 201103L
+    typedef datastructure::intrusive_list<aligned_item, &aligned_item::list>
+        aligned_list;
+    aligned_item items[2];
+    aligned_list list;
+    list.push_back(items[0]);
+    list.push_back(items[1]);
+    REQUIRE_EQUAL(&(list.front()), &(items[0]));
+    REQUIRE_EQUAL(&(list.back()), &(items[1]));
+    list.clear();
+#endif
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_intrusive_list() {
+    static fixture f;
+    TEST_CASE(intrusive_list_push_pop0, &f)
+    TEST_CASE(intrusive_list_insert_erase0, &f)
+    TEST_CASE(intrusive_list_splice0, &f)
+    TEST_CASE(intrusive_list_swap_reverse0, &f)
+    TEST_CASE(intrusive_list_sort0, &f)
+    TEST_CASE(intrusive_list_move0, &f)
+    TEST_CASE(intrusive_list_aligned0, &f)
+    return 1;
+}
@@ -0,0 +1,211 @@
+//
+//  ulinkedlistTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/list/ulinkedlistTest.h"
+#include "datastructure/list/ulinkedlist.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define ELEM_COUNT  96
+#define CHUNK_ELEMS 4
+
+struct fixture {
+    struct ulinkedlist l;
+    struct ulinkedlist l2;
+};
+
+static void fixture_setup(struct fixture* f) {
+    size_t chunksize = __ULINKEDLIST_CHUNK_HEADER_SIZE + CHUNK_ELEMS * sizeof(int);
+    ulinkedlist_init(&(f->l), sizeof(int), chunksize);
+    ulinkedlist_init(&(f->l2), sizeof(int), chunksize);
+}
+
+static void fixture_teardown(struct fixture* f) {
+    ulinkedlist_free(&(f->l));
+    ulinkedlist_free(&(f->l2));
+}
+
+// Checks list holds first, first + 1, ..., first + count - 1 both ways
+static void require_sequence(struct ulinkedlist* l, int first, int count) {
+    struct ulinkedlist_cursor c;
+    int* e;
+    int i = first;
+    REQUIRE_EQUAL(ulinkedlist_size(l), (_UINT_LEAST_64_T) count);
+    ulinkedlist_for_each(l, c, e) {
+        REQUIRE_EQUAL(*e, i);
+        i++;
+    }
+    REQUIRE_EQUAL(i, first + count);
+    ulinkedlist_for_each_prev(l, c, e) {
+        i--;
+        REQUIRE_EQUAL(*e, i);
+    }
+    REQUIRE_EQUAL(i, first);
+}
+
+void ulinkedlist_init0(struct fixture* f) {
+    struct ulinkedlist_cursor c;
+    REQUIRE_EQUAL(f->l._capacity, CHUNK_ELEMS);
+    REQUIRE(ulinkedlist_empty(&(f->l)));
+    ulinkedlist_cursor_first(&(f->l), &c);
+    REQUIRE(ulinkedlist_cursor_get(&(f->l), &c) == NULL);
+
+    // Chunks hold at least one element
+    struct ulinkedlist l;
+    ulinkedlist_init(&l, 1024, 1);
+    REQUIRE_EQUAL(l._capacity, 1);
+    ulinkedlist_init(&l, sizeof(int), 0);
+    REQUIRE(l._capacity > CHUNK_ELEMS);
+}
+
+void ulinkedlist_add0(struct fixture* f) {
+    for (int i = ELEM_COUNT / 2; i < ELEM_COUNT; i++) {
+        int* e = (int*) ulinkedlist_add_tail(&(f->l), &i);
+        REQUIRE(e != NULL);
+        REQUIRE_EQUAL(*e, i);
+    }
+    for (int i = ELEM_COUNT / 2 - 1; i >= 0; i--) {
+        REQUIRE(ulinkedlist_add_head(&(f->l), &i) != NULL);
+    }
+    require_sequence(&(f->l), 0, ELEM_COUNT);
+
+    // Chunks are full
+    struct ulinkedlist_chunk* chunk;
+    size_t chunks = 0;
+    ulinkedlist_for_each_chunk(&(f->l), chunk) {
+        REQUIRE_EQUAL(ulinkedlist_chunk_count(chunk), CHUNK_ELEMS);
+        chunks++;
+    }
+    REQUIRE_EQUAL(chunks, ELEM_COUNT / CHUNK_ELEMS);
+}
+
+void ulinkedlist_add_before0(struct fixture* f) {
+    // Insert even elements then odd ones before their successor
+    struct ulinkedlist_cursor c;
+    int* e;
+    for (int i = 0; i < ELEM_COUNT; i += 2) {
+        ulinkedlist_add_tail(&(f->l), &i);
+    }
+    ulinkedlist_cursor_first(&(f->l), &c);
+    for (int i = 1; i < ELEM_COUNT; i += 2) {
+        ulinkedlist_cursor_next(&(f->l), &c);
+        e = (int*) ulinkedlist_add_before(&(f->l), &c, &i);
+        REQUIRE_EQUAL(*e, i);
+        REQUIRE_EQUAL(ulinkedlist_cursor_get(&(f->l), &c), e);
+        ulinkedlist_cursor_next(&(f->l), &c);
+    }
+    require_sequence(&(f->l), 0, ELEM_COUNT);
+
+    // Past the last element appends
+    int last = ELEM_COUNT;
+    ulinkedlist_cursor_first(&(f->l), &c);
+    ulinkedlist_cursor_prev(&(f->l), &c);
+    REQUIRE(ulinkedlist_cursor_get(&(f->l), &c) == NULL);
+    ulinkedlist_add_before(&(f->l), &c, &last);
+    require_sequence(&(f->l), 0, ELEM_COUNT + 1);
+}
+
+void ulinkedlist_remove0(struct fixture* f) {
+    struct ulinkedlist_cursor c;
+    int* e;
+    for (int i = 0; i < ELEM_COUNT; i++) {
+        ulinkedlist_add_tail(&(f->l), &i);
+    }
+
+    // Remove odd elements: cursor moves onto the following element
+    ulinkedlist_cursor_first(&(f->l), &c);
+    while ((e = (int*) ulinkedlist_cursor_get(&(f->l), &c)) != NULL) {
+        if (*e % 2) {
+            ulinkedlist_remove(&(f->l), &c);
+        } else {
+            ulinkedlist_cursor_next(&(f->l), &c);
+        }
+    }
+    REQUIRE_EQUAL(ulinkedlist_size(&(f->l)), ELEM_COUNT / 2);
+    int i = 0;
+    ulinkedlist_for_each(&(f->l), c, e) {
+        REQUIRE_EQUAL(*e, i);
+        i += 2;
+    }
+
+    // Half empty chunks got merged
+    struct ulinkedlist_chunk* chunk;
+    size_t chunks = 0;
+    ulinkedlist_for_each_chunk(&(f->l), chunk) {chunks++;}
+    REQUIRE_EQUAL(chunks, ELEM_COUNT / 2 / CHUNK_ELEMS);
+
+    // Remove everything
+    ulinkedlist_cursor_first(&(f->l), &c);
+    while (!ulinkedlist_empty(&(f->l))) {
+        ulinkedlist_remove(&(f->l), &c);
+    }
+    REQUIRE(ulinkedlist_cursor_get(&(f->l), &c) == NULL);
+    REQUIRE(dlinkedlist_empty(&(f->l._chunks)));
+}
+
+void ulinkedlist_splice0(struct fixture* f) {
+    for (int i = 0; i < ELEM_COUNT; i++) {
+        ulinkedlist_add_tail(i < 10 ? &(f->l) : &(f->l2), &i);
+    }
+    ulinkedlist_splice(&(f->l), &(f->l2));
+    REQUIRE(ulinkedlist_empty(&(f->l)));
+    require_sequence(&(f->l2), 0, ELEM_COUNT);
+    ulinkedlist_splice(&(f->l), &(f->l2));
+    require_sequence(&(f->l2), 0, ELEM_COUNT);
+}
+
+void ulinkedlist_iterator0(struct fixture* f) {
+    struct iterator_ulinkedlist storage;
+    for (int i = 0; i < ELEM_COUNT; i++) {
+        ulinkedlist_add_tail(&(f->l), &i);
+    }
+    struct iterator* it = ulinkedlist_iterator_init(&storage, &(f->l));
+    REQUIRE(iterator_item_current(it) == NULL);
+    REQUIRE_EQUAL(*(int*) iterator_item_begin(it), 0);
+    REQUIRE_EQUAL(*(int*) iterator_item_end(it), ELEM_COUNT - 1);
+    int* e;
+    int i = 0;
+    while ((e = (int*) iterator_item_next(it)) != NULL) {
+        REQUIRE_EQUAL(*e, i);
+        REQUIRE_EQUAL(iterator_item_current(it), e);
+        i++;
+    }
+    REQUIRE_EQUAL(i, ELEM_COUNT);
+    while ((e = (int*) iterator_item_prev(it)) != NULL) {
+        i--;
+        REQUIRE_EQUAL(*e, i);
+    }
+    REQUIRE_EQUAL(i, 0);
+    ulinkedlist_iterator_deinit(it);
+
+    it = ulinkedlist_iterator_get(&(f->l2));
+    REQUIRE(it != NULL);
+    REQUIRE(iterator_item_next(it) == NULL);
+    REQUIRE(iterator_item_begin(it) == NULL);
+    ulinkedlist_iterator_reset(it, &(f->l));
+    REQUIRE_EQUAL(*(int*) iterator_item_next(it), 0);
+    ulinkedlist_iterator_free(it);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_ulinkedlist() {
+    struct fixture f;
+    TEST_CASE(ulinkedlist_init0, &f)
+    TEST_CASE(ulinkedlist_add0, &f)
+    TEST_CASE(ulinkedlist_add_before0, &f)
+    TEST_CASE(ulinkedlist_remove0, &f)
+    TEST_CASE(ulinkedlist_splice0, &f)
+    TEST_CASE(ulinkedlist_iterator0, &f)
+    return 1;
+}
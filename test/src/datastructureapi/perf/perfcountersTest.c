@@ -0,0 +1,136 @@
+//
+//  perfcountersTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+//  Counters may be unavailable (virtual machines, perf_event_paranoid,
+//  non Linux platforms): tests only check values of available counters.
+//
+
+#include "datastructureapi/perf/perfcountersTest.h"
+#include "datastructure/perf/perfcounters.h"
+#include "datastructure/list/dlinkedlist.h"
+#include <stdlib.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define NODE_COUNT 10000
+
+struct foo {
+    uintptr_t bar;
+    struct dlinkedlist_node list;
+};
+
+struct fixture {
+    struct foo foos[NODE_COUNT];
+    struct dlinkedlist_node head;
+    struct perfcounters pc;
+    int available;
+};
+
+static void fixture_setup(struct fixture* f) {
+    dlinkedlist_init_head(&(f->head), NULL);
+    for (int i = 0; i < NODE_COUNT; i++) {
+        f->foos[i].bar = (uintptr_t) i;
+        dlinkedlist_add_tail(&(f->head), &(f->foos[i].list), NULL);
+    }
+    f->available = perfcounters_open(&(f->pc));
+}
+
+static void fixture_teardown(struct fixture* f) {
+    perfcounters_close(&(f->pc));
+}
+
+static uintptr_t traverse(struct fixture* f) {
+    struct dlinkedlist_node* n;
+    uintptr_t sum = 0;
+    dlinkedlist_for_each(&(f->head), n) {
+        sum += dlinkedlist_entry(n, struct foo, list)->bar;
+    }
+    return sum;
+}
+
+void perfcounters_open0(struct fixture* f) {
+    int available = 0;
+    REQUIRE(f->available >= 0 && f->available <= PERFCOUNTERS_COUNT);
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        REQUIRE(perfcounters_name(i) != NULL);
+        if (perfcounters_available(&(f->pc), i)) {
+            available++;
+            REQUIRE_EQUAL(perfcounters_value(&(f->pc), i), 0);
+        } else {
+            REQUIRE_EQUAL(perfcounters_value(&(f->pc), i),
+                          PERFCOUNTERS_UNAVAILABLE);
+        }
+    }
+    REQUIRE_EQUAL(available, f->available);
+
+    // Closed counters are unavailable
+    perfcounters_close(&(f->pc));
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        REQUIRE(!perfcounters_available(&(f->pc), i));
+        REQUIRE_EQUAL(perfcounters_value(&(f->pc), i),
+                      PERFCOUNTERS_UNAVAILABLE);
+    }
+    // Stopped/started while closed: no-op
+    perfcounters_start(&(f->pc));
+    perfcounters_stop(&(f->pc));
+}
+
+void perfcounters_accumulate0(struct fixture* f) {
+    uint64_t first[PERFCOUNTERS_COUNT];
+    uintptr_t sum;
+
+    perfcounters_start(&(f->pc));
+    sum = traverse(f);
+    perfcounters_stop(&(f->pc));
+    REQUIRE_EQUAL(sum, (uintptr_t) NODE_COUNT * (NODE_COUNT - 1) / 2);
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        first[i] = perfcounters_value(&(f->pc), i);
+    }
+    if (perfcounters_available(&(f->pc), PERFCOUNTERS_INSTRUCTIONS)) {
+        // At least one load per node visited
+        REQUIRE(first[PERFCOUNTERS_INSTRUCTIONS] >= NODE_COUNT);
+    }
+
+    // Events counted while stopped are not accounted for
+    sum = traverse(f);
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        REQUIRE_EQUAL(perfcounters_value(&(f->pc), i), first[i]);
+    }
+
+    // Start/stop pairs accumulate
+    perfcounters_start(&(f->pc));
+    sum += traverse(f);
+    perfcounters_stop(&(f->pc));
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        if (perfcounters_available(&(f->pc), i)) {
+            REQUIRE(perfcounters_value(&(f->pc), i) >= first[i]);
+        } else {
+            REQUIRE_EQUAL(perfcounters_value(&(f->pc), i),
+                          PERFCOUNTERS_UNAVAILABLE);
+        }
+    }
+
+    perfcounters_reset(&(f->pc));
+    for (int i = 0; i < PERFCOUNTERS_COUNT; i++) {
+        if (perfcounters_available(&(f->pc), i)) {
+            REQUIRE_EQUAL(perfcounters_value(&(f->pc), i), 0);
+        }
+    }
+    REQUIRE_EQUAL(sum, (uintptr_t) NODE_COUNT * (NODE_COUNT - 1));
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_perfcounters() {
+    static struct fixture f;
+    TEST_CASE(perfcounters_open0, &f)
+    TEST_CASE(perfcounters_accumulate0, &f)
+    return 1;
+}
@@ -0,0 +1,150 @@
+//
+//  mpscqueueTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/queue/mpscqueueTest.h"
+#include "datastructure/queue/mpscqueue.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define PRODUCER_COUNT  4
+#define ITEM_COUNT      20000
+
+/** Testing data structure */
+struct item {
+    int producer;
+    int seq;
+    struct dlinkedlist_node list;
+};
+
+struct fixture {
+    struct mpscqueue q;
+    struct dlinkedlist_node h;
+    int_least32_t size;
+    struct item items[PRODUCER_COUNT * ITEM_COUNT];
+};
+
+static void fixture_setup(struct fixture* f) {
+    mpscqueue_init(&(f->q));
+    dlinkedlist_init_head(&(f->h), &(f->size));
+    for (int i = 0; i < PRODUCER_COUNT * ITEM_COUNT; i++) {
+        f->items[i].producer = i / ITEM_COUNT;
+        f->items[i].seq = i % ITEM_COUNT;
+    }
+}
+
+static void fixture_teardown(struct fixture* f) {
+    mpscqueue_init(&(f->q));
+    dlinkedlist_init_head(&(f->h), &(f->size));
+}
+
+void mpscqueue_push_pop0(struct fixture* f) {
+    REQUIRE(mpscqueue_empty(&(f->q)));
+    REQUIRE(mpscqueue_pop(&(f->q)) == NULL);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 10; i++) {
+            mpscqueue_push(&(f->q), &(f->items[i].list));
+        }
+        REQUIRE(!mpscqueue_empty(&(f->q)));
+        for (int i = 0; i < 10; i++) {
+            REQUIRE_EQUAL(mpscqueue_pop(&(f->q)), &(f->items[i].list));
+        }
+        REQUIRE(mpscqueue_pop(&(f->q)) == NULL);
+        REQUIRE(mpscqueue_empty(&(f->q)));
+    }
+
+    // Interleaved pushes and pops
+    mpscqueue_push(&(f->q), &(f->items[0].list));
+    mpscqueue_push(&(f->q), &(f->items[1].list));
+    REQUIRE_EQUAL(mpscqueue_pop(&(f->q)), &(f->items[0].list));
+    mpscqueue_push(&(f->q), &(f->items[2].list));
+    REQUIRE_EQUAL(mpscqueue_pop(&(f->q)), &(f->items[1].list));
+    REQUIRE_EQUAL(mpscqueue_pop(&(f->q)), &(f->items[2].list));
+    REQUIRE(mpscqueue_pop(&(f->q)) == NULL);
+}
+
+void mpscqueue_take_all0(struct fixture* f) {
+    REQUIRE_EQUAL(mpscqueue_take_all(&(f->q), &(f->h), &(f->size)), 0);
+    for (int i = 0; i < 10; i++) {
+        mpscqueue_push(&(f->q), &(f->items[i].list));
+    }
+    REQUIRE_EQUAL(mpscqueue_take_all(&(f->q), &(f->h), &(f->size)), 10);
+    REQUIRE_EQUAL(f->size, 10);
+    REQUIRE_EQUAL(dlinkedlist_size(&(f->h)), 10);
+    REQUIRE(mpscqueue_empty(&(f->q)));
+    struct dlinkedlist_node* n;
+    int i = 0;
+    dlinkedlist_for_each(&(f->h), n) {
+        REQUIRE_EQUAL(n, &(f->items[i].list));
+        i++;
+    }
+    i = 10;
+    dlinkedlist_for_each_prev(&(f->h), n) {
+        i--;
+        REQUIRE_EQUAL(n, &(f->items[i].list));
+    }
+}
+
+struct producer {
+    struct mpscqueue* q;
+    struct item* items;
+};
+
+static void* mpscqueue_produce(void* arg) {
+    struct producer* p = (struct producer*) arg;
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        mpscqueue_push(p->q, &(p->items[i].list));
+    }
+    return NULL;
+}
+
+void mpscqueue_concurrent0(struct fixture* f) {
+    pthread_t threads[PRODUCER_COUNT];
+    struct producer producers[PRODUCER_COUNT];
+    int next[PRODUCER_COUNT] = {0};
+    int received = 0;
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        producers[p].q = &(f->q);
+        producers[p].items = &(f->items[p * ITEM_COUNT]);
+        REQUIRE_EQUAL(pthread_create(&(threads[p]), NULL, mpscqueue_produce,
+                                     &(producers[p])), 0);
+    }
+
+    // Every item is received once, in push order for a given producer
+    while (received < PRODUCER_COUNT * ITEM_COUNT) {
+        struct dlinkedlist_node* n;
+        mpscqueue_take_all(&(f->q), &(f->h), &(f->size));
+        dlinkedlist_for_each(&(f->h), n) {
+            struct item* item = dlinkedlist_entry(n, struct item, list);
+            REQUIRE_EQUAL(item->seq, next[item->producer]);
+            next[item->producer]++;
+            received++;
+        }
+        dlinkedlist_init_head(&(f->h), &(f->size));
+    }
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        pthread_join(threads[p], NULL);
+        REQUIRE_EQUAL(next[p], ITEM_COUNT);
+    }
+    REQUIRE(mpscqueue_pop(&(f->q)) == NULL);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_mpscqueue() {
+    static struct fixture f;
+    TEST_CASE(mpscqueue_push_pop0, &f)
+    TEST_CASE(mpscqueue_take_all0, &f)
+    TEST_CASE(mpscqueue_concurrent0, &f)
+    return 1;
+}
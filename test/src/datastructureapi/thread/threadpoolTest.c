@@ -0,0 +1,168 @@
+//
+//  threadpoolTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/thread/threadpoolTest.h"
+#include "datastructure/thread/threadpool.h"
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define THREAD_COUNT    3
+#define JOB_COUNT       2000
+#define CHILD_COUNT     4
+
+/** Testing data structure */
+struct job {
+    int runs;
+    struct threadpool* pool;
+    struct threadpool_group* group;
+    struct job* children;
+    struct threadpool_task task;
+};
+
+struct fixture {
+    struct threadpool pool;
+    struct threadpool_group group;
+    struct job jobs[JOB_COUNT];
+    struct job children[JOB_COUNT * CHILD_COUNT];
+};
+
+static void fixture_setup(struct fixture* f) {
+    REQUIRE(threadpool_init(&(f->pool), THREAD_COUNT));
+    threadpool_group_init(&(f->group));
+    for (int i = 0; i < JOB_COUNT; i++) {
+        f->jobs[i].runs = 0;
+        f->jobs[i].pool = &(f->pool);
+        f->jobs[i].group = &(f->group);
+        f->jobs[i].children = NULL;
+    }
+    for (int i = 0; i < JOB_COUNT * CHILD_COUNT; i++) {
+        f->children[i].runs = 0;
+        f->children[i].children = NULL;
+    }
+}
+
+static void fixture_teardown(struct fixture* f) {
+    threadpool_free(&(f->pool));
+}
+
+static void job_run(struct threadpool_task* task) {
+    struct job* job = threadpool_task_entry(task, struct job, task);
+    job->runs++;
+    if (job->children != NULL) {
+        for (int i = 0; i < CHILD_COUNT; i++) {
+            threadpool_submit(job->pool, job->group,
+                              &(job->children[i].task), job_run);
+        }
+    }
+}
+
+void threadpool_init0(struct fixture* f) {
+    REQUIRE_EQUAL(threadpool_thread_count(&(f->pool)), THREAD_COUNT);
+
+    // Workers' deques do not share cache lines
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        REQUIRE_EQUAL((uintptr_t) &(f->pool._workers[i]) % CACHE_LINE_SIZE, 0);
+    }
+    REQUIRE_EQUAL(sizeof(union __threadpool_slot) % CACHE_LINE_SIZE, 0);
+
+    // Waiting for an empty group returns at once
+    threadpool_wait(&(f->pool), &(f->group));
+}
+
+void threadpool_submit_wait0(struct fixture* f) {
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < JOB_COUNT; i++) {
+            threadpool_submit(&(f->pool), &(f->group), &(f->jobs[i].task),
+                              job_run);
+        }
+        threadpool_wait(&(f->pool), &(f->group));
+        for (int i = 0; i < JOB_COUNT; i++) {
+            REQUIRE_EQUAL(f->jobs[i].runs, round + 1);
+        }
+    }
+}
+
+void threadpool_submit_nested0(struct fixture* f) {
+    // Tasks submit tasks to the group being waited for
+    for (int i = 0; i < JOB_COUNT; i++) {
+        f->jobs[i].children = &(f->children[i * CHILD_COUNT]);
+        threadpool_submit(&(f->pool), &(f->group), &(f->jobs[i].task),
+                          job_run);
+    }
+    threadpool_wait(&(f->pool), &(f->group));
+    for (int i = 0; i < JOB_COUNT; i++) {
+        REQUIRE_EQUAL(f->jobs[i].runs, 1);
+    }
+    for (int i = 0; i < JOB_COUNT * CHILD_COUNT; i++) {
+        REQUIRE_EQUAL(f->children[i].runs, 1);
+    }
+}
+
+/** Runs until a thread blocks waiting for the pool */
+static int blocked_started;
+static int blocked_saw_waiter;
+
+static void blocked_run(struct threadpool_task* task) {
+    struct job* job = threadpool_task_entry(task, struct job, task);
+    ATOMIC_STORE_RELEASE(&blocked_started, 1);
+    while (!blocked_saw_waiter) {
+        pthread_mutex_lock(&(job->pool->_lock));
+        blocked_saw_waiter = job->pool->_waiting == 1;
+        pthread_mutex_unlock(&(job->pool->_lock));
+        sched_yield();
+    }
+    job->runs++;
+}
+
+void threadpool_wait_blocks0(struct fixture* f) {
+    // Nothing to steal: the waiting thread sleeps until the group completes
+    blocked_started = 0;
+    blocked_saw_waiter = 0;
+    threadpool_submit(&(f->pool), &(f->group), &(f->jobs[0].task),
+                      blocked_run);
+    while (!ATOMIC_LOAD_ACQUIRE(&blocked_started)) {}
+    threadpool_wait(&(f->pool), &(f->group));
+    REQUIRE_EQUAL(f->jobs[0].runs, 1);
+    REQUIRE(blocked_saw_waiter);
+    REQUIRE_EQUAL(f->pool._waiting, 0);
+}
+
+void threadpool_auto_size0(struct fixture* f) {
+    // One worker per online processor but one
+    struct threadpool pool;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    REQUIRE(threadpool_init(&pool, 0));
+    REQUIRE_EQUAL((long) threadpool_thread_count(&pool),
+                  (online > 1 ? online - 1 : 0));
+    for (int i = 0; i < JOB_COUNT; i++) {
+        threadpool_submit(&pool, &(f->group), &(f->jobs[i].task), job_run);
+    }
+    threadpool_wait(&pool, &(f->group));
+    for (int i = 0; i < JOB_COUNT; i++) {
+        REQUIRE_EQUAL(f->jobs[i].runs, 1);
+    }
+    threadpool_free(&pool);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_threadpool() {
+    static struct fixture f;
+    TEST_CASE(threadpool_init0, &f)
+    TEST_CASE(threadpool_submit_wait0, &f)
+    TEST_CASE(threadpool_submit_nested0, &f)
+    TEST_CASE(threadpool_wait_blocks0, &f)
+    TEST_CASE(threadpool_auto_size0, &f)
+    return 1;
+}
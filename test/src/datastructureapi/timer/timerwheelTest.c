@@ -0,0 +1,152 @@
+//
+//  timerwheelTest.c
+//
+//  Created by Andreoletti David.
+//  Copyright 2012 IO Stark. All rights reserved.
+//
+
+#include "datastructureapi/timer/timerwheelTest.h"
+#include "datastructure/timer/timerwheel.h"
+#include <stdlib.h>
+
+#define REQUIRE_EQUAL(value0, value1) assert(value0 == value1)
+#define REQUIRE(condition) assert(condition)
+
+#define TIMER_COUNT 5000
+#define START       1000
+
+struct item {
+    int id;
+    uint64_t fired;             /** Tick passed to the advance expiring it */
+    struct timerwheel_timer timer;
+};
+
+struct fixture {
+    struct item items[TIMER_COUNT];
+    struct timerwheel w;
+    struct dlinkedlist_node expired;
+};
+
+static void fixture_setup(struct fixture* f) {
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        f->items[i].id = i;
+        f->items[i].fired = 0;
+        timerwheel_timer_init(&(f->items[i].timer));
+    }
+    timerwheel_init(&(f->w), START);
+    dlinkedlist_init_head(&(f->expired), NULL);
+}
+
+static void fixture_teardown(struct fixture* f) {
+    (void) f;
+}
+
+// Advances to now and records the expired timers' firing tick
+static size_t advance(struct fixture* f, uint64_t now) {
+    size_t count = timerwheel_advance(&(f->w), now, &(f->expired));
+    size_t taken = 0;
+    struct timerwheel_timer* timer;
+    while ((timer = timerwheel_take(&(f->expired))) != NULL) {
+        struct item* item = timerwheel_entry(timer, struct item, timer);
+        REQUIRE_EQUAL(item->fired, 0);
+        REQUIRE(!timerwheel_timer_pending(timer));
+        item->fired = now;
+        taken++;
+    }
+    REQUIRE_EQUAL(taken, count);
+    return count;
+}
+
+void timerwheel_arm_cancel0(struct fixture* f) {
+    struct item* it = f->items;
+    REQUIRE(!timerwheel_timer_pending(&(it[0].timer)));
+    timerwheel_arm(&(f->w), &(it[0].timer), START + 10);
+    timerwheel_arm(&(f->w), &(it[1].timer), START + 10);
+    timerwheel_arm(&(f->w), &(it[2].timer), START + 5000);
+    timerwheel_arm(&(f->w), &(it[3].timer), START - 1);
+    REQUIRE_EQUAL(timerwheel_size(&(f->w)), 4);
+    REQUIRE(timerwheel_timer_pending(&(it[0].timer)));
+    REQUIRE_EQUAL(timerwheel_timer_expires(&(it[2].timer)), START + 5000);
+
+    REQUIRE(timerwheel_cancel(&(f->w), &(it[1].timer)));
+    REQUIRE(!timerwheel_cancel(&(f->w), &(it[1].timer)));
+    REQUIRE(!timerwheel_timer_pending(&(it[1].timer)));
+    // Re-arming moves the timer
+    timerwheel_arm(&(f->w), &(it[2].timer), START + 20);
+    REQUIRE_EQUAL(timerwheel_size(&(f->w)), 3);
+
+    // Overdue timers expire on the first advance
+    REQUIRE_EQUAL(advance(f, START), 1);
+    REQUIRE_EQUAL(it[3].fired, START);
+    REQUIRE_EQUAL(advance(f, START + 9), 0);
+    REQUIRE_EQUAL(advance(f, START + 10), 1);
+    REQUIRE_EQUAL(it[0].fired, START + 10);
+    REQUIRE_EQUAL(advance(f, START + 100), 1);
+    REQUIRE_EQUAL(it[2].fired, START + 100);
+    REQUIRE_EQUAL(it[1].fired, 0);
+    REQUIRE_EQUAL(timerwheel_size(&(f->w)), 0);
+
+    // Expired timers may be armed again
+    timerwheel_arm(&(f->w), &(it[0].timer), START + 101);
+    it[0].fired = 0;
+    REQUIRE_EQUAL(advance(f, START + 101), 1);
+    REQUIRE_EQUAL(it[0].fired, START + 101);
+}
+
+void timerwheel_cascade0(struct fixture* f) {
+    // Delays spanning every level, some beyond the wheel's range
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    uint64_t expires[TIMER_COUNT];
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        int bits = (int) ((seed >> 33) % 22);
+        uint64_t delay = (seed >> 11) & (((uint64_t) 1 << bits) - 1);
+        if (i % 1000 == 0) {delay = __TIMERWHEEL_RANGE + (uint64_t) i;}
+        expires[i] = START + delay;
+        timerwheel_arm(&(f->w), &(f->items[i].timer), expires[i]);
+        // Cancel one in ten
+        if (i % 10 == 9) {timerwheel_cancel(&(f->w), &(f->items[i].timer));}
+    }
+    REQUIRE_EQUAL(timerwheel_size(&(f->w)), TIMER_COUNT - TIMER_COUNT / 10);
+
+    // Advance by uneven steps: each timer expires in the step covering it
+    uint64_t now = START - 1;
+    uint64_t step = 1;
+    while (timerwheel_size(&(f->w)) > 0 && now < START + (1 << 22)) {
+        uint64_t previous = now;
+        now += step;
+        step = step * 3 % 1777 + 1;
+        advance(f, now);
+        for (int i = 0; i < TIMER_COUNT; i++) {
+            if (f->items[i].fired == now) {
+                REQUIRE(expires[i] > previous && expires[i] <= now);
+            }
+        }
+    }
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        int cancelled = i % 10 == 9;
+        int far = i % 1000 == 0;
+        REQUIRE_EQUAL((f->items[i].fired == 0), (cancelled || far));
+        REQUIRE_EQUAL(timerwheel_timer_pending(&(f->items[i].timer)),
+                      (far && !cancelled));
+    }
+    REQUIRE_EQUAL(timerwheel_size(&(f->w)), TIMER_COUNT / 1000);
+
+    // Far timers stay pending until their tick, beyond the wheel's range
+    now = START + __TIMERWHEEL_RANGE - 1;
+    REQUIRE_EQUAL(advance(f, now), 0);
+    REQUIRE_EQUAL(advance(f, now + 1), 1);
+    REQUIRE_EQUAL(f->items[0].fired, now + 1);
+}
+
+#define TEST_CASE(nameTest, fixture) \
+    fixture_setup(fixture); \
+    nameTest(fixture); \
+    fixture_teardown(fixture); \
+
+int run_unit_tests_timerwheel() {
+    static struct fixture f;
+    TEST_CASE(timerwheel_arm_cancel0, &f)
+    TEST_CASE(timerwheel_cascade0, &f)
+    return 1;
+}